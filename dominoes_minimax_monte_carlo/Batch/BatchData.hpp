@@ -0,0 +1,43 @@
+//
+//  BatchData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef BatchData_hpp
+#define BatchData_hpp
+
+#include <string>
+
+#include "BatchStatistics.hpp"
+
+struct BatchData {
+    BatchData() : gamesCompleted(0), elapsed(0.0), dealBusy(0.0), perfectInformationBusy(0.0), monteCarloBusy(0.0), serializationBusy(0.0) {}
+
+    int gamesCompleted;
+    double elapsed; // wall clock seconds for the whole batch
+    double dealBusy; // summed seconds each stage's workers spent working
+    double perfectInformationBusy;
+    double monteCarloBusy;
+    double serializationBusy;
+    BatchStatistics statistics; // merged from every Monte Carlo worker
+
+    inline double getGamesPerHour() const {
+        return elapsed > 0.0 ? (3600.0 * (double)gamesCompleted) / elapsed : 0.0;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Games Completed: " + std::to_string(gamesCompleted) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        result += "Games Per Hour: " + std::to_string(getGamesPerHour()) + "\n";
+        result += "Deal Stage Busy: " + std::to_string(dealBusy) + " s\n";
+        result += "Perfect Information Stage Busy: " + std::to_string(perfectInformationBusy) + " s\n";
+        result += "Monte Carlo Stage Busy: " + std::to_string(monteCarloBusy) + " s\n";
+        result += "Serialization Stage Busy: " + std::to_string(serializationBusy) + " s\n";
+        result += "*Batch Statistics*\n" + statistics.prettyString();
+        return result;
+    }
+};
+
+#endif /* BatchData_hpp */
@@ -0,0 +1,201 @@
+//
+//  BatchPipeline.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <chrono>
+#include <thread>
+
+#include "BatchPipeline.hpp"
+
+#include "GameTreeDataGenerator.hpp"
+#include "MemoryTracker.hpp"
+#include "MinimaxSearch.hpp"
+#include "MonteCarloDataGenerator.hpp"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double secondsSince(const Clock::time_point start) {
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// the other stages run at the same time, so a phase's allocation counters take in their work too
+static MemoryPhaseData overlappingPhase(MemoryPhaseData phase) {
+    phase.overlapping = true;
+    return phase;
+}
+
+void BatchPipeline::_dealStage(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, GameAnalysisQueue& output, double& busy) {
+    for (int gameNumber = 0; gameNumber < maxPlayerHandNumbers.size(); gameNumber++) {
+        const auto start = Clock::now();
+        const int handNumber = maxPlayerHandNumbers[gameNumber];
+        GameAnalysisPointer analysis(new GameAnalysis(gameNumber, handNumber, Game::gameWithStartingMaxPayerHandNumber(gameFoundation, handNumber)));
+        busy += secondsSince(start);
+        if (!output.push(std::move(analysis))) {
+            break;
+        }
+    }
+}
+
+void BatchPipeline::_perfectInformationStage(const BatchSettings& settings, GameAnalysisQueue& input, GameAnalysisQueue& output, double& busy) {
+    GameAnalysisPointer analysis;
+    while (input.pop(analysis)) {
+        const auto start = Clock::now();
+        const GameState initialState(analysis->game);
+
+        const MemoryPhase gameTreeMemoryPhase(kMemoryPhaseGameTree);
+        analysis->gameTreeData = GameTreeDataGenerator::generateDataFromState(initialState);
+        if (settings.measureMemory) {
+            analysis->memoryData.phases.push_back(overlappingPhase(gameTreeMemoryPhase.finish(analysis->gameTreeData.getTotalNodes())));
+        }
+
+        if (settings.runFullMinimax) {
+            const MemoryPhase fullMinimaxMemoryPhase(kMemoryPhaseFullMinimax);
+            GameState minimaxGameState(initialState);
+            analysis->fullMinimaxData = MinimaxSearch::runOnState(minimaxGameState);
+            analysis->ranFullMinimax = true;
+            assert(analysis->gameTreeData.getTotalNodes() == analysis->fullMinimaxData.nodesVisited);
+            if (settings.measureMemory) {
+                analysis->memoryData.phases.push_back(overlappingPhase(fullMinimaxMemoryPhase.finish(analysis->fullMinimaxData.nodesVisited)));
+            }
+        }
+
+        // searched without a store, like main's single-game path, so its nodes and path are the uncached reference
+        const MemoryPhase alphaBetaMemoryPhase(kMemoryPhaseAlphaBetaMinimax);
+        GameState alphaBetaGameState(initialState);
+        analysis->alphaBetaMinimaxData = AlphaBetaMinimaxSearch::runOnState(alphaBetaGameState, settings.recordMinimaxPath);
+        assert(!settings.runFullMinimax || analysis->fullMinimaxData.minimaxValue == analysis->alphaBetaMinimaxData.minimaxValue);
+        if (settings.measureMemory) {
+            analysis->memoryData.phases.push_back(overlappingPhase(alphaBetaMemoryPhase.finish(analysis->alphaBetaMinimaxData.nodesVisited)));
+        }
+        analysis->ranPerfectInformation = true;
+
+        const double elapsed = secondsSince(start);
+        analysis->analysisDuration += elapsed;
+        busy += elapsed;
+        if (!output.push(std::move(analysis))) {
+            break;
+        }
+    }
+}
+
+void BatchPipeline::_monteCarloStage(const BatchSettings& settings, GameAnalysisQueue& input, GameAnalysisQueue& output, BatchStatistics& statistics, double& busy) {
+    // parallelism comes from games in flight, so each game samples on one thread
+    MonteCarloSettings monteCarloSettings = settings.monteCarloSettings;
+    monteCarloSettings.numberOfThreads = 1;
+
+    GameAnalysisPointer analysis;
+    while (input.pop(analysis)) {
+        const auto start = Clock::now();
+        const GameState initialState(analysis->game);
+        const MemoryPhase monteCarloMemoryPhase(kMemoryPhaseMonteCarlo);
+        analysis->monteCarloData = MonteCarloDataGenerator::generateData(analysis->game, initialState, monteCarloSettings);
+        if (settings.measureMemory) {
+            analysis->memoryData.phases.push_back(overlappingPhase(monteCarloMemoryPhase.finish(analysis->monteCarloData.getTotalNodesVisited())));
+        }
+        // every stage has run by now, and the statistics are this worker's own
+        statistics.addGame(*analysis);
+
+        const double elapsed = secondsSince(start);
+        analysis->analysisDuration += elapsed;
+        busy += elapsed;
+        if (!output.push(std::move(analysis))) {
+            break;
+        }
+    }
+}
+
+void BatchPipeline::_serializationStage(const BatchSettings& settings, GameAnalysisQueue& input, std::ostream* output, ResultsFile* resultsFile, const ResultsSink* resultsSink, GameRecordWriter* gameRecordWriter, int& gamesCompleted, double& busy) {
+    std::unique_ptr<ResultsBuffer> resultsBuffer;
+    if (resultsSink != NULL) {
+        resultsBuffer.reset(new ResultsBuffer(*resultsFile));
+        resultsSink->writeHeader(*resultsBuffer);
+    }
+
+    GameAnalysisPointer analysis;
+    while (input.pop(analysis)) {
+        const auto start = Clock::now();
+        if (resultsSink != NULL) {
+            resultsSink->writeGame(*resultsBuffer, *analysis);
+        } else {
+            *output << analysis->prettyString(settings.recordMinimaxPath) << "\n";
+        }
+        if (gameRecordWriter != NULL) {
+            gameRecordWriter->write(GameRecord::recordForPath(analysis->monteCarloData.path, settings.monteCarloSettings.seed));
+        }
+        gamesCompleted++;
+        // release the game's trees here rather than on the next pop
+        analysis.reset();
+        busy += secondsSince(start);
+    }
+    if (resultsBuffer) {
+        resultsBuffer->flush();
+    } else {
+        output->flush();
+    }
+}
+
+BatchData BatchPipeline::runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, std::ostream& output) {
+    return _runOnHands(gameFoundation, maxPlayerHandNumbers, settings, &output, NULL, NULL);
+}
+
+BatchData BatchPipeline::runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, ResultsFile& resultsFile, const ResultsSink& resultsSink) {
+    return _runOnHands(gameFoundation, maxPlayerHandNumbers, settings, NULL, &resultsFile, &resultsSink);
+}
+
+BatchData BatchPipeline::_runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, std::ostream* output, ResultsFile* resultsFile, const ResultsSink* resultsSink) {
+    const int hardwareCores = std::max(1, (int)std::thread::hardware_concurrency());
+    // Monte Carlo dominates per-game cost, so it gets most of the cores
+    const int perfectInformationThreads = settings.perfectInformationThreads > 0 ? settings.perfectInformationThreads : std::max(1, hardwareCores / 3);
+    const int monteCarloThreads = settings.monteCarloThreads > 0 ? settings.monteCarloThreads : std::max(1, hardwareCores - perfectInformationThreads);
+
+    GameAnalysisQueue dealtGames(settings.queueCapacity);
+    GameAnalysisQueue perfectInformationGames(settings.queueCapacity);
+    GameAnalysisQueue finishedGames(settings.queueCapacity);
+
+    GameRecordWriter gameRecordWriter;
+    if (!settings.gameRecordPath.empty()) {
+        gameRecordWriter.open(settings.gameRecordPath, gameFoundation);
+    }
+
+    BatchData result;
+    std::vector<double> perfectInformationBusy(perfectInformationThreads, 0.0);
+    std::vector<double> monteCarloBusy(monteCarloThreads, 0.0);
+    std::vector<BatchStatistics> monteCarloStatistics(monteCarloThreads);
+
+    const auto batchStart = Clock::now();
+
+    std::thread dealThread(_dealStage, std::ref(gameFoundation), std::ref(maxPlayerHandNumbers), std::ref(dealtGames), std::ref(result.dealBusy));
+    std::vector<std::thread> perfectInformationWorkers;
+    for (int i = 0; i < perfectInformationThreads; i++) {
+        perfectInformationWorkers.push_back(std::thread(_perfectInformationStage, std::ref(settings), std::ref(dealtGames), std::ref(perfectInformationGames), std::ref(perfectInformationBusy[i])));
+    }
+    std::vector<std::thread> monteCarloWorkers;
+    for (int i = 0; i < monteCarloThreads; i++) {
+        monteCarloWorkers.push_back(std::thread(_monteCarloStage, std::ref(settings), std::ref(perfectInformationGames), std::ref(finishedGames), std::ref(monteCarloStatistics[i]), std::ref(monteCarloBusy[i])));
+    }
+    std::thread serializationThread(_serializationStage, std::ref(settings), std::ref(finishedGames), output, resultsFile, resultsSink, gameRecordWriter.isOpen() ? &gameRecordWriter : NULL, std::ref(result.gamesCompleted), std::ref(result.serializationBusy));
+
+    // each stage drains before the next, so closing in pipeline order lets every queue empty out
+    dealThread.join();
+    dealtGames.close();
+    for (int i = 0; i < perfectInformationWorkers.size(); i++) {
+        perfectInformationWorkers[i].join();
+        result.perfectInformationBusy += perfectInformationBusy[i];
+    }
+    perfectInformationGames.close();
+    for (int i = 0; i < monteCarloWorkers.size(); i++) {
+        monteCarloWorkers[i].join();
+        result.monteCarloBusy += monteCarloBusy[i];
+        result.statistics.merge(monteCarloStatistics[i]);
+    }
+    finishedGames.close();
+    serializationThread.join();
+    gameRecordWriter.close();
+
+    result.elapsed = secondsSince(batchStart);
+
+    return result;
+}
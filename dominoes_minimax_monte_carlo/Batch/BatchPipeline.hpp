@@ -0,0 +1,41 @@
+//
+//  BatchPipeline.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef BatchPipeline_hpp
+#define BatchPipeline_hpp
+
+#include <memory>
+#include <ostream>
+
+#include "BatchData.hpp"
+#include "BatchSettings.hpp"
+#include "BoundedQueue.hpp"
+#include "GameAnalysis.hpp"
+#include "GameFoundation.hpp"
+#include "GameRecordWriter.hpp"
+#include "ResultsSink.hpp"
+
+typedef std::unique_ptr<GameAnalysis> GameAnalysisPointer;
+typedef BoundedQueue<GameAnalysisPointer> GameAnalysisQueue;
+
+// runs a batch of games as four concurrent stages joined by bounded queues:
+// deal -> perfect information (tree data, minimax, alpha-beta) -> Monte Carlo -> serialization.
+// several games are in flight at once, so every core stays busy even though each
+// Monte Carlo game runs single threaded.
+class BatchPipeline {
+private:
+    static void _dealStage(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, GameAnalysisQueue& output, double& busy);
+    static void _perfectInformationStage(const BatchSettings& settings, GameAnalysisQueue& input, GameAnalysisQueue& output, double& busy);
+    static void _monteCarloStage(const BatchSettings& settings, GameAnalysisQueue& input, GameAnalysisQueue& output, BatchStatistics& statistics, double& busy);
+    static void _serializationStage(const BatchSettings& settings, GameAnalysisQueue& input, std::ostream* output, ResultsFile* resultsFile, const ResultsSink* resultsSink, GameRecordWriter* gameRecordWriter, int& gamesCompleted, double& busy);
+    static BatchData _runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, std::ostream* output, ResultsFile* resultsFile, const ResultsSink* resultsSink);
+public:
+    static BatchData runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, std::ostream& output);
+    // writes each game through resultsSink instead of prettyString
+    static BatchData runOnHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerHandNumbers, const BatchSettings& settings, ResultsFile& resultsFile, const ResultsSink& resultsSink);
+};
+
+#endif /* BatchPipeline_hpp */
@@ -0,0 +1,34 @@
+//
+//  BatchSettings.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef BatchSettings_hpp
+#define BatchSettings_hpp
+
+#include <string>
+
+#include "MonteCarloSettings.hpp"
+
+static const int kDefaultBatchQueueCapacity = 4;
+
+struct BatchSettings {
+    BatchSettings(MonteCarloSettings monteCarloSettings = MonteCarloSettings(), bool runFullMinimax = true, bool recordMinimaxPath = true) : monteCarloSettings(monteCarloSettings), runFullMinimax(runFullMinimax), recordMinimaxPath(recordMinimaxPath) {
+        perfectInformationThreads = 0;
+        monteCarloThreads = 0;
+        queueCapacity = kDefaultBatchQueueCapacity;
+        measureMemory = false;
+    }
+
+    MonteCarloSettings monteCarloSettings;
+    bool runFullMinimax;
+    bool recordMinimaxPath;
+    int perfectInformationThreads; // workers for tree data, full minimax and alpha-beta. 0 picks from hardware
+    int monteCarloThreads; // workers for Monte Carlo games, each single threaded. 0 picks from hardware
+    int queueCapacity; // games waiting between two stages
+    bool measureMemory; // fills each GameAnalysis's memoryData. stages overlap across games, so phases are marked overlapping and report only resident sizes
+    std::string gameRecordPath; // binary record of every Monte Carlo game, written by the serialization stage. empty disables
+};
+
+#endif /* BatchSettings_hpp */
@@ -0,0 +1,59 @@
+//
+//  BoundedQueue.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef BoundedQueue_hpp
+#define BoundedQueue_hpp
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// blocking multi-producer multi-consumer queue. push waits while the queue is full and pop waits
+// while it is empty. once closed, push fails and pop drains what is left before failing.
+template <typename T>
+class BoundedQueue {
+private:
+    std::deque<T> _items;
+    const size_t _capacity;
+    bool _closed;
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+public:
+    BoundedQueue(const size_t capacity) : _capacity(capacity), _closed(false) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock, [this] { return _closed || _items.size() < _capacity; });
+        if (_closed) {
+            return false;
+        }
+        _items.push_back(std::move(item));
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [this] { return _closed || !_items.empty(); });
+        if (_items.empty()) {
+            return false;
+        }
+        item = std::move(_items.front());
+        _items.pop_front();
+        _notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+    }
+};
+
+#endif /* BoundedQueue_hpp */
@@ -0,0 +1,56 @@
+//
+//  GameAnalysis.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameAnalysis_hpp
+#define GameAnalysis_hpp
+
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "GameTreeData.hpp"
+#include "MemoryData.hpp"
+#include "MinimaxData.hpp"
+#include "MonteCarloData.hpp"
+
+// everything the analysis stages produce for one game. owns its Game, so the
+// GameStates in the minimax and Monte Carlo paths stay valid while it moves between stages.
+struct GameAnalysis {
+    GameAnalysis(int gameNumber, int maxPlayerHandNumber, const Game& game) : gameNumber(gameNumber), maxPlayerHandNumber(maxPlayerHandNumber), game(game), gameTreeData(game.gameFoundation) {
+        ranPerfectInformation = false;
+        ranFullMinimax = false;
+        analysisDuration = 0.0;
+    }
+
+    int gameNumber;
+    int maxPlayerHandNumber;
+    Game game;
+    bool ranPerfectInformation; // game tree and alpha-beta data, false when only Monte Carlo ran
+    GameTreeData gameTreeData;
+    bool ranFullMinimax;
+    MinimaxData fullMinimaxData;
+    MinimaxData alphaBetaMinimaxData;
+    MonteCarloData monteCarloData;
+    MemoryData memoryData; // empty unless memory was measured
+    double analysisDuration; // seconds of stage work, excluding time spent queued
+
+    std::string prettyString(const bool printMinimaxPath) const {
+        std::string result = "";
+        if (ranPerfectInformation) {
+            result += "*Game Tree Data*\n" + gameTreeData.prettyString() + "\n";
+            if (ranFullMinimax) {
+                result += "*Full Minimax Data*\n" + fullMinimaxData.prettyString(false) + "\n";
+            }
+            result += "*Alpha-Beta Minimax Data*\n" + alphaBetaMinimaxData.prettyString(printMinimaxPath) + "\n";
+        }
+        result += "*Monte Carlo Data*\n" + monteCarloData.prettyString() + "\n";
+        if (!memoryData.phases.empty()) {
+            result += "*Memory Data*\n" + memoryData.prettyString() + "\n";
+        }
+        result += "Game " + std::to_string(gameNumber + 1) + " Analysis Time: " + std::to_string(analysisDuration) + " s\n";
+        return result;
+    }
+};
+
+#endif /* GameAnalysis_hpp */
@@ -6,11 +6,14 @@
 
 #include "MinimaxSearch.hpp"
 
-int MinimaxSearch::_minimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const int infinity, const int negativeInfinity) {
-    const int score = gameState.getScore();
+int MinimaxSearch::_minimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const int infinity, const int negativeInfinity, const StaticEvaluatorWeights* evaluatorWeights) {
+    int score = gameState.getScore();
 
     data.nodesVisited += 1;
 
+    if (depth == 0 && score == infinity && evaluatorWeights != NULL) {
+        score = StaticEvaluator::evaluate(gameState, *evaluatorWeights);
+    }
     if (depth == 0 || score != infinity) {
         gameState.minimaxValue = score;
         return score;
@@ -23,7 +26,7 @@ int MinimaxSearch::_minimaxSearch(MinimaxData& data, GameState& gameState, const
     if (gameState.isMaxPlayer()) {
         int value = negativeInfinity;
         for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
-            value = std::max(value, _minimaxSearch(data, gameState.children[childIndex], depth - 1, infinity, negativeInfinity));
+            value = std::max(value, _minimaxSearch(data, gameState.children[childIndex], depth - 1, infinity, negativeInfinity, evaluatorWeights));
             gameState.minimaxValue = value;
         }
         return value;
@@ -31,7 +34,7 @@ int MinimaxSearch::_minimaxSearch(MinimaxData& data, GameState& gameState, const
 
     int value = infinity;
     for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
-        value = std::min(value, _minimaxSearch(data, gameState.children[childIndex], depth - 1, infinity, negativeInfinity));
+        value = std::min(value, _minimaxSearch(data, gameState.children[childIndex], depth - 1, infinity, negativeInfinity, evaluatorWeights));
         gameState.minimaxValue = value;
     }
     return value;
@@ -40,21 +43,54 @@ int MinimaxSearch::_minimaxSearch(MinimaxData& data, GameState& gameState, const
 MinimaxData MinimaxSearch::runOnState(GameState& gameState) {
     const GameFoundation& gameFoundation = gameState.game.gameFoundation;
     MinimaxData result;
-    _minimaxSearch(result, gameState, gameFoundation.maxDepth, gameFoundation.infinity, gameFoundation.negativeInfinity);
+    _minimaxSearch(result, gameState, gameFoundation.maxDepth, gameFoundation.infinity, gameFoundation.negativeInfinity, NULL);
     result.minimaxValue = gameState.minimaxValue;
     return result;
 }
 
-MinimaxResult AlphaBetaMinimaxSearch::_alphaBetaMinimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, const int internalNodeScore) {
-    const int score = gameState.getScore();
+MinimaxData MinimaxSearch::runOnStateToDepth(GameState& gameState, const int depth, const StaticEvaluatorWeights& evaluatorWeights) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    MinimaxData result;
+    _minimaxSearch(result, gameState, depth, gameFoundation.infinity, gameFoundation.negativeInfinity, &evaluatorWeights);
+    result.minimaxValue = gameState.minimaxValue;
+    return result;
+}
+
+void AlphaBetaMinimaxSearch::_storeSolution(SolutionStore* solutionStore, const PositionKey& positionKey, const int score, const int alpha, const int beta) {
+    solutionStore->store(positionKey, SolutionEntry::entryForWindow(score, alpha, beta));
+}
+
+MinimaxResult AlphaBetaMinimaxSearch::_alphaBetaMinimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, const int internalNodeScore, SolutionStore* solutionStore, const StaticEvaluatorWeights* evaluatorWeights) {
+    int score = gameState.getScore();
 
     data.nodesVisited += 1;
 
+    if (depth == 0 && score == internalNodeScore && evaluatorWeights != NULL) {
+        score = StaticEvaluator::evaluate(gameState, *evaluatorWeights);
+    }
     if (depth == 0 || score != internalNodeScore) {
         gameState.minimaxValue = score;
         return MinimaxResult(&gameState, score);
     }
 
+    // the root starts at maxDepth and is never answered from the store. small endgames are cheaper to search than to look up.
+    // depth-limited searches run without a store, since their values are estimates.
+    assert(solutionStore == NULL || evaluatorWeights == NULL);
+    const bool useStore = solutionStore != NULL && depth != gameState.game.gameFoundation.maxDepth && (int)(gameState.maxPlayerHand.size() + gameState.minPlayerHand.size()) >= kMinimumTilesForSolutionStore;
+    PositionKey positionKey;
+    if (useStore) {
+        positionKey = gameState.positionKey();
+        SolutionEntry entry;
+        if (solutionStore->probe(positionKey, entry)) {
+            if (entry.bound == kSolutionBoundExact ||
+                (entry.bound == kSolutionBoundLower && entry.value >= beta.score) ||
+                (entry.bound == kSolutionBoundUpper && entry.value <= alpha.score)) {
+                gameState.minimaxValue = entry.value;
+                return MinimaxResult(&gameState, entry.value);
+            }
+        }
+    }
+
     gameState.expandAndGenerateChildren();
 
     const int numberOfChildren = (int)gameState.children.size();
@@ -62,7 +98,7 @@ MinimaxResult AlphaBetaMinimaxSearch::_alphaBetaMinimaxSearch(MinimaxData& data,
     if (gameState.isMaxPlayer()) {
         MinimaxResult alphaResult = alpha;
         for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
-            const MinimaxResult recursiveAlpha = _alphaBetaMinimaxSearch(data, gameState.children[childIndex], depth - 1, alphaResult, beta, internalNodeScore);
+            const MinimaxResult recursiveAlpha = _alphaBetaMinimaxSearch(data, gameState.children[childIndex], depth - 1, alphaResult, beta, internalNodeScore, solutionStore, evaluatorWeights);
             if (recursiveAlpha.score > alphaResult.score) {
                 alphaResult = recursiveAlpha;
             }
@@ -71,12 +107,15 @@ MinimaxResult AlphaBetaMinimaxSearch::_alphaBetaMinimaxSearch(MinimaxData& data,
                 break;
             }
         }
+        if (useStore) {
+            _storeSolution(solutionStore, positionKey, alphaResult.score, alpha.score, beta.score);
+        }
         return alphaResult;
     }
 
     MinimaxResult betaResult = beta;
     for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
-        const MinimaxResult recursiveBeta = _alphaBetaMinimaxSearch(data, gameState.children[childIndex], depth - 1, alpha, betaResult, internalNodeScore);
+        const MinimaxResult recursiveBeta = _alphaBetaMinimaxSearch(data, gameState.children[childIndex], depth - 1, alpha, betaResult, internalNodeScore, solutionStore, evaluatorWeights);
         if (recursiveBeta.score < betaResult.score) {
             betaResult = recursiveBeta;
         }
@@ -85,15 +124,23 @@ MinimaxResult AlphaBetaMinimaxSearch::_alphaBetaMinimaxSearch(MinimaxData& data,
             break;
         }
     }
+    if (useStore) {
+        _storeSolution(solutionStore, positionKey, betaResult.score, alpha.score, beta.score);
+    }
     return betaResult;
 }
 
-MinimaxData AlphaBetaMinimaxSearch::runOnState(GameState& gameState, const bool recordPath) {
+MinimaxData AlphaBetaMinimaxSearch::runOnState(GameState& gameState, const bool recordPath, SolutionStore* solutionStore) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    return runOnStateWithWindow(gameState, recordPath, gameFoundation.negativeInfinity, gameFoundation.infinity, solutionStore);
+}
+
+MinimaxData AlphaBetaMinimaxSearch::runOnStateWithWindow(GameState& gameState, const bool recordPath, const int alpha, const int beta, SolutionStore* solutionStore) {
     const GameFoundation& gameFoundation = gameState.game.gameFoundation;
 
     MinimaxData result;
 
-    MinimaxResult alphaBetaResult = _alphaBetaMinimaxSearch(result, gameState, gameFoundation.maxDepth, MinimaxResult(NULL, gameFoundation.negativeInfinity), MinimaxResult(NULL, gameFoundation.infinity), gameFoundation.infinity);
+    MinimaxResult alphaBetaResult = _alphaBetaMinimaxSearch(result, gameState, gameFoundation.maxDepth, MinimaxResult(NULL, alpha), MinimaxResult(NULL, beta), gameFoundation.infinity, solutionStore, NULL);
 
     if (recordPath) {
         GameState *node = alphaBetaResult.node;
@@ -104,10 +151,19 @@ MinimaxData AlphaBetaMinimaxSearch::runOnState(GameState& gameState, const bool
         }
     }
 
-    assert(alphaBetaResult.score == alphaBetaResult.node->minimaxValue);
-    assert(!recordPath || alphaBetaResult.node->depth + 1 == (int)result.path.size());
+    // node is NULL only when the value falls outside a caller-supplied window
+    assert(alphaBetaResult.node == NULL || alphaBetaResult.score == alphaBetaResult.node->minimaxValue);
+    assert(!recordPath || alphaBetaResult.node == NULL || alphaBetaResult.node->depth + 1 == (int)result.path.size());
 
     result.minimaxValue = alphaBetaResult.score;
 
     return result;
 }
+
+MinimaxData AlphaBetaMinimaxSearch::runOnStateToDepth(GameState& gameState, const int depth, const StaticEvaluatorWeights& evaluatorWeights) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    MinimaxData result;
+    const MinimaxResult alphaBetaResult = _alphaBetaMinimaxSearch(result, gameState, depth, MinimaxResult(NULL, gameFoundation.negativeInfinity), MinimaxResult(NULL, gameFoundation.infinity), gameFoundation.infinity, NULL, &evaluatorWeights);
+    result.minimaxValue = alphaBetaResult.score;
+    return result;
+}
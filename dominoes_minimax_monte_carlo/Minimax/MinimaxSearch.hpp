@@ -10,6 +10,10 @@
 #include "GameState.hpp"
 #include "GameFoundation.hpp"
 #include "MinimaxData.hpp"
+#include "SolutionStore.hpp"
+#include "StaticEvaluator.hpp"
+
+static const int kMinimumTilesForSolutionStore = 6;
 
 struct MinimaxResult {
     MinimaxResult(GameState *node, int score) {
@@ -22,16 +26,27 @@ struct MinimaxResult {
 
 class MinimaxSearch {
 private:
-    static int _minimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const int infinity, const int negativeInfinity);
+    static int _minimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const int infinity, const int negativeInfinity, const StaticEvaluatorWeights* evaluatorWeights);
 public:
     static MinimaxData runOnState(GameState& gameState);
+    // searches depth plies and estimates the internal nodes there with StaticEvaluator
+    static MinimaxData runOnStateToDepth(GameState& gameState, const int depth, const StaticEvaluatorWeights& evaluatorWeights);
 };
 
 class AlphaBetaMinimaxSearch {
 private:
-    static MinimaxResult _alphaBetaMinimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, const int internalNodeScore);
+    static void _storeSolution(SolutionStore* solutionStore, const PositionKey& positionKey, const int score, const int alpha, const int beta);
+    static MinimaxResult _alphaBetaMinimaxSearch(MinimaxData& data, GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, const int internalNodeScore, SolutionStore* solutionStore, const StaticEvaluatorWeights* evaluatorWeights);
 public:
-    static MinimaxData runOnState(GameState& gameState, const bool recordPath);
+    // when a solution store is given, positions below the root are looked up in and added to it.
+    // the root is always expanded so its children carry values for Monte Carlo voting.
+    static MinimaxData runOnState(GameState& gameState, const bool recordPath, SolutionStore* solutionStore = NULL);
+    // searches with the window (alpha, beta). the result is exact when the minimax value lies strictly inside it,
+    // e.g. with bounds from ProofNumberData.
+    static MinimaxData runOnStateWithWindow(GameState& gameState, const bool recordPath, const int alpha, const int beta, SolutionStore* solutionStore = NULL);
+    // searches depth plies and estimates the internal nodes there with StaticEvaluator. the values are
+    // estimates, so there is no solution store: it only ever holds proven values.
+    static MinimaxData runOnStateToDepth(GameState& gameState, const int depth, const StaticEvaluatorWeights& evaluatorWeights);
 };
 
 #endif /* MinimaxSearch_hpp */
@@ -0,0 +1,40 @@
+//
+//  MultiPVData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MultiPVData_hpp
+#define MultiPVData_hpp
+
+#include <string>
+#include <vector>
+
+#include "Domino.hpp"
+
+typedef std::vector<int> IntVector;
+typedef std::vector<Domino const*> DominoPointerVector;
+
+struct MultiPVData {
+    MultiPVData() : nodesVisited(0), searches(0), bestChildIndex(-1) {}
+
+    long long nodesVisited; // over every search of every child
+    int searches; // window searches, including re-searches after a window missed
+    int bestChildIndex; // first child with the best value for the player to move
+    IntVector childValues; // exact minimax value of each root child
+    IntVector childNodesVisited;
+    DominoPointerVector childTiles; // tile each child plays, NULL for a pass
+
+    std::string prettyString() const {
+        std::string result = "";
+        for (int i = 0; i < childValues.size(); i++) {
+            const std::string tileString = childTiles[i] != NULL ? childTiles[i]->prettyString() : "pass";
+            result += (i == bestChildIndex ? "* " : "  ") + tileString + ": " + std::to_string(childValues[i]) + " (" + std::to_string(childNodesVisited[i]) + " nodes)\n";
+        }
+        result += "Nodes Visited: " + std::to_string(nodesVisited) + "\n";
+        result += "Searches: " + std::to_string(searches) + "\n";
+        return result;
+    }
+};
+
+#endif /* MultiPVData_hpp */
@@ -0,0 +1,97 @@
+//
+//  MultiPVSearch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <memory>
+
+#include "MultiPVSearch.hpp"
+
+#include "MinimaxSearch.hpp"
+
+int MultiPVSearch::_exactValueForChild(GameState& child, const int guess, SolutionStore& solutionStore, MultiPVData& data, int& childNodesVisited) {
+    const GameFoundation& gameFoundation = child.game.gameFoundation;
+
+    if (child.isLeafNode()) {
+        childNodesVisited += 1;
+        return child.getScore();
+    }
+
+    int delta = kMultiPVAspirationWindow;
+    int alpha = std::max(gameFoundation.negativeInfinity, guess - delta);
+    int beta = std::min(gameFoundation.infinity, guess + delta);
+    while (true) {
+        // the search expands children, so start each one from a bare node
+        child.children.clear();
+        const MinimaxData windowData = AlphaBetaMinimaxSearch::runOnStateWithWindow(child, false, alpha, beta, &solutionStore);
+        data.searches++;
+        childNodesVisited += windowData.nodesVisited;
+
+        // fail-hard: a result on a window edge only bounds the value, so widen past that edge and search again
+        const int value = windowData.minimaxValue;
+        if (value <= alpha && alpha > gameFoundation.negativeInfinity) {
+            beta = alpha + 1;
+            alpha = std::max(gameFoundation.negativeInfinity, alpha - 2 * delta);
+        } else if (value >= beta && beta < gameFoundation.infinity) {
+            alpha = beta - 1;
+            beta = std::min(gameFoundation.infinity, beta + 2 * delta);
+        } else {
+            return value;
+        }
+        delta *= 2;
+    }
+}
+
+MultiPVData MultiPVSearch::runOnState(GameState& gameState, SolutionStore* solutionStore) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+
+    MultiPVData result;
+
+    std::unique_ptr<SolutionStore> temporaryStore;
+    if (solutionStore == NULL) {
+        temporaryStore.reset(new SolutionStore());
+        solutionStore = temporaryStore.get();
+    }
+
+    gameState.children.clear();
+    if (gameState.isLeafNode()) {
+        return result;
+    }
+    gameState.expandAndGenerateChildren();
+
+    const bool isMaxPlayer = gameState.isMaxPlayer();
+    int bestValue = isMaxPlayer ? gameFoundation.negativeInfinity : gameFoundation.infinity;
+    // the first child gets a full window, every later one starts around its predecessor's value
+    int guess = 0;
+    for (int i = 0; i < gameState.children.size(); i++) {
+        GameState& child = gameState.children[i];
+        int childNodesVisited = 0;
+        int value = 0;
+        if (i == 0 && !child.isLeafNode()) {
+            child.children.clear();
+            const MinimaxData fullWindowData = AlphaBetaMinimaxSearch::runOnState(child, false, solutionStore);
+            result.searches++;
+            childNodesVisited = fullWindowData.nodesVisited;
+            value = fullWindowData.minimaxValue;
+        } else {
+            value = _exactValueForChild(child, guess, *solutionStore, result, childNodesVisited);
+        }
+        child.minimaxValue = value;
+        guess = value;
+
+        result.childValues.push_back(value);
+        result.childNodesVisited.push_back(childNodesVisited);
+        result.nodesVisited += childNodesVisited;
+        // a pass plays no tile
+        result.childTiles.push_back(child.playedTiles.size() > gameState.playedTiles.size() ? child.playedTiles.back() : NULL);
+
+        if ((isMaxPlayer && value > bestValue) || (!isMaxPlayer && value < bestValue)) {
+            bestValue = value;
+            result.bestChildIndex = i;
+        }
+    }
+    gameState.minimaxValue = bestValue;
+
+    return result;
+}
@@ -0,0 +1,28 @@
+//
+//  MultiPVSearch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MultiPVSearch_hpp
+#define MultiPVSearch_hpp
+
+#include "GameState.hpp"
+#include "MultiPVData.hpp"
+#include "SolutionStore.hpp"
+
+static const int kMultiPVAspirationWindow = 4; // half width of the first window around the previous child's value
+
+// exact values for every root move, where plain alpha-beta only leaves bounds on the moves it refutes.
+// each child is searched with a narrow window around the previous child's value that widens until the value
+// falls inside it. the children share one solution store, so re-searches and common subtrees are cheap.
+class MultiPVSearch {
+private:
+    static int _exactValueForChild(GameState& child, const int guess, SolutionStore& solutionStore, MultiPVData& data, int& childNodesVisited);
+public:
+    // gameState's children are regenerated and given their exact minimaxValue. without a solution store a
+    // temporary one is used for this call.
+    static MultiPVData runOnState(GameState& gameState, SolutionStore* solutionStore = NULL);
+};
+
+#endif /* MultiPVSearch_hpp */
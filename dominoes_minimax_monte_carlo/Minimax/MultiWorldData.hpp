@@ -0,0 +1,32 @@
+//
+//  MultiWorldData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MultiWorldData_hpp
+#define MultiWorldData_hpp
+
+#include <string>
+#include <vector>
+
+typedef std::vector<int> IntVector;
+typedef std::vector<IntVector> IntVectorVector;
+
+struct MultiWorldData {
+    MultiWorldData() : nodesVisited(0), worldNodesVisited(0) {}
+
+    long long nodesVisited; // nodes expanded once for a whole group of worlds
+    long long worldNodesVisited; // the same nodes counted once per world, what separate searches would visit at least
+    IntVectorVector childValues; // [world][root child], in GameState::expandAndGenerateChildren order
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Nodes Visited: " + std::to_string(nodesVisited) + "\n";
+        result += "World Nodes Visited: " + std::to_string(worldNodesVisited) + "\n";
+        result += "Worlds: " + std::to_string(childValues.size()) + "\n";
+        return result;
+    }
+};
+
+#endif /* MultiWorldData_hpp */
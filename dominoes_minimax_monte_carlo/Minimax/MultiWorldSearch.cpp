@@ -0,0 +1,305 @@
+//
+//  MultiWorldSearch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "MultiWorldSearch.hpp"
+
+static inline int bitCount(const uint64_t tiles) {
+    return __builtin_popcountll(tiles);
+}
+
+static inline int lowestBit(const uint64_t tiles) {
+    return __builtin_ctzll(tiles);
+}
+
+int MultiWorldSearch::_pipTotal(const Context& context, uint64_t tiles) {
+    int total = 0;
+    while (tiles != 0) {
+        total += context.pips[lowestBit(tiles)];
+        tiles &= tiles - 1;
+    }
+    return total;
+}
+
+// mirrors GameState::getScore for a jammed layout
+int MultiWorldSearch::_jamScore(const Context& context, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles) {
+    const int maxPlayerPointTotal = _pipTotal(context, maxPlayerTiles);
+    const int minPlayerPointTotal = _pipTotal(context, minPlayerTiles);
+    if (maxPlayerPointTotal < minPlayerPointTotal) {
+        return minPlayerPointTotal;
+    }
+    if (maxPlayerPointTotal > minPlayerPointTotal) {
+        return -1 * maxPlayerPointTotal;
+    }
+
+    int smallestValue[kNumberOfPlayers];
+    int smallestSuit[kNumberOfPlayers];
+    const uint64_t playerTiles[kNumberOfPlayers] = { maxPlayerTiles, minPlayerTiles };
+    for (int player = 0; player < kNumberOfPlayers; player++) {
+        smallestValue[player] = context.infinity;
+        smallestSuit[player] = context.infinity;
+        for (uint64_t tiles = playerTiles[player]; tiles != 0; tiles &= tiles - 1) {
+            const int tileIndex = lowestBit(tiles);
+            if (context.pips[tileIndex] < smallestValue[player] || (context.pips[tileIndex] == smallestValue[player] && context.smallerSuit[tileIndex] < smallestSuit[player])) {
+                smallestValue[player] = context.pips[tileIndex];
+                smallestSuit[player] = context.smallerSuit[tileIndex];
+            }
+        }
+    }
+    if (smallestValue[0] < smallestValue[1]) {
+        return minPlayerPointTotal;
+    }
+    if (smallestValue[0] > smallestValue[1]) {
+        return -1 * maxPlayerPointTotal;
+    }
+    if (smallestSuit[0] < smallestSuit[1]) {
+        return smallestValue[1];
+    }
+    return -1 * maxPlayerPointTotal;
+}
+
+bool MultiWorldSearch::_scoreIfLeaf(const Context& context, const MultiWorldNode& node, const uint32_t lanes, int* values) {
+    // worlds that reach the same node have played the same number of hidden tiles
+    const int firstLane = lowestBit(lanes);
+    const int knownCount = bitCount(node.knownTiles);
+    const int hiddenCount = bitCount(node.hiddenTiles[firstLane]);
+    const bool knownIsMax = context.knownPlayerIndex == 0;
+    const int maxPlayerCount = knownIsMax ? knownCount : hiddenCount;
+    const int minPlayerCount = knownIsMax ? hiddenCount : knownCount;
+
+    if (!(maxPlayerCount == 0 && minPlayerCount > 0) && !(minPlayerCount == 0 && maxPlayerCount > 0) && !node.jammed) {
+        return false;
+    }
+
+    for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+        if (!((lanes >> lane) & 1)) {
+            continue;
+        }
+        const uint64_t maxPlayerTiles = knownIsMax ? node.knownTiles : node.hiddenTiles[lane];
+        const uint64_t minPlayerTiles = knownIsMax ? node.hiddenTiles[lane] : node.knownTiles;
+        if (maxPlayerCount == 0) {
+            values[lane] = _pipTotal(context, minPlayerTiles);
+        } else if (minPlayerCount == 0) {
+            values[lane] = -1 * _pipTotal(context, maxPlayerTiles);
+        } else {
+            values[lane] = _jamScore(context, maxPlayerTiles, minPlayerTiles);
+        }
+    }
+    return true;
+}
+
+MultiWorldNode MultiWorldSearch::_childNode(const Context& context, const MultiWorldNode& node, const int tileIndex, const int layoutValue) {
+    MultiWorldNode child = node;
+    const uint64_t tileBit = 1ULL << tileIndex;
+    if (node.playerTurnIndex == context.knownPlayerIndex) {
+        child.knownTiles &= ~tileBit;
+    } else {
+        for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+            child.hiddenTiles[lane] &= ~tileBit;
+        }
+    }
+    // same rules as GameState::_updateLayoutEnds
+    const int first = context.firstSuit[tileIndex];
+    const int second = context.secondSuit[tileIndex];
+    if (node.playedCount == 0) {
+        child.layoutFirst = first;
+        child.layoutSecond = second;
+    } else if (layoutValue == node.layoutFirst) {
+        child.layoutFirst = first == node.layoutFirst ? second : first;
+    } else {
+        child.layoutSecond = first == node.layoutSecond ? second : first;
+    }
+    child.playedCount = node.playedCount + 1;
+    child.previousPlayerPassed = false;
+    child.jammed = false;
+    child.playerTurnIndex = 1 - node.playerTurnIndex;
+    return child;
+}
+
+MultiWorldNode MultiWorldSearch::_passNode(const MultiWorldNode& node) {
+    MultiWorldNode child = node;
+    child.previousPlayerPassed = true;
+    child.jammed = node.previousPlayerPassed;
+    child.playerTurnIndex = 1 - node.playerTurnIndex;
+    return child;
+}
+
+void MultiWorldSearch::_search(const Context& context, MultiWorldData& data, const MultiWorldNode& node, const uint32_t lanes, const int* alpha, const int* beta, int* values) {
+    data.nodesVisited += 1;
+    data.worldNodesVisited += bitCount(lanes);
+
+    if (_scoreIfLeaf(context, node, lanes, values)) {
+        return;
+    }
+
+    const bool isMaxPlayer = node.playerTurnIndex == 0;
+    const bool isKnownPlayer = node.playerTurnIndex == context.knownPlayerIndex;
+
+    // tiles that fit the layout, and the lanes that cannot play any of them
+    uint64_t playableTiles = ~0ULL;
+    if (node.playedCount > 0) {
+        playableTiles = context.tilesWithSuit[node.layoutFirst] | context.tilesWithSuit[node.layoutSecond];
+    }
+    uint64_t candidateTiles = 0;
+    uint32_t passLanes = 0;
+    if (isKnownPlayer) {
+        candidateTiles = node.knownTiles & playableTiles;
+        passLanes = candidateTiles == 0 ? lanes : 0;
+    } else {
+        for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+            if ((lanes >> lane) & 1) {
+                const uint64_t laneTiles = node.hiddenTiles[lane] & playableTiles;
+                candidateTiles |= laneTiles;
+                passLanes |= (laneTiles == 0 ? 1u : 0u) << lane;
+            }
+        }
+    }
+
+    int value[kMultiWorldWidth];
+    int childValues[kMultiWorldWidth];
+    for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+        value[lane] = isMaxPlayer ? alpha[lane] : beta[lane];
+    }
+    uint32_t activeLanes = lanes;
+
+    // visits one child with the lanes that can make its move, then folds its values in and drops lanes that cut off
+    auto visitChild = [&](const MultiWorldNode& child, const uint32_t childLanes) {
+        // a leaf child only writes its own lanes, so every lane starts from a defined value
+        std::copy(value, value + kMultiWorldWidth, childValues);
+        if (isMaxPlayer) {
+            _search(context, data, child, childLanes, value, beta, childValues);
+        } else {
+            _search(context, data, child, childLanes, alpha, value, childValues);
+        }
+        uint32_t stillActive = 0;
+        for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+            const bool inChild = (childLanes >> lane) & 1;
+            const int folded = isMaxPlayer ? std::max(value[lane], childValues[lane]) : std::min(value[lane], childValues[lane]);
+            value[lane] = inChild ? folded : value[lane];
+            const bool cutOff = isMaxPlayer ? beta[lane] <= value[lane] : value[lane] <= alpha[lane];
+            stillActive |= (((activeLanes >> lane) & 1) && !cutOff ? 1u : 0u) << lane;
+        }
+        activeLanes = stillActive;
+    };
+
+    for (uint64_t tiles = candidateTiles; tiles != 0 && activeLanes != 0; tiles &= tiles - 1) {
+        const int tileIndex = lowestBit(tiles);
+        uint32_t tileLanes = activeLanes;
+        if (!isKnownPlayer) {
+            tileLanes = 0;
+            for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+                tileLanes |= (((activeLanes >> lane) & 1) && ((node.hiddenTiles[lane] >> tileIndex) & 1) ? 1u : 0u) << lane;
+            }
+            if (tileLanes == 0) {
+                continue;
+            }
+        }
+        // same children as GameState::expandAndGenerateChildren
+        if (node.playedCount == 0) {
+            visitChild(_childNode(context, node, tileIndex, -1), tileLanes);
+            continue;
+        }
+        const bool fitsFirst = context.firstSuit[tileIndex] == node.layoutFirst || context.secondSuit[tileIndex] == node.layoutFirst;
+        const bool fitsSecond = context.firstSuit[tileIndex] == node.layoutSecond || context.secondSuit[tileIndex] == node.layoutSecond;
+        if (fitsFirst) {
+            visitChild(_childNode(context, node, tileIndex, node.layoutFirst), tileLanes);
+        }
+        if (fitsSecond && node.layoutFirst != node.layoutSecond && (activeLanes & tileLanes) != 0) {
+            visitChild(_childNode(context, node, tileIndex, node.layoutSecond), activeLanes & tileLanes);
+        }
+    }
+
+    if ((passLanes & activeLanes) != 0) {
+        visitChild(_passNode(node), passLanes & activeLanes);
+    }
+
+    for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+        values[lane] = value[lane];
+    }
+}
+
+MultiWorldData MultiWorldSearch::runOnWorlds(const GameState& gameState, const std::vector<DominoPointerVector>& hiddenHands) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    assert(hiddenHands.size() > 0 && hiddenHands.size() <= kMultiWorldWidth);
+    assert(gameFoundation.numberOfDominoes <= 64);
+
+    Context context;
+    context.knownPlayerIndex = gameState.playerTurnIndex;
+    context.infinity = gameFoundation.infinity;
+    context.numberOfDominoes = gameFoundation.numberOfDominoes;
+    for (int suit = 0; suit < 64; suit++) {
+        context.tilesWithSuit[suit] = 0;
+    }
+    for (int i = 0; i < gameFoundation.numberOfDominoes; i++) {
+        const Domino& domino = gameFoundation.dominoSet[i];
+        context.pips[i] = domino.getTileTotal();
+        context.smallerSuit[i] = domino.smallerSuit();
+        context.firstSuit[i] = domino.ends.first;
+        context.secondSuit[i] = domino.ends.second;
+        context.tilesWithSuit[domino.ends.first] |= 1ULL << i;
+        context.tilesWithSuit[domino.ends.second] |= 1ULL << i;
+    }
+
+    const int numberOfWorlds = (int)hiddenHands.size();
+    const uint32_t lanes = (1u << numberOfWorlds) - 1;
+
+    // the root player is the known player, so root children come straight from GameState in its order
+    GameState rootState = GameState::stateRemovingChildren(gameState);
+    rootState.expandAndGenerateChildren();
+    const int numberOfChildren = (int)rootState.children.size();
+
+    MultiWorldData result;
+    result.childValues.assign(numberOfWorlds, IntVector(numberOfChildren, 0));
+
+    const bool isMaxPlayer = gameState.isMaxPlayer();
+    int best[kMultiWorldWidth];
+    int open[kMultiWorldWidth];
+    int childValues[kMultiWorldWidth];
+    for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+        best[lane] = isMaxPlayer ? gameFoundation.negativeInfinity : gameFoundation.infinity;
+        open[lane] = isMaxPlayer ? gameFoundation.infinity : gameFoundation.negativeInfinity;
+    }
+
+    result.nodesVisited += 1;
+    result.worldNodesVisited += numberOfWorlds;
+
+    for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
+        const GameState& child = rootState.children[childIndex];
+        MultiWorldNode node;
+        uint64_t knownTiles = 0;
+        const DominoPointerVector& knownHand = context.knownPlayerIndex == 0 ? child.maxPlayerHand : child.minPlayerHand;
+        for (int i = 0; i < knownHand.size(); i++) {
+            knownTiles |= 1ULL << gameFoundation.indexForDomino(knownHand[i]);
+        }
+        node.knownTiles = knownTiles;
+        for (int lane = 0; lane < kMultiWorldWidth; lane++) {
+            uint64_t hiddenTiles = 0;
+            if (lane < numberOfWorlds) {
+                for (int i = 0; i < hiddenHands[lane].size(); i++) {
+                    hiddenTiles |= 1ULL << gameFoundation.indexForDomino(hiddenHands[lane][i]);
+                }
+            }
+            node.hiddenTiles[lane] = hiddenTiles;
+        }
+        node.layoutFirst = child.layoutEnds.first;
+        node.layoutSecond = child.layoutEnds.second;
+        node.playerTurnIndex = child.playerTurnIndex;
+        node.playedCount = (int)child.playedTiles.size();
+        node.previousPlayerPassed = child.previousPlayerPassed;
+        node.jammed = child.jammed;
+
+        if (isMaxPlayer) {
+            _search(context, result, node, lanes, best, open, childValues);
+        } else {
+            _search(context, result, node, lanes, open, best, childValues);
+        }
+        for (int lane = 0; lane < numberOfWorlds; lane++) {
+            result.childValues[lane][childIndex] = childValues[lane];
+            best[lane] = isMaxPlayer ? std::max(best[lane], childValues[lane]) : std::min(best[lane], childValues[lane]);
+        }
+    }
+
+    return result;
+}
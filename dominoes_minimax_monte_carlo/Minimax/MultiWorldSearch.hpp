@@ -0,0 +1,57 @@
+//
+//  MultiWorldSearch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MultiWorldSearch_hpp
+#define MultiWorldSearch_hpp
+
+#include <stdint.h>
+
+#include "GameState.hpp"
+#include "MultiWorldData.hpp"
+
+static const int kMultiWorldWidth = 8; // worlds searched in lockstep, one per lane
+
+// a position in up to kMultiWorldWidth worlds that agree on everything but the hidden hand
+struct MultiWorldNode {
+    uint64_t knownTiles;
+    uint64_t hiddenTiles[kMultiWorldWidth];
+    int layoutFirst;
+    int layoutSecond;
+    int playerTurnIndex;
+    int playedCount;
+    bool previousPlayerPassed;
+    bool jammed;
+};
+
+// alpha-beta over several sampled worlds (Monte Carlo determinizations) at once. worlds share the
+// known player's hand, the played tiles and the layout, so a node is generated once for every world
+// that reached it and lanes only split where the hidden player's legal moves differ. each lane keeps
+// its own alpha/beta, updated with branch-free per-lane min/max that the compiler can vectorize.
+class MultiWorldSearch {
+private:
+    struct Context {
+        int knownPlayerIndex;
+        int infinity;
+        int numberOfDominoes;
+        int pips[64];
+        int smallerSuit[64];
+        int firstSuit[64];
+        int secondSuit[64];
+        uint64_t tilesWithSuit[64];
+    };
+
+    static int _pipTotal(const Context& context, uint64_t tiles);
+    static int _jamScore(const Context& context, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles);
+    static bool _scoreIfLeaf(const Context& context, const MultiWorldNode& node, const uint32_t lanes, int* values);
+    static MultiWorldNode _childNode(const Context& context, const MultiWorldNode& node, const int tileIndex, const int layoutValue);
+    static MultiWorldNode _passNode(const MultiWorldNode& node);
+    static void _search(const Context& context, MultiWorldData& data, const MultiWorldNode& node, const uint32_t lanes, const int* alpha, const int* beta, int* values);
+public:
+    // hiddenHands holds one hand per world (at most kMultiWorldWidth) for the opponent of the player to move
+    static MultiWorldData runOnWorlds(const GameState& gameState, const std::vector<DominoPointerVector>& hiddenHands);
+};
+
+#endif /* MultiWorldSearch_hpp */
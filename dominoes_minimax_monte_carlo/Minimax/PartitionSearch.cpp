@@ -0,0 +1,123 @@
+//
+//  PartitionSearch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "PartitionSearch.hpp"
+#include "MinimaxSearch.hpp"
+
+int PartitionSearch::_pipTotal(const DominoPointerVector& hand) {
+    int total = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        total += hand[i]->getTileTotal();
+    }
+    return total;
+}
+
+uint64_t PartitionSearch::_tileMask(const DominoPointerVector& hand, const GameFoundation& gameFoundation) {
+    uint64_t mask = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        mask |= (1ULL << gameFoundation.indexForDomino(hand[i]));
+    }
+    return mask;
+}
+
+int PartitionSearch::_partitionSearch(MinimaxData& data, GameState& gameState, const int alpha, const int beta, const int hiddenPlayerIndex, PartitionTable& partitionTable, const bool isRoot, Partition& partition) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    const DominoPointerVector& hiddenHand = hiddenPlayerIndex == 0 ? gameState.maxPlayerHand : gameState.minPlayerHand;
+    const DominoPointerVector& knownHand = hiddenPlayerIndex == 0 ? gameState.minPlayerHand : gameState.maxPlayerHand;
+    const uint64_t hiddenTiles = _tileMask(hiddenHand, gameFoundation);
+    const int hiddenPipTotal = _pipTotal(hiddenHand);
+
+    data.nodesVisited += 1;
+
+    const int score = gameState.getScore();
+    if (score != gameFoundation.infinity) {
+        gameState.minimaxValue = score;
+        // a jam between equal pip totals is broken by the smallest tiles, which depends on exactly which tiles are held
+        if (gameState.jammed && hiddenPipTotal == _pipTotal(knownHand)) {
+            partition.requiredTiles |= hiddenTiles;
+        }
+        return score;
+    }
+
+    const bool useTable = !isRoot && (int)(knownHand.size() + hiddenHand.size()) >= kMinimumTilesForSolutionStore;
+    PartitionKey partitionKey;
+    if (useTable) {
+        partitionKey = PartitionKey(_tileMask(knownHand, gameFoundation), gameState.layoutEnds, gameState.playerTurnIndex, gameState.previousPlayerPassed, hiddenPlayerIndex, (int)hiddenHand.size(), hiddenPipTotal);
+        PartitionEntry entry;
+        if (partitionTable.probe(partitionKey, hiddenTiles, gameFoundation, entry)) {
+            const SolutionEntry& solution = entry.solution;
+            if (solution.bound == kSolutionBoundExact ||
+                (solution.bound == kSolutionBoundLower && solution.value >= beta) ||
+                (solution.bound == kSolutionBoundUpper && solution.value <= alpha)) {
+                partition.merge(entry.partition);
+                gameState.minimaxValue = solution.value;
+                return solution.value;
+            }
+        }
+    }
+
+    Partition nodePartition;
+    const bool isHiddenPlayerTurn = gameState.playerTurnIndex == hiddenPlayerIndex;
+    if (isHiddenPlayerTurn) {
+        if (gameState.playedTiles.empty()) {
+            nodePartition.requiredTiles = hiddenTiles; // every tile can lead
+        } else {
+            // which tiles fit, and whether the hidden player passes, depends only on tiles with these suits
+            nodePartition.excludedSuits |= (1 << gameState.layoutEnds.first) | (1 << gameState.layoutEnds.second);
+        }
+    }
+
+    gameState.expandAndGenerateChildren();
+
+    const int numberOfChildren = (int)gameState.children.size();
+    const bool isMaxPlayer = gameState.isMaxPlayer();
+    int value = isMaxPlayer ? alpha : beta;
+    for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
+        GameState& child = gameState.children[childIndex];
+        Partition childPartition;
+        const int childValue = isMaxPlayer ? _partitionSearch(data, child, value, beta, hiddenPlayerIndex, partitionTable, false, childPartition) : _partitionSearch(data, child, alpha, value, hiddenPlayerIndex, partitionTable, false, childPartition);
+        nodePartition.merge(childPartition);
+        if ((isMaxPlayer && childValue > value) || (!isMaxPlayer && childValue < value)) {
+            value = childValue;
+        }
+        gameState.minimaxValue = value;
+        if ((isMaxPlayer && beta <= value) || (!isMaxPlayer && value <= alpha)) {
+            break;
+        }
+    }
+
+    // every held tile with an excluded suit is pinned, so the searched hand is always inside its own partition
+    for (int i = 0; i < hiddenHand.size(); i++) {
+        if ((nodePartition.excludedSuits & ((1 << hiddenHand[i]->ends.first) | (1 << hiddenHand[i]->ends.second))) != 0) {
+            nodePartition.requiredTiles |= (1ULL << gameFoundation.indexForDomino(hiddenHand[i]));
+        }
+    }
+
+    if (!isRoot) {
+        gameState.children.clear();
+    }
+
+    if (useTable) {
+        SolutionBound bound = kSolutionBoundExact;
+        if (value <= alpha) {
+            bound = kSolutionBoundUpper;
+        } else if (value >= beta) {
+            bound = kSolutionBoundLower;
+        }
+        partitionTable.store(partitionKey, PartitionEntry(nodePartition, SolutionEntry(value, bound)));
+    }
+
+    partition.merge(nodePartition);
+    return value;
+}
+
+MinimaxData PartitionSearch::runOnState(GameState& gameState, const int hiddenPlayerIndex, PartitionTable& partitionTable) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    MinimaxData result;
+    Partition rootPartition;
+    result.minimaxValue = _partitionSearch(result, gameState, gameFoundation.negativeInfinity, gameFoundation.infinity, hiddenPlayerIndex, partitionTable, true, rootPartition);
+    return result;
+}
@@ -0,0 +1,28 @@
+//
+//  PartitionSearch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef PartitionSearch_hpp
+#define PartitionSearch_hpp
+
+#include "GameState.hpp"
+#include "MinimaxData.hpp"
+#include "PartitionTable.hpp"
+
+// alpha-beta whose table entries hold for every hidden hand in a partition rather than for one deal.
+// a search result only depends on the hidden tiles that were played or could have been played, so
+// Monte Carlo samples that differ in the hidden player's other tiles share results.
+class PartitionSearch {
+private:
+    static int _pipTotal(const DominoPointerVector& hand);
+    static uint64_t _tileMask(const DominoPointerVector& hand, const GameFoundation& gameFoundation);
+    static int _partitionSearch(MinimaxData& data, GameState& gameState, const int alpha, const int beta, const int hiddenPlayerIndex, PartitionTable& partitionTable, const bool isRoot, Partition& partition);
+public:
+    // hiddenPlayerIndex is the player whose hand is unknown (sampled). root children keep their values
+    // for Monte Carlo voting, the same way AlphaBetaMinimaxSearch leaves them.
+    static MinimaxData runOnState(GameState& gameState, const int hiddenPlayerIndex, PartitionTable& partitionTable);
+};
+
+#endif /* PartitionSearch_hpp */
@@ -0,0 +1,71 @@
+//
+//  PartitionTable.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "PartitionTable.hpp"
+
+bool PartitionTable::probe(const PartitionKey& key, const uint64_t hiddenTiles, const GameFoundation& gameFoundation, PartitionEntry& entry) {
+    _probes++;
+    Shard& shard = _shardForKey(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.entries.find(key);
+    if (found == shard.entries.end()) {
+        return false;
+    }
+    const std::vector<PartitionEntry>& candidates = found->second;
+    for (int i = 0; i < candidates.size(); i++) {
+        const Partition& partition = candidates[i].partition;
+        if ((partition.requiredTiles & hiddenTiles) != partition.requiredTiles) {
+            continue;
+        }
+        if ((gameFoundation.suitMaskForTiles(hiddenTiles & ~partition.requiredTiles) & partition.excludedSuits) != 0) {
+            continue;
+        }
+        _hits++;
+        entry = candidates[i];
+        return true;
+    }
+    return false;
+}
+
+void PartitionTable::store(const PartitionKey& key, const PartitionEntry& entry) {
+    Shard& shard = _shardForKey(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::vector<PartitionEntry>& candidates = shard.entries[key];
+    // an entry for the same partition is replaced unless that would trade an exact value for a bound
+    for (int i = 0; i < candidates.size(); i++) {
+        const Partition& partition = candidates[i].partition;
+        if (partition.requiredTiles == entry.partition.requiredTiles && partition.excludedSuits == entry.partition.excludedSuits) {
+            if (entry.solution.bound == kSolutionBoundExact || candidates[i].solution.bound != kSolutionBoundExact) {
+                candidates[i] = entry;
+            }
+            return;
+        }
+    }
+    if (candidates.size() >= kMaxPartitionEntriesPerKey) {
+        candidates.erase(candidates.begin());
+    }
+    candidates.push_back(entry);
+}
+
+void PartitionTable::clear() {
+    for (int i = 0; i < kNumberOfShards; i++) {
+        std::lock_guard<std::mutex> lock(_shards[i].mutex);
+        _shards[i].entries.clear();
+    }
+    _probes = 0;
+    _hits = 0;
+}
+
+long long PartitionTable::size() {
+    long long result = 0;
+    for (int i = 0; i < kNumberOfShards; i++) {
+        std::lock_guard<std::mutex> lock(_shards[i].mutex);
+        for (const auto& keyAndEntries : _shards[i].entries) {
+            result += (long long)keyAndEntries.second.size();
+        }
+    }
+    return result;
+}
@@ -0,0 +1,113 @@
+//
+//  PartitionTable.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef PartitionTable_hpp
+#define PartitionTable_hpp
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "GameFoundation.hpp"
+#include "PositionKey.hpp"
+#include "SolutionStore.hpp"
+
+static const int kMaxPartitionEntriesPerKey = 8;
+
+// everything a partition entry must match exactly. the hidden player's hand is only
+// described by its size and pip total here; which tiles it holds is the partition.
+struct PartitionKey {
+    PartitionKey(uint64_t knownTiles = 0, IntPair layoutEnds = std::make_pair(-1, -1), int playerTurnIndex = 0, bool previousPlayerPassed = false, int hiddenPlayerIndex = 0, int hiddenTileCount = 0, int hiddenPipTotal = 0) : knownTiles(knownTiles), playerTurnIndex((int8_t)playerTurnIndex), previousPlayerPassed(previousPlayerPassed), hiddenPlayerIndex((int8_t)hiddenPlayerIndex), hiddenTileCount((int8_t)hiddenTileCount), hiddenPipTotal((int16_t)hiddenPipTotal) {
+        layoutFirst = (int8_t)layoutEnds.first;
+        layoutSecond = (int8_t)layoutEnds.second;
+    }
+
+    uint64_t knownTiles;
+    int8_t layoutFirst;
+    int8_t layoutSecond;
+    int8_t playerTurnIndex;
+    bool previousPlayerPassed;
+    int8_t hiddenPlayerIndex;
+    int8_t hiddenTileCount;
+    int16_t hiddenPipTotal;
+
+    inline bool operator==(const PartitionKey& other) const {
+        return knownTiles == other.knownTiles &&
+               layoutFirst == other.layoutFirst &&
+               layoutSecond == other.layoutSecond &&
+               playerTurnIndex == other.playerTurnIndex &&
+               previousPlayerPassed == other.previousPlayerPassed &&
+               hiddenPlayerIndex == other.hiddenPlayerIndex &&
+               hiddenTileCount == other.hiddenTileCount &&
+               hiddenPipTotal == other.hiddenPipTotal;
+    }
+};
+
+struct PartitionKeyHash {
+    inline size_t operator()(const PartitionKey& key) const {
+        const uint64_t small = ((uint64_t)(uint8_t)key.hiddenTileCount) | ((uint64_t)(uint16_t)key.hiddenPipTotal << 8) | ((uint64_t)key.hiddenPlayerIndex << 24);
+        return (size_t)PositionKey(key.knownTiles, small, std::make_pair(key.layoutFirst, key.layoutSecond), key.playerTurnIndex, key.previousPlayerPassed).hashValue();
+    }
+};
+
+// the set of hidden hands a result holds for: every hand of the key's size and pip total that
+// contains requiredTiles and whose other tiles have none of the suits in excludedSuits.
+// those other tiles can never be played in the searched subtree, so the search is identical.
+struct Partition {
+    Partition(uint64_t requiredTiles = 0, int excludedSuits = 0) : requiredTiles(requiredTiles), excludedSuits(excludedSuits) {}
+
+    uint64_t requiredTiles;
+    int excludedSuits; // bit per suit
+
+    inline void merge(const Partition& other) {
+        requiredTiles |= other.requiredTiles;
+        excludedSuits |= other.excludedSuits;
+    }
+};
+
+struct PartitionEntry {
+    PartitionEntry(Partition partition = Partition(), SolutionEntry solution = SolutionEntry()) : partition(partition), solution(solution) {}
+
+    Partition partition;
+    SolutionEntry solution;
+};
+
+// thread-safe table of results that each hold for a whole partition of hidden hands
+class PartitionTable {
+private:
+    static const int kNumberOfShards = 64;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<PartitionKey, std::vector<PartitionEntry>, PartitionKeyHash> entries;
+    };
+
+    Shard _shards[kNumberOfShards];
+    std::atomic<long long> _probes;
+    std::atomic<long long> _hits;
+
+    inline Shard& _shardForKey(const PartitionKey& key) {
+        return _shards[PartitionKeyHash()(key) % kNumberOfShards];
+    }
+public:
+    PartitionTable() : _probes(0), _hits(0) {}
+
+    // finds an entry whose partition contains hiddenTiles
+    bool probe(const PartitionKey& key, const uint64_t hiddenTiles, const GameFoundation& gameFoundation, PartitionEntry& entry);
+    void store(const PartitionKey& key, const PartitionEntry& entry);
+    void clear();
+    long long size();
+
+    inline long long getProbes() const {
+        return _probes.load();
+    }
+    inline long long getHits() const {
+        return _hits.load();
+    }
+};
+
+#endif /* PartitionTable_hpp */
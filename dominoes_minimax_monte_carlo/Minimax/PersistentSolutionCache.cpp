@@ -0,0 +1,215 @@
+//
+//  PersistentSolutionCache.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "PersistentSolutionCache.hpp"
+
+static const uint64_t kPackedKeyMask = 0x3FFFF; // the ends, turn and pass bits. the value is above bit 32
+
+PersistentSolutionCache::~PersistentSolutionCache() {
+    close();
+}
+
+bool PersistentSolutionCache::headerMatches(const PersistentSolutionCacheHeader& header, const GameFoundation& gameFoundation) {
+    return memcmp(header.magic, kPersistentSolutionCacheMagic, sizeof(kPersistentSolutionCacheMagic)) == 0 &&
+           header.version == kPersistentSolutionCacheVersion &&
+           header.sizeLog2 > 0 && header.sizeLog2 < 40 &&
+           header.handSize == (uint32_t)gameFoundation.handSize &&
+           header.maxDominoSuit == (uint32_t)gameFoundation.maxDominoSuit &&
+           header.slotSize == (uint32_t)sizeof(Slot);
+}
+
+bool PersistentSolutionCache::open(const std::string& path, const GameFoundation& gameFoundation, const int sizeLog2) {
+    static_assert(sizeof(PersistentSolutionCacheHeader) == 64, "slots should start on a cache line");
+    static_assert(sizeof(Slot) == 32, "two slots per cache line");
+    close();
+
+    const int fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    // the first process to open a new file sizes and stamps it while any others wait
+    if (flock(fileDescriptor, LOCK_EX) != 0) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    PersistentSolutionCacheHeader header;
+    struct stat fileStatus;
+    bool valid = fstat(fileDescriptor, &fileStatus) == 0;
+    if (valid && fileStatus.st_size == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, kPersistentSolutionCacheMagic, sizeof(kPersistentSolutionCacheMagic));
+        header.version = kPersistentSolutionCacheVersion;
+        header.sizeLog2 = (uint32_t)sizeLog2;
+        header.handSize = (uint32_t)gameFoundation.handSize;
+        header.maxDominoSuit = (uint32_t)gameFoundation.maxDominoSuit;
+        header.slotSize = (uint32_t)sizeof(Slot);
+        // the slots are a hole in the file, so they read as empty and only take disk space once written
+        const off_t fileSize = (off_t)sizeof(header) + ((off_t)1 << sizeLog2) * (off_t)sizeof(Slot);
+        valid = ftruncate(fileDescriptor, fileSize) == 0 && pwrite(fileDescriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+        fileStatus.st_size = fileSize;
+    } else if (valid) {
+        valid = pread(fileDescriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header) && headerMatches(header, gameFoundation);
+    }
+    const size_t expectedSize = valid ? sizeof(header) + ((size_t)1 << header.sizeLog2) * sizeof(Slot) : 0;
+    valid = valid && (size_t)fileStatus.st_size >= expectedSize;
+    flock(fileDescriptor, LOCK_UN);
+    if (!valid) {
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    void* mapping = mmap(NULL, expectedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor); // the mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappingSize = expectedSize;
+    _slots = (Slot*)((uint8_t*)mapping + sizeof(header));
+    _slotMask = ((uint64_t)1 << header.sizeLog2) - 1;
+    _probes = 0;
+    _hits = 0;
+    _stores = 0;
+    return true;
+}
+
+void PersistentSolutionCache::close() {
+    if (_mapping != NULL) {
+        // written slots reach the file even if this process is killed later, so only unmap
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = NULL;
+    _mappingSize = 0;
+    _slots = NULL;
+    _slotMask = 0;
+}
+
+PositionKey PersistentSolutionCache::_canonicalKey(const PositionKey& key) {
+    PositionKey result = key;
+    if (result.layoutFirst > result.layoutSecond) {
+        std::swap(result.layoutFirst, result.layoutSecond);
+    }
+    return result;
+}
+
+uint64_t PersistentSolutionCache::_packedWord(const PositionKey& key, const int value) {
+    return ((uint64_t)(uint8_t)key.layoutFirst) | ((uint64_t)(uint8_t)key.layoutSecond << 8) | ((uint64_t)(key.playerTurnIndex & 1) << 16) | ((uint64_t)key.previousPlayerPassed << 17) | ((uint64_t)(uint32_t)value << 32);
+}
+
+uint64_t PersistentSolutionCache::_checksum(const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t packed) {
+    uint64_t h = (maxPlayerTiles ^ kPersistentSolutionCacheVersion) * 0x9E3779B97F4A7C15ULL;
+    h ^= (minPlayerTiles + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2));
+    h ^= (packed + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2));
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    // never zero, which marks an empty slot
+    return h | 1;
+}
+
+bool PersistentSolutionCache::_readSlot(const Slot& slot, uint64_t& maxPlayerTiles, uint64_t& minPlayerTiles, uint64_t& packed) {
+    const uint64_t checksum = slot.checksum.load(std::memory_order_acquire);
+    if (checksum == 0) {
+        return false;
+    }
+    maxPlayerTiles = slot.maxPlayerTiles.load(std::memory_order_relaxed);
+    minPlayerTiles = slot.minPlayerTiles.load(std::memory_order_relaxed);
+    packed = slot.packed.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.checksum.load(std::memory_order_relaxed) == checksum && _checksum(maxPlayerTiles, minPlayerTiles, packed) == checksum;
+}
+
+bool PersistentSolutionCache::probe(const PositionKey& key, int& value) {
+    if (!isOpen()) {
+        return false;
+    }
+    _probes++;
+    const PositionKey canonicalKey = _canonicalKey(key);
+    const uint64_t packedKey = _packedWord(canonicalKey, 0);
+    const uint64_t homeIndex = canonicalKey.hashValue() & _slotMask;
+    for (int i = 0; i < kPersistentSolutionCacheProbeLength; i++) {
+        uint64_t maxPlayerTiles, minPlayerTiles, packed;
+        if (_readSlot(_slots[(homeIndex + i) & _slotMask], maxPlayerTiles, minPlayerTiles, packed) &&
+            maxPlayerTiles == canonicalKey.maxPlayerTiles && minPlayerTiles == canonicalKey.minPlayerTiles && (packed & kPackedKeyMask) == packedKey) {
+            value = (int)(int32_t)(uint32_t)(packed >> 32);
+            _hits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PersistentSolutionCache::store(const PositionKey& key, const int value) {
+    if (!isOpen()) {
+        return;
+    }
+    const PositionKey canonicalKey = _canonicalKey(key);
+    const uint64_t packed = _packedWord(canonicalKey, value);
+    const uint64_t homeIndex = canonicalKey.hashValue() & _slotMask;
+    const int tilesLeft = __builtin_popcountll(canonicalKey.maxPlayerTiles) + __builtin_popcountll(canonicalKey.minPlayerTiles);
+
+    // the same position, else an empty (or torn) slot, else the smallest position no larger than this one
+    int targetOffset = -1;
+    int targetPriority = 0;
+    int targetTilesLeft = tilesLeft + 1;
+    for (int i = 0; i < kPersistentSolutionCacheProbeLength; i++) {
+        uint64_t slotMaxPlayerTiles, slotMinPlayerTiles, slotPacked;
+        if (!_readSlot(_slots[(homeIndex + i) & _slotMask], slotMaxPlayerTiles, slotMinPlayerTiles, slotPacked)) {
+            if (targetPriority < 2) {
+                targetOffset = i;
+                targetPriority = 2;
+            }
+            continue;
+        }
+        if (slotMaxPlayerTiles == canonicalKey.maxPlayerTiles && slotMinPlayerTiles == canonicalKey.minPlayerTiles && (slotPacked & kPackedKeyMask) == (packed & kPackedKeyMask)) {
+            if (slotPacked == packed) {
+                // already there. rewriting it would only dirty the page
+                return;
+            }
+            targetOffset = i;
+            break;
+        }
+        const int slotTilesLeft = __builtin_popcountll(slotMaxPlayerTiles) + __builtin_popcountll(slotMinPlayerTiles);
+        if (targetPriority < 2 && slotTilesLeft < targetTilesLeft) {
+            targetOffset = i;
+            targetPriority = 1;
+            targetTilesLeft = slotTilesLeft;
+        }
+    }
+    if (targetOffset < 0) {
+        return;
+    }
+
+    Slot& slot = _slots[(homeIndex + targetOffset) & _slotMask];
+    slot.checksum.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.maxPlayerTiles.store(canonicalKey.maxPlayerTiles, std::memory_order_relaxed);
+    slot.minPlayerTiles.store(canonicalKey.minPlayerTiles, std::memory_order_relaxed);
+    slot.packed.store(packed, std::memory_order_relaxed);
+    slot.checksum.store(_checksum(canonicalKey.maxPlayerTiles, canonicalKey.minPlayerTiles, packed), std::memory_order_release);
+    _stores++;
+}
+
+long long PersistentSolutionCache::size() const {
+    long long result = 0;
+    for (uint64_t i = 0; isOpen() && i <= _slotMask; i++) {
+        uint64_t maxPlayerTiles, minPlayerTiles, packed;
+        if (_readSlot(_slots[i], maxPlayerTiles, minPlayerTiles, packed)) {
+            result++;
+        }
+    }
+    return result;
+}
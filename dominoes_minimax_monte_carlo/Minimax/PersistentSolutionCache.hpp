@@ -0,0 +1,98 @@
+//
+//  PersistentSolutionCache.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef PersistentSolutionCache_hpp
+#define PersistentSolutionCache_hpp
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "PositionKey.hpp"
+
+static const char kPersistentSolutionCacheMagic[8] = { 'D', 'O', 'M', 'S', 'O', 'L', 'V', '1' };
+static const uint32_t kPersistentSolutionCacheVersion = 1;
+static const int kDefaultPersistentSolutionCacheSizeLog2 = 22; // 4M slots, a 128 MB sparse file
+static const int kPersistentSolutionCacheProbeLength = 4; // slots searched from a key's home slot, two cache lines
+static const int kMinimumTilesForPersistentSolutionCache = 8; // smaller positions solve faster than a page fault
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "slots are shared between processes, so their atomics must not use locks");
+
+// file layout: header, then 2^sizeLog2 slots of four uint64 words: both hand masks, the packed rest of the key
+// with the value, and a checksum of the other three. a zero checksum is an empty slot.
+struct PersistentSolutionCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sizeLog2;
+    uint32_t handSize;
+    uint32_t maxDominoSuit;
+    uint32_t slotSize;
+    uint32_t reserved[9];
+};
+
+// exact position values kept in a memory-mapped file, so they survive restarts and are shared by every process
+// on the host that opens the same file. slots are read and written without locks: a writer clears the checksum,
+// writes the words and then the checksum, and a reader only accepts a slot whose checksum matches and did not
+// change while it read. a torn or interleaved slot, including one left by a crash, reads as a miss.
+// positions are keyed with their layout ends in ascending order, since swapping the ends mirrors every line of
+// play and leaves the value unchanged.
+class PersistentSolutionCache {
+private:
+    struct Slot {
+        std::atomic<uint64_t> maxPlayerTiles;
+        std::atomic<uint64_t> minPlayerTiles;
+        std::atomic<uint64_t> packed;
+        std::atomic<uint64_t> checksum;
+    };
+
+    void* _mapping;
+    size_t _mappingSize;
+    Slot* _slots;
+    uint64_t _slotMask;
+    std::atomic<long long> _probes;
+    std::atomic<long long> _hits;
+    std::atomic<long long> _stores;
+
+    PersistentSolutionCache(const PersistentSolutionCache&);
+    PersistentSolutionCache& operator=(const PersistentSolutionCache&);
+
+    static PositionKey _canonicalKey(const PositionKey& key);
+    static uint64_t _packedWord(const PositionKey& key, const int value);
+    static uint64_t _checksum(const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t packed);
+    // false if the slot is empty or was torn
+    static bool _readSlot(const Slot& slot, uint64_t& maxPlayerTiles, uint64_t& minPlayerTiles, uint64_t& packed);
+public:
+    PersistentSolutionCache() : _mapping(NULL), _mappingSize(0), _slots(NULL), _slotMask(0), _probes(0), _hits(0), _stores(0) {}
+    ~PersistentSolutionCache();
+
+    // opens path, creating it with 2^sizeLog2 slots if it does not exist. an existing file keeps its own size,
+    // but must have been made for the same game foundation.
+    bool open(const std::string& path, const GameFoundation& gameFoundation, const int sizeLog2 = kDefaultPersistentSolutionCacheSizeLog2);
+    void close();
+
+    bool probe(const PositionKey& key, int& value);
+    // keeps the position unless every slot it could go in holds a larger one
+    void store(const PositionKey& key, const int value);
+    // occupied slots, read from the file
+    long long size() const;
+
+    inline bool isOpen() const {
+        return _slots != NULL;
+    }
+    inline long long getProbes() const {
+        return _probes.load();
+    }
+    inline long long getHits() const {
+        return _hits.load();
+    }
+    inline long long getStores() const {
+        return _stores.load();
+    }
+    static bool headerMatches(const PersistentSolutionCacheHeader& header, const GameFoundation& gameFoundation);
+};
+
+#endif /* PersistentSolutionCache_hpp */
@@ -0,0 +1,59 @@
+//
+//  ProofNumberData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ProofNumberData_hpp
+#define ProofNumberData_hpp
+
+#include <string>
+#include <unordered_map>
+
+#include "PositionKey.hpp"
+
+static const int kProofNumberInfinity = 100000000;
+
+struct ProofNumbers {
+    ProofNumbers(int proof = 1, int disproof = 1) : proof(proof), disproof(disproof) {}
+
+    int proof; // nodes still needed to show the max player beats the threshold
+    int disproof; // nodes still needed to show the max player does not
+};
+
+typedef std::unordered_map<PositionKey, ProofNumbers, PositionKeyHash> ProofNumberTable;
+
+enum GameOutcome {
+    kGameOutcomeMaxPlayerWins,
+    kGameOutcomeDrawEquivalent, // minimax value of exactly 0
+    kGameOutcomeMinPlayerWins
+};
+
+// result of proving whether minimaxValue > threshold
+struct ProofNumberData {
+    ProofNumberData(int threshold = 0, int infinity = 0) : threshold(threshold), infinity(infinity), nodesVisited(0), proven(false) {}
+
+    int threshold;
+    int infinity; // gameFoundation.infinity, for the open side of the bounds
+    int nodesVisited;
+    bool proven; // true if minimaxValue > threshold, false if minimaxValue <= threshold
+    ProofNumberTable table;
+
+    // alpha-beta window that contains the minimax value, for seeding an exact search
+    inline int getLowerBound() const {
+        return proven ? threshold : -1 * infinity;
+    }
+    inline int getUpperBound() const {
+        return proven ? infinity : threshold + 1;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Nodes Visited: " + std::to_string(nodesVisited) + "\n";
+        result += "Threshold: " + std::to_string(threshold) + "\n";
+        result += "Minimax Value " + std::string(proven ? "> " : "<= ") + std::to_string(threshold) + "\n";
+        return result;
+    }
+};
+
+#endif /* ProofNumberData_hpp */
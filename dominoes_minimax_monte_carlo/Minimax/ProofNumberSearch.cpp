@@ -0,0 +1,139 @@
+//
+//  ProofNumberSearch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "ProofNumberSearch.hpp"
+
+static inline int saturatingSum(const int a, const int b) {
+    return std::min(kProofNumberInfinity, a + b);
+}
+
+ProofNumbers ProofNumberSearch::_lookup(ProofNumberData& data, const GameState& gameState, const PositionKey& positionKey) {
+    const int score = gameState.getScore();
+    if (score != gameState.game.gameFoundation.infinity) {
+        return score > data.threshold ? ProofNumbers(0, kProofNumberInfinity) : ProofNumbers(kProofNumberInfinity, 0);
+    }
+    const auto found = data.table.find(positionKey);
+    return found == data.table.end() ? ProofNumbers() : found->second;
+}
+
+void ProofNumberSearch::_multipleIterativeDeepening(ProofNumberData& data, GameState& gameState, const int proofThreshold, const int disproofThreshold) {
+    data.nodesVisited += 1;
+
+    const PositionKey positionKey = gameState.positionKey();
+    const ProofNumbers stored = _lookup(data, gameState, positionKey);
+    if (stored.proof >= proofThreshold || stored.disproof >= disproofThreshold || stored.proof == 0 || stored.disproof == 0) {
+        return;
+    }
+
+    gameState.expandAndGenerateChildren();
+
+    const int numberOfChildren = (int)gameState.children.size();
+    const bool isOrNode = gameState.isMaxPlayer();
+    std::vector<PositionKey> childKeys;
+    for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
+        childKeys.push_back(gameState.children[childIndex].positionKey());
+    }
+
+    while (true) {
+        // OR nodes need one proven child and every child disproven, AND nodes the reverse
+        int proof = isOrNode ? kProofNumberInfinity : 0;
+        int disproof = isOrNode ? 0 : kProofNumberInfinity;
+        int bestChildIndex = -1;
+        int bestChildNumber = kProofNumberInfinity;
+        int secondBestChildNumber = kProofNumberInfinity;
+        ProofNumbers bestChildNumbers;
+        for (int childIndex = 0; childIndex < numberOfChildren; childIndex++) {
+            const ProofNumbers childNumbers = _lookup(data, gameState.children[childIndex], childKeys[childIndex]);
+            const int selectionNumber = isOrNode ? childNumbers.proof : childNumbers.disproof;
+            if (isOrNode) {
+                proof = std::min(proof, childNumbers.proof);
+                disproof = saturatingSum(disproof, childNumbers.disproof);
+            } else {
+                proof = saturatingSum(proof, childNumbers.proof);
+                disproof = std::min(disproof, childNumbers.disproof);
+            }
+            if (selectionNumber < bestChildNumber) {
+                secondBestChildNumber = bestChildNumber;
+                bestChildNumber = selectionNumber;
+                bestChildIndex = childIndex;
+                bestChildNumbers = childNumbers;
+            } else if (selectionNumber < secondBestChildNumber) {
+                secondBestChildNumber = selectionNumber;
+            }
+        }
+
+        data.table[positionKey] = ProofNumbers(proof, disproof);
+
+        if (proof >= proofThreshold || disproof >= disproofThreshold) {
+            break;
+        }
+
+        int childProofThreshold;
+        int childDisproofThreshold;
+        if (isOrNode) {
+            childProofThreshold = std::min(proofThreshold, saturatingSum(secondBestChildNumber, 1));
+            childDisproofThreshold = std::min(kProofNumberInfinity, disproofThreshold - disproof + bestChildNumbers.disproof);
+        } else {
+            childProofThreshold = std::min(kProofNumberInfinity, proofThreshold - proof + bestChildNumbers.proof);
+            childDisproofThreshold = std::min(disproofThreshold, saturatingSum(secondBestChildNumber, 1));
+        }
+        _multipleIterativeDeepening(data, gameState.children[bestChildIndex], childProofThreshold, childDisproofThreshold);
+    }
+
+    // proof numbers live in the table, so the subtree can be released
+    gameState.children.clear();
+}
+
+ProofNumberData ProofNumberSearch::runOnState(GameState& gameState, const int threshold) {
+    ProofNumberData result(threshold, gameState.game.gameFoundation.infinity);
+    _multipleIterativeDeepening(result, gameState, kProofNumberInfinity, kProofNumberInfinity);
+    const ProofNumbers rootNumbers = _lookup(result, gameState, gameState.positionKey());
+    assert(rootNumbers.proof == 0 || rootNumbers.disproof == 0);
+    result.proven = rootNumbers.proof == 0;
+    return result;
+}
+
+GameOutcome ProofNumberSearch::outcomeForState(GameState& gameState, int& nodesVisited) {
+    const ProofNumberData winData = runOnState(gameState, 0);
+    nodesVisited += winData.nodesVisited;
+    if (winData.proven) {
+        return kGameOutcomeMaxPlayerWins;
+    }
+    const ProofNumberData drawData = runOnState(gameState, -1);
+    nodesVisited += drawData.nodesVisited;
+    return drawData.proven ? kGameOutcomeDrawEquivalent : kGameOutcomeMinPlayerWins;
+}
+
+void ProofNumberSearch::winningChildIndices(GameState& gameState, IntVector& winningChildIndices, int& nodesVisited) {
+    // max wins when minimaxValue > 0, min wins when minimaxValue <= -1
+    const bool isMaxPlayer = gameState.isMaxPlayer();
+    ProofNumberData data = runOnState(gameState, isMaxPlayer ? 0 : -1);
+
+    winningChildIndices.clear();
+    gameState.children.clear();
+    gameState.expandAndGenerateChildren();
+    if (data.proven != isMaxPlayer) {
+        nodesVisited += data.nodesVisited;
+        return;
+    }
+    // the root proof stops at the first winning child. the rest are proven in the same table, which already
+    // holds most of what they need.
+    for (int childIndex = 0; childIndex < gameState.children.size(); childIndex++) {
+        GameState& child = gameState.children[childIndex];
+        const PositionKey childKey = child.positionKey();
+        ProofNumbers childNumbers = _lookup(data, child, childKey);
+        if (childNumbers.proof != 0 && childNumbers.disproof != 0) {
+            _multipleIterativeDeepening(data, child, kProofNumberInfinity, kProofNumberInfinity);
+            childNumbers = _lookup(data, child, childKey);
+        }
+        assert(childNumbers.proof == 0 || childNumbers.disproof == 0);
+        if ((isMaxPlayer && childNumbers.proof == 0) || (!isMaxPlayer && childNumbers.disproof == 0)) {
+            winningChildIndices.push_back(childIndex);
+        }
+    }
+    assert(!winningChildIndices.empty());
+    nodesVisited += data.nodesVisited;
+}
@@ -0,0 +1,26 @@
+//
+//  ProofNumberSearch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ProofNumberSearch_hpp
+#define ProofNumberSearch_hpp
+
+#include "GameState.hpp"
+#include "ProofNumberData.hpp"
+
+// depth-first proof-number search (df-pn). proves or disproves minimaxValue > threshold, which
+// usually needs far fewer nodes than computing the exact value. max player nodes are OR nodes.
+class ProofNumberSearch {
+private:
+    static ProofNumbers _lookup(ProofNumberData& data, const GameState& gameState, const PositionKey& positionKey);
+    static void _multipleIterativeDeepening(ProofNumberData& data, GameState& gameState, const int proofThreshold, const int disproofThreshold);
+public:
+    static ProofNumberData runOnState(GameState& gameState, const int threshold = 0);
+    static GameOutcome outcomeForState(GameState& gameState, int& nodesVisited);
+    // expands gameState and fills winningChildIndices with every child that wins for the player to move
+    static void winningChildIndices(GameState& gameState, IntVector& winningChildIndices, int& nodesVisited);
+};
+
+#endif /* ProofNumberSearch_hpp */
@@ -0,0 +1,118 @@
+//
+//  ResumableAlphaBetaSearch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "ResumableAlphaBetaSearch.hpp"
+
+ResumableAlphaBetaSearch::ResumableAlphaBetaSearch(GameState& gameState, const bool recordPath, SolutionStore* solutionStore) : ResumableAlphaBetaSearch(gameState, recordPath, gameState.game.gameFoundation.negativeInfinity, gameState.game.gameFoundation.infinity, solutionStore) {}
+
+ResumableAlphaBetaSearch::ResumableAlphaBetaSearch(GameState& gameState, const bool recordPath, const int alpha, const int beta, SolutionStore* solutionStore) : _root(gameState), _recordPath(recordPath), _solutionStore(solutionStore), _result(NULL, 0), _finished(false) {
+    MinimaxResult rootResult(NULL, 0);
+    if (_enterNode(gameState, gameState.game.gameFoundation.maxDepth, MinimaxResult(NULL, alpha), MinimaxResult(NULL, beta), rootResult)) {
+        _finish(rootResult);
+    }
+}
+
+// the part of _alphaBetaMinimaxSearch before the child loop. returns true with result when the node is answered
+// without children, otherwise pushes a frame for it.
+bool ResumableAlphaBetaSearch::_enterNode(GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, MinimaxResult& result) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    const int score = gameState.getScore();
+
+    _data.nodesVisited += 1;
+
+    if (depth == 0 || score != gameFoundation.infinity) {
+        gameState.minimaxValue = score;
+        result = MinimaxResult(&gameState, score);
+        return true;
+    }
+
+    const bool useStore = _solutionStore != NULL && depth != gameFoundation.maxDepth && (int)(gameState.maxPlayerHand.size() + gameState.minPlayerHand.size()) >= kMinimumTilesForSolutionStore;
+    PositionKey positionKey;
+    if (useStore) {
+        positionKey = gameState.positionKey();
+        SolutionEntry entry;
+        if (_solutionStore->probe(positionKey, entry)) {
+            if (entry.bound == kSolutionBoundExact ||
+                (entry.bound == kSolutionBoundLower && entry.value >= beta.score) ||
+                (entry.bound == kSolutionBoundUpper && entry.value <= alpha.score)) {
+                gameState.minimaxValue = entry.value;
+                result = MinimaxResult(&gameState, entry.value);
+                return true;
+            }
+        }
+    }
+
+    gameState.expandAndGenerateChildren();
+    _frames.push_back(Frame(&gameState, depth, alpha, beta, useStore, positionKey));
+    return false;
+}
+
+void ResumableAlphaBetaSearch::_foldChildResult(Frame& frame, const MinimaxResult& childResult) {
+    const int numberOfChildren = (int)frame.node->children.size();
+    if (frame.node->isMaxPlayer()) {
+        if (childResult.score > frame.best.score) {
+            frame.best = childResult;
+        }
+        frame.node->minimaxValue = frame.best.score;
+        frame.childIndex = frame.beta.score <= frame.best.score ? numberOfChildren : frame.childIndex + 1;
+    } else {
+        if (childResult.score < frame.best.score) {
+            frame.best = childResult;
+        }
+        frame.node->minimaxValue = frame.best.score;
+        frame.childIndex = frame.best.score <= frame.alpha.score ? numberOfChildren : frame.childIndex + 1;
+    }
+}
+
+void ResumableAlphaBetaSearch::_finish(const MinimaxResult& result) {
+    _result = result;
+    _finished = true;
+
+    if (_recordPath) {
+        GameState *node = result.node;
+        while (node != NULL) {
+            GameState nodeRemovingChildren = GameState::stateRemovingChildren(*node);
+            _data.path.push_back(nodeRemovingChildren);
+            node = node->parent;
+        }
+    }
+
+    assert(result.node == NULL || result.score == result.node->minimaxValue);
+    _data.minimaxValue = result.score;
+}
+
+bool ResumableAlphaBetaSearch::resume(const int maxNodes) {
+    const int nodeLimit = _data.nodesVisited + maxNodes;
+    while (!_finished && _data.nodesVisited < nodeLimit) {
+        Frame& frame = _frames.back();
+
+        if (frame.childIndex < frame.node->children.size()) {
+            GameState& child = frame.node->children[frame.childIndex];
+            const bool isMaxPlayer = frame.node->isMaxPlayer();
+            const MinimaxResult childAlpha = isMaxPlayer ? frame.best : frame.alpha;
+            const MinimaxResult childBeta = isMaxPlayer ? frame.beta : frame.best;
+            MinimaxResult childResult(NULL, 0);
+            // a pushed frame may move the stack, so fold through back() rather than frame
+            if (_enterNode(child, frame.depth - 1, childAlpha, childBeta, childResult)) {
+                _foldChildResult(_frames.back(), childResult);
+            }
+            continue;
+        }
+
+        // every child searched or cut off
+        if (frame.useStore) {
+            _solutionStore->store(frame.positionKey, SolutionEntry::entryForWindow(frame.best.score, frame.alpha.score, frame.beta.score));
+        }
+        const MinimaxResult result = frame.best;
+        _frames.pop_back();
+        if (_frames.empty()) {
+            _finish(result);
+        } else {
+            _foldChildResult(_frames.back(), result);
+        }
+    }
+    return _finished;
+}
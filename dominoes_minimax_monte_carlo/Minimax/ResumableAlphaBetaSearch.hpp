@@ -0,0 +1,68 @@
+//
+//  ResumableAlphaBetaSearch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ResumableAlphaBetaSearch_hpp
+#define ResumableAlphaBetaSearch_hpp
+
+#include <vector>
+
+#include "GameState.hpp"
+#include "MinimaxData.hpp"
+#include "MinimaxSearch.hpp"
+#include "SolutionStore.hpp"
+
+// the same search as AlphaBetaMinimaxSearch, with the recursion kept on an explicit frame stack so it can stop
+// after a node budget and pick up where it left off. one thread can then interleave several searches or give up
+// at a deadline. the searched tree stays in gameState, which must outlive the search and not be touched meanwhile.
+class ResumableAlphaBetaSearch {
+private:
+    struct Frame {
+        Frame(GameState* node, const int depth, const MinimaxResult alpha, const MinimaxResult beta, const bool useStore, const PositionKey& positionKey) : node(node), depth(depth), alpha(alpha), beta(beta), best(node->isMaxPlayer() ? alpha : beta), childIndex(0), useStore(useStore), positionKey(positionKey) {}
+
+        GameState* node;
+        int depth;
+        MinimaxResult alpha;
+        MinimaxResult beta;
+        MinimaxResult best; // alpha for the max player, beta for the min player
+        int childIndex; // next child to search
+        bool useStore;
+        PositionKey positionKey;
+    };
+
+    GameState& _root;
+    const bool _recordPath;
+    SolutionStore* _solutionStore;
+    std::vector<Frame> _frames;
+    MinimaxData _data;
+    MinimaxResult _result;
+    bool _finished;
+
+    bool _enterNode(GameState& gameState, const int depth, const MinimaxResult alpha, const MinimaxResult beta, MinimaxResult& result);
+    void _foldChildResult(Frame& frame, const MinimaxResult& childResult);
+    void _finish(const MinimaxResult& result);
+public:
+    ResumableAlphaBetaSearch(GameState& gameState, const bool recordPath, SolutionStore* solutionStore = NULL);
+    ResumableAlphaBetaSearch(GameState& gameState, const bool recordPath, const int alpha, const int beta, SolutionStore* solutionStore = NULL);
+
+    // searches at most maxNodes more nodes. returns true once the search is finished
+    bool resume(const int maxNodes);
+
+    inline bool isFinished() const {
+        return _finished;
+    }
+
+    // nodes visited so far. minimaxValue and path are only set once finished
+    inline const MinimaxData& getData() const {
+        return _data;
+    }
+
+    // frames on the stack, i.e. how deep the suspended search is
+    inline int getDepth() const {
+        return (int)_frames.size();
+    }
+};
+
+#endif /* ResumableAlphaBetaSearch_hpp */
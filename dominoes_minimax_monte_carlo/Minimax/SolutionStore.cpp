@@ -0,0 +1,84 @@
+//
+//  SolutionStore.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "SolutionStore.hpp"
+
+SolutionStore::SolutionStore(const int sizeLog2, PersistentSolutionCache* persistentCache) : _slots((size_t)1 << sizeLog2), _probes(0), _hits(0), _persistentHits(0), _persistentCache(persistentCache) {
+    _slotMask = ((uint64_t)1 << sizeLog2) - 1;
+}
+
+bool SolutionStore::probe(const PositionKey& key, SolutionEntry& entry) {
+    _probes++;
+    const uint64_t slotIndex = _slotIndexForKey(key);
+    {
+        std::lock_guard<std::mutex> lock(_lockForSlotIndex(slotIndex));
+        const Slot& slot = _slots[slotIndex];
+        if (slot.occupied && slot.key == key) {
+            _hits++;
+            entry = slot.entry;
+            return true;
+        }
+    }
+    // the file is read outside the lock, since a probe there can wait on a page fault
+    int value = 0;
+    if (_persistentCache == NULL || !_isPersistentKey(key) || !_persistentCache->probe(key, value)) {
+        return false;
+    }
+    _hits++;
+    _persistentHits++;
+    entry = SolutionEntry(value, kSolutionBoundExact);
+    // keep it here too, so the next probe does not go to the file
+    std::lock_guard<std::mutex> lock(_lockForSlotIndex(slotIndex));
+    Slot& slot = _slots[slotIndex];
+    slot.key = key;
+    slot.entry = entry;
+    slot.occupied = true;
+    return true;
+}
+
+void SolutionStore::store(const PositionKey& key, const SolutionEntry& entry) {
+    const uint64_t slotIndex = _slotIndexForKey(key);
+    {
+        std::lock_guard<std::mutex> lock(_lockForSlotIndex(slotIndex));
+        Slot& slot = _slots[slotIndex];
+        // a bound never overwrites an exact value for the same position
+        if (slot.occupied && slot.key == key && slot.entry.bound == kSolutionBoundExact && entry.bound != kSolutionBoundExact) {
+            return;
+        }
+        slot.key = key;
+        slot.entry = entry;
+        slot.occupied = true;
+    }
+    if (_persistentCache != NULL && entry.bound == kSolutionBoundExact && _isPersistentKey(key)) {
+        _persistentCache->store(key, entry.value);
+    }
+}
+
+void SolutionStore::clear() {
+    for (int i = 0; i < kNumberOfLocks; i++) {
+        _locks[i].lock();
+    }
+    for (int i = 0; i < _slots.size(); i++) {
+        _slots[i].occupied = false;
+    }
+    for (int i = 0; i < kNumberOfLocks; i++) {
+        _locks[i].unlock();
+    }
+    _probes = 0;
+    _hits = 0;
+    _persistentHits = 0;
+}
+
+long long SolutionStore::size() {
+    long long result = 0;
+    for (int i = 0; i < _slots.size(); i++) {
+        std::lock_guard<std::mutex> lock(_lockForSlotIndex(i));
+        if (_slots[i].occupied) {
+            result++;
+        }
+    }
+    return result;
+}
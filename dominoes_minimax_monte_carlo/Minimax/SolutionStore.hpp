@@ -0,0 +1,96 @@
+//
+//  SolutionStore.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SolutionStore_hpp
+#define SolutionStore_hpp
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "PersistentSolutionCache.hpp"
+#include "PositionKey.hpp"
+
+static const int kDefaultSolutionStoreSizeLog2 = 18;
+
+enum SolutionBound {
+    kSolutionBoundExact,
+    kSolutionBoundLower, // value is at least the stored value
+    kSolutionBoundUpper  // value is at most the stored value
+};
+
+struct SolutionEntry {
+    SolutionEntry(int value = 0, SolutionBound bound = kSolutionBoundExact) : value(value), bound(bound) {}
+
+    int value;
+    SolutionBound bound;
+
+    // the entry for a fail-hard search result over the window (alpha, beta)
+    static inline SolutionEntry entryForWindow(const int score, const int alpha, const int beta) {
+        SolutionBound bound = kSolutionBoundExact;
+        if (score <= alpha) {
+            bound = kSolutionBoundUpper;
+        } else if (score >= beta) {
+            bound = kSolutionBoundLower;
+        }
+        return SolutionEntry(score, bound);
+    }
+};
+
+// thread-safe position -> solved value table. shared by all sampling threads and kept across
+// the moves of one game so each search starts with what earlier searches already proved.
+// fixed size and direct mapped, so a colliding position replaces the older one.
+// with a persistent cache, positions missing here are looked up in it and exact values are written through to it.
+class SolutionStore {
+private:
+    static const int kNumberOfLocks = 64;
+
+    struct Slot {
+        Slot() : occupied(false) {}
+
+        PositionKey key;
+        SolutionEntry entry;
+        bool occupied;
+    };
+
+    std::vector<Slot> _slots;
+    uint64_t _slotMask;
+    std::mutex _locks[kNumberOfLocks];
+    std::atomic<long long> _probes;
+    std::atomic<long long> _hits;
+    std::atomic<long long> _persistentHits;
+    PersistentSolutionCache* _persistentCache;
+
+    inline uint64_t _slotIndexForKey(const PositionKey& key) const {
+        return key.hashValue() & _slotMask;
+    }
+    static inline bool _isPersistentKey(const PositionKey& key) {
+        return __builtin_popcountll(key.maxPlayerTiles) + __builtin_popcountll(key.minPlayerTiles) >= kMinimumTilesForPersistentSolutionCache;
+    }
+    inline std::mutex& _lockForSlotIndex(const uint64_t slotIndex) {
+        return _locks[slotIndex % kNumberOfLocks];
+    }
+public:
+    SolutionStore(const int sizeLog2 = kDefaultSolutionStoreSizeLog2, PersistentSolutionCache* persistentCache = NULL);
+
+    bool probe(const PositionKey& key, SolutionEntry& entry);
+    void store(const PositionKey& key, const SolutionEntry& entry);
+    void clear();
+    long long size();
+
+    inline long long getProbes() const {
+        return _probes.load();
+    }
+    inline long long getHits() const {
+        return _hits.load();
+    }
+    // the hits answered by the persistent cache, which getHits includes
+    inline long long getPersistentHits() const {
+        return _persistentHits.load();
+    }
+};
+
+#endif /* SolutionStore_hpp */
@@ -0,0 +1,76 @@
+//
+//  StaticEvaluator.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "StaticEvaluator.hpp"
+
+int StaticEvaluator::_suitCount(const DominoPointerVector& hand, const int suit) {
+    int result = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        if (hand[i]->hasSuit(suit)) {
+            result++;
+        }
+    }
+    return result;
+}
+
+int StaticEvaluator::_doubleCount(const DominoPointerVector& hand) {
+    int result = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        if (hand[i]->ends.first == hand[i]->ends.second) {
+            result++;
+        }
+    }
+    return result;
+}
+
+int StaticEvaluator::_playableCount(const DominoPointerVector& hand, const IntPair& layoutEnds) {
+    // an empty layout takes any tile
+    if (layoutEnds.first < 0) {
+        return (int)hand.size();
+    }
+    int result = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        if (hand[i]->hasSuit(layoutEnds.first) || hand[i]->hasSuit(layoutEnds.second)) {
+            result++;
+        }
+    }
+    return result;
+}
+
+int StaticEvaluator::evaluate(const GameState& gameState, const StaticEvaluatorWeights& weights) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    const DominoPointerVector& maxHand = gameState.maxPlayerHand;
+    const DominoPointerVector& minHand = gameState.minPlayerHand;
+
+    int maxPips = 0;
+    for (int i = 0; i < maxHand.size(); i++) {
+        maxPips += maxHand[i]->getTileTotal();
+    }
+    int minPips = 0;
+    for (int i = 0; i < minHand.size(); i++) {
+        minPips += minHand[i]->getTileTotal();
+    }
+
+    int suitControl = 0;
+    for (int suit = 0; suit <= gameFoundation.maxDominoSuit; suit++) {
+        const int maxSuitCount = _suitCount(maxHand, suit);
+        const int minSuitCount = _suitCount(minHand, suit);
+        if (maxSuitCount > minSuitCount) {
+            suitControl++;
+        } else if (minSuitCount > maxSuitCount) {
+            suitControl--;
+        }
+    }
+
+    double estimate = weights.pipWeight * (minPips - maxPips);
+    estimate += weights.tileWeight * ((int)minHand.size() - (int)maxHand.size());
+    estimate += weights.suitControlWeight * suitControl;
+    estimate += weights.doubleWeight * (_doubleCount(minHand) - _doubleCount(maxHand));
+    estimate += weights.playableWeight * (_playableCount(maxHand, gameState.layoutEnds) - _playableCount(minHand, gameState.layoutEnds));
+
+    const int bound = gameFoundation.totalPoints - 1;
+    return std::max(-bound, std::min(bound, (int)std::lround(estimate)));
+}
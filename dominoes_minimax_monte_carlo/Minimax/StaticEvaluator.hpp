@@ -0,0 +1,35 @@
+//
+//  StaticEvaluator.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef StaticEvaluator_hpp
+#define StaticEvaluator_hpp
+
+#include "GameState.hpp"
+
+// weights are in points per unit of each feature, each feature taken as max player minus min player
+// with its sign chosen so a positive difference favors max
+struct StaticEvaluatorWeights {
+    StaticEvaluatorWeights(double pipWeight = 1.0, double tileWeight = 4.0, double suitControlWeight = 2.0, double doubleWeight = 3.0, double playableWeight = 2.0) : pipWeight(pipWeight), tileWeight(tileWeight), suitControlWeight(suitControlWeight), doubleWeight(doubleWeight), playableWeight(playableWeight) {}
+
+    double pipWeight; // fewer pips in hand
+    double tileWeight; // fewer tiles in hand, i.e. closer to dominoing
+    double suitControlWeight; // suits held with more tiles than the opponent holds
+    double doubleWeight; // fewer doubles, which only ever fit one suit
+    double playableWeight; // more tiles that fit an end of the layout
+};
+
+// estimates the minimax value of an internal node, for depth-limited searches. the estimate is
+// kept inside (-totalPoints, totalPoints) so it can never be mistaken for a proven result.
+class StaticEvaluator {
+private:
+    static int _suitCount(const DominoPointerVector& hand, const int suit);
+    static int _doubleCount(const DominoPointerVector& hand);
+    static int _playableCount(const DominoPointerVector& hand, const IntPair& layoutEnds);
+public:
+    static int evaluate(const GameState& gameState, const StaticEvaluatorWeights& weights);
+};
+
+#endif /* StaticEvaluator_hpp */
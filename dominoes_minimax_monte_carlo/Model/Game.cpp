@@ -17,6 +17,29 @@ Game Game::gameWithStartingMaxPayerHandNumber(const GameFoundation &gameFoundati
     return Game(gameFoundation, maxPlayerHandNumber);
 }
 
+Game Game::gameWithHands(const GameFoundation& gameFoundation, const IntVector& maxPlayerTileIndices, const IntVector& minPlayerTileIndices) {
+    return Game(gameFoundation, maxPlayerTileIndices, minPlayerTileIndices);
+}
+
+Game Game::gameForSeed(const GameFoundation& gameFoundation, const unsigned int seed) {
+    // mt19937 and a hand-rolled shuffle are the same on every standard library, unlike std::shuffle
+    std::mt19937 engine(seed);
+    IntVector tileIndices;
+    for (int i = 0; i < gameFoundation.numberOfDominoes; i++) {
+        tileIndices.push_back(i);
+    }
+    for (int i = (int)tileIndices.size() - 1; i > 0; i--) {
+        std::swap(tileIndices[i], tileIndices[engine() % (uint32_t)(i + 1)]);
+    }
+    const IntVector maxPlayerTileIndices(tileIndices.begin(), tileIndices.begin() + gameFoundation.handSize);
+    const IntVector minPlayerTileIndices(tileIndices.begin() + gameFoundation.handSize, tileIndices.begin() + (2 * gameFoundation.handSize));
+    return Game(gameFoundation, maxPlayerTileIndices, minPlayerTileIndices);
+}
+
+Game Game::gameForPosition(const GameFoundation& gameFoundation, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t playedTiles) {
+    return Game(gameFoundation, maxPlayerTiles, minPlayerTiles, playedTiles);
+}
+
 Game::Game(const GameFoundation& gameFoundation) : gameFoundation(gameFoundation) {
     const DominoVector& dominoSet = gameFoundation.dominoSet;
     const int numberOfDominoes = gameFoundation.numberOfDominoes;
@@ -38,9 +61,9 @@ Game::Game(const GameFoundation& gameFoundation, const int maxPlayerHandNumber)
     const int numberOfDominoes = gameFoundation.numberOfDominoes;
     const int handSize = gameFoundation.handSize;
 
-    const IntVectorVector indexCombos = CombinationListCreator().listOfCombinationIndices(gameFoundation.numberOfDominoes, gameFoundation.handSize);
-    const int handIndex = std::max(0, std::min(maxPlayerHandNumber, (int)indexCombos.size()));
-    const IntVector& maxPlayerIndexList = indexCombos[handIndex];
+    const int numberOfHands = CombinationListCreator::numberOfCombinations(numberOfDominoes, handSize);
+    const int handIndex = std::max(0, std::min(maxPlayerHandNumber, numberOfHands - 1));
+    const IntVector maxPlayerIndexList = CombinationListCreator::combinationForIndex(numberOfDominoes, handSize, handIndex);
 
     IntVector dominoIndexList = maxPlayerIndexList;
     for (int i = 0; i < numberOfDominoes; i++) {
@@ -61,6 +84,40 @@ Game::Game(const GameFoundation& gameFoundation, const int maxPlayerHandNumber)
     _assignHands(handSize, numberOfDominoes, dominoes);
 }
 
+Game::Game(const GameFoundation& gameFoundation, const IntVector& maxPlayerTileIndices, const IntVector& minPlayerTileIndices) : gameFoundation(gameFoundation) {
+    const DominoVector& dominoSet = gameFoundation.dominoSet;
+    const int numberOfDominoes = gameFoundation.numberOfDominoes;
+    const int handSize = gameFoundation.handSize;
+    assert(maxPlayerTileIndices.size() == handSize && minPlayerTileIndices.size() == handSize);
+
+    // max hand, min hand, then the remaining tiles in set order
+    IntVector dominoIndexList = maxPlayerTileIndices;
+    dominoIndexList.insert(dominoIndexList.end(), minPlayerTileIndices.begin(), minPlayerTileIndices.end());
+    for (int i = 0; i < numberOfDominoes; i++) {
+        if (std::find(dominoIndexList.begin(), dominoIndexList.end(), i) == dominoIndexList.end()) {
+            dominoIndexList.push_back(i);
+        }
+    }
+    assert(dominoIndexList.size() == dominoSet.size());
+
+    DominoPointerVector dominoes;
+    for (int i = 0; i < dominoIndexList.size(); i++) {
+        dominoes.push_back(&dominoSet[dominoIndexList[i]]);
+    }
+
+    _assignHands(handSize, numberOfDominoes, dominoes);
+}
+
+Game::Game(const GameFoundation& gameFoundation, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t playedTiles) : gameFoundation(gameFoundation) {
+    assert((maxPlayerTiles & minPlayerTiles) == 0 && ((maxPlayerTiles | minPlayerTiles) & playedTiles) == 0);
+    maxPlayerHand = gameFoundation.tilesForMask(maxPlayerTiles);
+    minPlayerHand = gameFoundation.tilesForMask(minPlayerTiles);
+
+    const uint64_t allTiles = gameFoundation.numberOfDominoes == 64 ? ~0ULL : (1ULL << gameFoundation.numberOfDominoes) - 1;
+    possibleMaxPlayerTiles = allTiles & ~(minPlayerTiles | playedTiles);
+    possibleMinPlayerTiles = allTiles & ~(maxPlayerTiles | playedTiles);
+}
+
 void Game::_assignHands(const int handSize, const int numberOfDominoes, DominoPointerVector& dominoes) {
     // assign hands
     for (int i = 0; i < handSize; i++) {
@@ -71,12 +128,14 @@ void Game::_assignHands(const int handSize, const int numberOfDominoes, DominoPo
     }
 
     // set initial possible tiles for each player
+    possibleMaxPlayerTiles = 0;
+    possibleMinPlayerTiles = 0;
     for (int i = 0; i < numberOfDominoes; i++) {
         if (i >= handSize) {
-            possibleMinPlayerTiles.push_back(dominoes[i]);
+            possibleMinPlayerTiles |= gameFoundation.tileMaskForDomino(dominoes[i]);
         }
         if (i < handSize || i >= handSize * 2) {
-            possibleMaxPlayerTiles.push_back(dominoes[i]);
+            possibleMaxPlayerTiles |= gameFoundation.tileMaskForDomino(dominoes[i]);
         }
     }
 }
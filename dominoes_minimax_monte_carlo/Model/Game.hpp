@@ -16,17 +16,27 @@ class Game {
 private:
     Game(const GameFoundation& gameFoundation); // makes random game
     Game(const GameFoundation& gameFoundation, const int maxPlayerHandNumber); // makes random game with specified max hand
+    Game(const GameFoundation& gameFoundation, const std::vector<int>& maxPlayerTileIndices, const std::vector<int>& minPlayerTileIndices); // makes game with both hands specified
+    Game(const GameFoundation& gameFoundation, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t playedTiles); // makes game part way through
 
     void _assignHands(const int handSize, const int numberOfDominoes, DominoPointerVector& dominoes);
 public:
     static Game randomGame(const GameFoundation& gameFoundation);
     static Game gameWithStartingMaxPayerHandNumber(const GameFoundation& gameFoundation, const int maxPlayerHandNumber);
+    // hands as indices into gameFoundation.dominoSet
+    static Game gameWithHands(const GameFoundation& gameFoundation, const std::vector<int>& maxPlayerTileIndices, const std::vector<int>& minPlayerTileIndices);
+    // the same deal for a seed on every platform, so a reported seed reproduces anywhere
+    static Game gameForSeed(const GameFoundation& gameFoundation, const unsigned int seed);
+    // the hands left part way through a game, as masks with a bit per dominoSet index. each player may hold
+    // any tile that is neither played nor in the player's own hand, since the history is not known.
+    static Game gameForPosition(const GameFoundation& gameFoundation, const uint64_t maxPlayerTiles, const uint64_t minPlayerTiles, const uint64_t playedTiles);
 
     const GameFoundation& gameFoundation;
     DominoPointerVector maxPlayerHand;
     DominoPointerVector minPlayerHand;
-    DominoPointerVector possibleMaxPlayerTiles;
-    DominoPointerVector possibleMinPlayerTiles;
+    // tiles each player may still hold as seen by the other, bit per dominoSet index
+    uint64_t possibleMaxPlayerTiles;
+    uint64_t possibleMinPlayerTiles;
 };
 
 #endif /* Game_hpp */
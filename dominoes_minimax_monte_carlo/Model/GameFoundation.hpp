@@ -7,6 +7,7 @@
 #ifndef GameFoundation_hpp
 #define GameFoundation_hpp
 
+#include <stdint.h>
 #include <vector>
 
 #include "Domino.hpp"
@@ -34,6 +35,15 @@ struct GameFoundation {
                 assert(CantorPairing::pairForValue(dominoSet.back().pairingValue()) == dominoSet.back().ends);
             }
         }
+        for (int suit = 0; suit <= maxDominoSuit; suit++) {
+            uint64_t mask = 0;
+            for (int i = 0; i < dominoSet.size(); i++) {
+                if (dominoSet[i].hasSuit(suit)) {
+                    mask |= (1ULL << i);
+                }
+            }
+            suitTileMasks.push_back(mask);
+        }
         infinity = totalPoints + 1;
         negativeInfinity = -1 * infinity;
         maxDepth = handSize + (2 * (handSize - 1)) + (handSize - 2);
@@ -49,6 +59,32 @@ struct GameFoundation {
     int negativeInfinity;
     int maxDepth;
     DominoVector dominoSet;
+    std::vector<uint64_t> suitTileMasks; // bit per dominoSet index of the tiles with each suit
+
+    inline int indexForDomino(Domino const* domino) const {
+        return (int)(domino - &dominoSet[0]);
+    }
+    inline uint64_t tileMaskForDomino(Domino const* domino) const {
+        return 1ULL << indexForDomino(domino);
+    }
+    inline DominoPointerVector tilesForMask(uint64_t tiles) const { // ascending dominoSet index
+        DominoPointerVector result;
+        for (int i = 0; tiles != 0; i++, tiles >>= 1) {
+            if (tiles & 1) {
+                result.push_back(&dominoSet[i]);
+            }
+        }
+        return result;
+    }
+    inline int suitMaskForTiles(uint64_t tiles) const { // bit per suit on any of the tiles (bit per dominoSet index)
+        int result = 0;
+        for (int i = 0; tiles != 0; i++, tiles >>= 1) {
+            if (tiles & 1) {
+                result |= (1 << dominoSet[i].ends.first) | (1 << dominoSet[i].ends.second);
+            }
+        }
+        return result;
+    }
 };
 
 #endif /* GameFoundation_hpp */
@@ -53,6 +53,20 @@ GameState GameState::stateForMonteCarloSampling(const GameState &gameState) {
                      gameState.parent);
 }
 
+GameState GameState::stateForPosition(const Game& game, const DominoPointerVector& playedTiles, const int playerTurnIndex, const IntPair layoutEnds, const bool previousPlayerPassed) {
+    return GameState(game,
+                     game.maxPlayerHand,
+                     game.minPlayerHand,
+                     playedTiles,
+                     playerTurnIndex,
+                     layoutEnds,
+                     (int)playedTiles.size(),
+                     playerTurnIndex == 0 ? game.gameFoundation.negativeInfinity : game.gameFoundation.infinity,
+                     previousPlayerPassed,
+                     false,
+                     NULL);
+}
+
 // for not copying children
 GameState::GameState(const Game& game,
                      const DominoPointerVector& maxPlayerHand,
@@ -145,7 +159,8 @@ Domino const* GameState::_getPlayerSmallestValueDomino(const bool isMaxPlayer) c
     int min = game.gameFoundation.infinity;
     Domino const* result = NULL;
     for (int i = 0; i < hand.size(); i++) {
-        if (hand[i]->getTileTotal() < min) {
+        // ties go to the smaller suit, so the result does not depend on hand order
+        if (result == NULL || hand[i]->getTileTotal() < min || (hand[i]->getTileTotal() == min && hand[i]->smallerSuit() < result->smallerSuit())) {
             min = hand[i]->getTileTotal();
             result = hand[i];
         }
@@ -275,6 +290,18 @@ void GameState::_generateState(const int tileIndex, const DominoPointerVector& p
     children.push_back(childState);
 }
 
+uint64_t GameState::_tileMaskForHand(const DominoPointerVector& hand) const {
+    uint64_t mask = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        mask |= (1ULL << game.gameFoundation.indexForDomino(hand[i]));
+    }
+    return mask;
+}
+
+PositionKey GameState::positionKey() const {
+    return PositionKey(_tileMaskForHand(maxPlayerHand), _tileMaskForHand(minPlayerHand), layoutEnds, playerTurnIndex, previousPlayerPassed);
+}
+
 std::string GameState::prettyString() const {
     std::string result = "";
 
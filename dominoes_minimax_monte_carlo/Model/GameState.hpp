@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "Game.hpp"
+#include "PositionKey.hpp"
 
 typedef std::pair<int, int> IntPair;
 typedef std::vector<Domino const*> DominoPointerVector;
@@ -23,6 +24,7 @@ private:
     int _getPlayerSmallestSuitOfSmallestValue(const bool isMaxPlayer) const;
     void _updateLayoutEnds(Domino const* domino, const int layoutValue);
     void _generateState(const int tileIndex, const DominoPointerVector& playerHand, const int layoutValue, const bool pass);
+    uint64_t _tileMaskForHand(const DominoPointerVector& hand) const;
 
     inline int _defaultMinimaxValueForTurnIndex(const int turnIndex) const {
         return turnIndex == 0 ? game.gameFoundation.negativeInfinity : game.gameFoundation.infinity;
@@ -74,6 +76,9 @@ public:
 
     static GameState stateForMonteCarloSampling(const GameState& gameState);
 
+    // the state with game's hands part way through a game. depth counts the played tiles, since passes are not known.
+    static GameState stateForPosition(const Game& game, const DominoPointerVector& playedTiles, const int playerTurnIndex, const IntPair layoutEnds, const bool previousPlayerPassed);
+
     GameState(const Game& game);
 
     const Game& game;
@@ -92,6 +97,7 @@ public:
     int getScore() const;
     void expandAndGenerateChildren();
     std::string prettyString() const;
+    PositionKey positionKey() const;
 
     inline bool isMaxPlayer() const {
         return playerTurnIndex == 0;
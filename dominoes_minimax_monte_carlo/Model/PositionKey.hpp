@@ -0,0 +1,61 @@
+//
+//  PositionKey.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef PositionKey_hpp
+#define PositionKey_hpp
+
+#include <stdint.h>
+#include <functional>
+#include <utility>
+
+typedef std::pair<int, int> IntPair;
+
+// identifies a position by everything its minimax value depends on. tiles are bits indexed by
+// position in GameFoundation::dominoSet, so up to 64 dominoes (max suit 9) are supported.
+struct PositionKey {
+    PositionKey(uint64_t maxPlayerTiles = 0, uint64_t minPlayerTiles = 0, IntPair layoutEnds = std::make_pair(-1, -1), int playerTurnIndex = 0, bool previousPlayerPassed = false) : maxPlayerTiles(maxPlayerTiles), minPlayerTiles(minPlayerTiles), playerTurnIndex(playerTurnIndex), previousPlayerPassed(previousPlayerPassed) {
+        layoutFirst = (int8_t)layoutEnds.first;
+        layoutSecond = (int8_t)layoutEnds.second;
+    }
+
+    uint64_t maxPlayerTiles;
+    uint64_t minPlayerTiles;
+    int8_t layoutFirst;
+    int8_t layoutSecond;
+    int8_t playerTurnIndex;
+    bool previousPlayerPassed;
+
+    inline bool operator==(const PositionKey& other) const {
+        return maxPlayerTiles == other.maxPlayerTiles &&
+               minPlayerTiles == other.minPlayerTiles &&
+               layoutFirst == other.layoutFirst &&
+               layoutSecond == other.layoutSecond &&
+               playerTurnIndex == other.playerTurnIndex &&
+               previousPlayerPassed == other.previousPlayerPassed;
+    }
+
+    inline uint64_t hashValue() const {
+        uint64_t h = maxPlayerTiles * 0x9E3779B97F4A7C15ULL;
+        h ^= (minPlayerTiles + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2));
+        const uint64_t small = ((uint64_t)(uint8_t)layoutFirst) | ((uint64_t)(uint8_t)layoutSecond << 8) | ((uint64_t)playerTurnIndex << 16) | ((uint64_t)previousPlayerPassed << 17);
+        h ^= (small + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2));
+        // splitmix64 finalizer
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return h;
+    }
+};
+
+struct PositionKeyHash {
+    inline size_t operator()(const PositionKey& key) const {
+        return (size_t)key.hashValue();
+    }
+};
+
+#endif /* PositionKey_hpp */
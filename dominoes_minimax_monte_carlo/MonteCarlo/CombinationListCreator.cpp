@@ -42,6 +42,42 @@ int CombinationListCreator::_nChooseK(const int n, int k) {
     return result;
 }
 
+int CombinationListCreator::numberOfCombinations(const int n, const int k) {
+    return _nChooseK(n, k);
+}
+
+IntVector CombinationListCreator::combinationForIndex(const int n, const int k, int index) {
+    IntVector result;
+    int candidate = 0;
+    for (int position = 0; position < k; position++) {
+        // skip whole blocks of combinations that start with a smaller candidate
+        while (true) {
+            const int combinationsStartingHere = _nChooseK(n - 1 - candidate, k - 1 - position);
+            if (index < combinationsStartingHere) {
+                break;
+            }
+            index -= combinationsStartingHere;
+            candidate++;
+        }
+        result.push_back(candidate);
+        candidate++;
+    }
+    return result;
+}
+
+int CombinationListCreator::indexForCombination(const int n, const IntVector& combination) {
+    const int k = (int)combination.size();
+    int index = 0;
+    int candidate = 0;
+    for (int position = 0; position < k; position++) {
+        for (; candidate < combination[position]; candidate++) {
+            index += _nChooseK(n - 1 - candidate, k - 1 - position);
+        }
+        candidate++;
+    }
+    return index;
+}
+
 IntVector CombinationListCreator::indexList(const int n, const int k, const bool shuffle) {
     const int listSize = _nChooseK(n, k);
     std::vector<int> result(listSize);
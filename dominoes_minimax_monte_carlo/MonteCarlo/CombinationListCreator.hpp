@@ -19,6 +19,9 @@ private:
 public:
     static IntVectorVector listOfCombinationIndices(const int n, const int k); // return a list of all (n choose k) combinations from 0 to n - 1
     static IntVector indexList(const int n, const int k, const bool shuffle); // return a list of size (n choose k) from 0 to (n choose k) - 1
+    static int numberOfCombinations(const int n, const int k); // return (n choose k)
+    static IntVector combinationForIndex(const int n, const int k, int index); // return listOfCombinationIndices(n, k)[index] without building the list
+    static int indexForCombination(const int n, const IntVector& combination); // inverse of combinationForIndex. combination must be ascending
 };
 
 #endif /* CombinationListCreator_hpp */
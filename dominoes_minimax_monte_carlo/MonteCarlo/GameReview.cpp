@@ -0,0 +1,64 @@
+//
+//  GameReview.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "GameReview.hpp"
+#include "GameRecord.hpp"
+#include "MultiPVSearch.hpp"
+#include "SolutionStore.hpp"
+
+int GameReview::_layoutEndForChild(const GameState& state, const int childIndex) {
+    const GameState& child = state.children[childIndex];
+    if (state.playedTiles.empty() || child.playedTiles.size() == state.playedTiles.size()) {
+        return -1;
+    }
+    // a double can only go on the end with its suit. any other tile changes the end it goes on.
+    Domino const* tile = child.playedTiles.back();
+    if (tile->ends.first == tile->ends.second) {
+        return tile->ends.first;
+    }
+    return child.layoutEnds.first != state.layoutEnds.first ? state.layoutEnds.first : state.layoutEnds.second;
+}
+
+GameReviewData GameReview::reviewGame(const MonteCarloData& monteCarloData, const bool carrySolutions, PersistentSolutionCache* persistentSolutionCache) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    GameReviewData result;
+    SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, persistentSolutionCache);
+
+    const GameStateVector& path = monteCarloData.path;
+    for (int i = 0; i + 1 < path.size(); i++) {
+        if (!carrySolutions) {
+            solutionStore.clear();
+        }
+        GameState state = GameState::stateRemovingChildren(path[i]);
+        state.parent = NULL;
+        const MultiPVData multiPVData = MultiPVSearch::runOnState(state, &solutionStore);
+
+        // the child MultiPVSearch generated for the move the game went on with
+        const uint8_t playedMove = GameRecord::moveForStates(path[i], path[i + 1]);
+        int playedChildIndex = 0;
+        while (GameRecord::moveForStates(state, state.children[playedChildIndex]) != playedMove) {
+            playedChildIndex++;
+        }
+
+        GameReviewPlyData plyData;
+        plyData.ply = i;
+        plyData.isMaxPlayer = state.isMaxPlayer();
+        plyData.playedValue = multiPVData.childValues[playedChildIndex];
+        plyData.bestValue = multiPVData.childValues[multiPVData.bestChildIndex];
+        plyData.playedTile = multiPVData.childTiles[playedChildIndex];
+        plyData.bestTile = multiPVData.childTiles[multiPVData.bestChildIndex];
+        plyData.playedEnd = _layoutEndForChild(state, playedChildIndex);
+        plyData.bestEnd = _layoutEndForChild(state, multiPVData.bestChildIndex);
+        plyData.numberOfMoves = (int)state.children.size();
+        plyData.nodesVisited = multiPVData.nodesVisited;
+        result.plies.push_back(plyData);
+        result.nodesVisited += multiPVData.nodesVisited;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    result.elapsed = elapsed.count();
+    return result;
+}
@@ -0,0 +1,27 @@
+//
+//  GameReview.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameReview_hpp
+#define GameReview_hpp
+
+#include "GameReviewData.hpp"
+#include "MonteCarloData.hpp"
+
+class PersistentSolutionCache;
+
+// compares each move of a played game with the best move given the actual hidden hands. every legal
+// move of every ply gets its exact value from MultiPVSearch. the plies share one solution store by
+// default: each ply's position is a child of the one before, so most of its subtrees are already solved.
+// a persistent cache sits behind the store and is not cleared between plies, even without carrySolutions.
+class GameReview {
+private:
+    // the layout end the child's tile goes on, as select_moves reports it. -1 for a pass or the first tile
+    static int _layoutEndForChild(const GameState& state, const int childIndex);
+public:
+    static GameReviewData reviewGame(const MonteCarloData& monteCarloData, const bool carrySolutions = true, PersistentSolutionCache* persistentSolutionCache = NULL);
+};
+
+#endif /* GameReview_hpp */
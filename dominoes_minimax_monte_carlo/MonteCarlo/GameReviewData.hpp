@@ -0,0 +1,78 @@
+//
+//  GameReviewData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameReviewData_hpp
+#define GameReviewData_hpp
+
+#include <string>
+#include <vector>
+
+#include "Domino.hpp"
+
+struct GameReviewPlyData {
+    GameReviewPlyData() : ply(0), isMaxPlayer(true), playedValue(0), bestValue(0), playedTile(NULL), bestTile(NULL), playedEnd(-1), bestEnd(-1), numberOfMoves(0), nodesVisited(0) {}
+
+    int ply; // index into MonteCarloData::path of the state moved from
+    bool isMaxPlayer;
+    int playedValue; // perfect-information value after the move played
+    int bestValue; // after the best move
+    Domino const* playedTile; // NULL for a pass
+    Domino const* bestTile;
+    int playedEnd; // layout end the played tile went on, -1 for a pass or the first tile
+    int bestEnd;
+    int numberOfMoves;
+    long long nodesVisited;
+
+    // points the mover gave up against the best move with every hand known
+    inline int getRegret() const {
+        return isMaxPlayer ? bestValue - playedValue : playedValue - bestValue;
+    }
+};
+
+struct GameReviewData {
+    GameReviewData() : nodesVisited(0), elapsed(0.0) {}
+
+    std::vector<GameReviewPlyData> plies;
+    long long nodesVisited;
+    double elapsed;
+
+    inline int getTotalRegret(const bool isMaxPlayer) const {
+        int total = 0;
+        for (int i = 0; i < plies.size(); i++) {
+            if (plies[i].isMaxPlayer == isMaxPlayer) {
+                total += plies[i].getRegret();
+            }
+        }
+        return total;
+    }
+
+    // a tile that fits both ends makes two moves, so the end tells them apart
+    static std::string moveString(Domino const* tile, const int end) {
+        if (tile == NULL) {
+            return "pass";
+        }
+        return end >= 0 ? tile->prettyString() + " on " + std::to_string(end) : tile->prettyString();
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        for (int i = 0; i < plies.size(); i++) {
+            const GameReviewPlyData& ply = plies[i];
+            const std::string playedString = moveString(ply.playedTile, ply.playedEnd);
+            const std::string bestString = moveString(ply.bestTile, ply.bestEnd);
+            result += "Ply " + std::to_string(ply.ply + 1) + " (" + (ply.isMaxPlayer ? "Max" : "Min") + ", " + std::to_string(ply.numberOfMoves) + " moves): ";
+            result += "played " + playedString + " = " + std::to_string(ply.playedValue) + ", best " + bestString + " = " + std::to_string(ply.bestValue);
+            result += ", regret " + std::to_string(ply.getRegret()) + " (" + std::to_string(ply.nodesVisited) + " nodes)\n";
+        }
+        result += "Max Player Regret: " + std::to_string(getTotalRegret(true)) + "\n";
+        result += "Min Player Regret: " + std::to_string(getTotalRegret(false)) + "\n";
+        result += "Nodes Visited: " + std::to_string(nodesVisited) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        return result;
+    }
+};
+
+#endif /* GameReviewData_hpp */
@@ -0,0 +1,58 @@
+//
+//  HandEquityData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef HandEquityData_hpp
+#define HandEquityData_hpp
+
+#include <string>
+#include <vector>
+
+#include "Domino.hpp"
+
+typedef std::vector<Domino const*> DominoPointerVector;
+
+struct HandEquityData {
+    HandEquityData() : handRank(0), equity(0.0), standardError(0.0), solves(0), numberOfStrata(0), controlCoefficient(0.0), pooledResidualVariance(0.0), naiveStandardDeviation(0.0), naiveSolves(-1), naiveEquity(0.0), naiveStandardError(0.0), elapsed(0.0) {}
+
+    int handRank; // CombinationListCreator rank of the max hand
+    DominoPointerVector hand;
+    double equity; // expected minimax value over opponent deals, max moving first
+    double standardError;
+    int solves;
+    int numberOfStrata;
+    double controlCoefficient; // value points per opponent pip, pooled over strata
+    double pooledResidualVariance; // within strata, after the control variate adjustment
+    double naiveStandardDeviation; // of a single uniformly drawn deal's value, estimated from the strata
+    int naiveSolves; // solves compareWithNaiveSampling took to reach the same standard error. -1 when not run
+    double naiveEquity;
+    double naiveStandardError;
+    double elapsed;
+
+    // uniform draws needed for standardError, from the variance of a single draw
+    inline double getNaiveSolvesForStandardError() const {
+        return standardError > 0.0 ? (naiveStandardDeviation * naiveStandardDeviation) / (standardError * standardError) : 0.0;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Hand " + std::to_string(handRank) + ":";
+        for (int i = 0; i < hand.size(); i++) {
+            result += " " + hand[i]->prettyString();
+        }
+        result += "\n";
+        result += "Equity: " + std::to_string(equity) + " +/- " + std::to_string(standardError) + "\n";
+        result += "Solves: " + std::to_string(solves) + " over " + std::to_string(numberOfStrata) + " strata\n";
+        result += "Control Coefficient: " + std::to_string(controlCoefficient) + " points per opponent pip\n";
+        result += "Naive Solves For Same Error (Estimated): " + std::to_string(getNaiveSolvesForStandardError()) + "\n";
+        if (naiveSolves >= 0) {
+            result += "Naive Sampling: " + std::to_string(naiveEquity) + " +/- " + std::to_string(naiveStandardError) + " after " + std::to_string(naiveSolves) + " solves\n";
+        }
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        return result;
+    }
+};
+
+#endif /* HandEquityData_hpp */
@@ -0,0 +1,336 @@
+//
+//  HandEquityEstimator.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <atomic>
+#include <thread>
+
+#include "HandEquityEstimator.hpp"
+#include "CombinationListCreator.hpp"
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "HandSampler.hpp"
+#include "MinimaxSearch.hpp"
+#include "RunningStatistics.hpp"
+
+// the opponent's tiles from each group are fixed within a stratum, so a deal is one combination per group
+struct HandEquityStratum {
+    HandEquityStratum() : probability(0.0), controlMean(0.0), numberOfDeals(1.0), sequenceIndex(0), count(0), sumX(0.0), sumY(0.0), sumXX(0.0), sumXY(0.0), sumYY(0.0) {}
+
+    IntVector tilesFromGroups;
+    DoubleVector sequenceShifts; // per group, randomizing the Kronecker sequence
+    double probability; // of a uniform deal falling in this stratum
+    double controlMean; // expected opponent pips in this stratum
+    double numberOfDeals;
+    long long sequenceIndex;
+    int count;
+    double sumX; // opponent pips
+    double sumY; // minimax value
+    double sumXX;
+    double sumXY;
+    double sumYY;
+
+    inline void add(const double x, const double y) {
+        count++;
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        sumYY += y * y;
+    }
+    // centered sums of squares and products
+    inline double getSxx() const {
+        return count > 0 ? sumXX - (sumX * sumX) / count : 0.0;
+    }
+    inline double getSxy() const {
+        return count > 0 ? sumXY - (sumX * sumY) / count : 0.0;
+    }
+    inline double getSyy() const {
+        return count > 0 ? sumYY - (sumY * sumY) / count : 0.0;
+    }
+    // sum of squared residuals after the control variate adjustment
+    inline double getResidualSumOfSquares(const double controlCoefficient) const {
+        return std::max(0.0, getSyy() - (2.0 * controlCoefficient * getSxy()) + (controlCoefficient * controlCoefficient * getSxx()));
+    }
+    // the stratum's residual variance shrunk toward pooledVariance, which a few samples that happen to agree
+    // would otherwise understate
+    inline double getResidualVariance(const double controlCoefficient, const double pooledVariance) const {
+        if (numberOfDeals <= 1.0) {
+            return 0.0;
+        }
+        const double degreesOfFreedom = std::max(0, count - 1);
+        return (getResidualSumOfSquares(controlCoefficient) + (kHandEquityVariancePriorSamples * pooledVariance)) / (degreesOfFreedom + kHandEquityVariancePriorSamples);
+    }
+    inline double getAdjustedMean(const double controlCoefficient) const {
+        return (sumY / count) - (controlCoefficient * ((sumX / count) - controlMean));
+    }
+};
+
+// generalized golden ratio steps for three dimensions, one per group
+static const double kHandEquitySequenceSteps[] = { 0.8191725133961645, 0.6710436067037893, 0.5497004779019703 };
+static const int kHandEquityNumberOfGroups = 3;
+
+static double choose(const int n, const int k) {
+    if (k < 0 || k > n) {
+        return 0.0;
+    }
+    double result = 1.0;
+    for (int i = 1; i <= k; i++) {
+        result *= (double)(n - k + i) / (double)i;
+    }
+    return result;
+}
+
+static int pipsForTiles(const GameFoundation& gameFoundation, const IntVector& tileIndices) {
+    int pips = 0;
+    for (int i = 0; i < tileIndices.size(); i++) {
+        pips += gameFoundation.dominoSet[tileIndices[i]].getTileTotal();
+    }
+    return pips;
+}
+
+HandEquityStratumVector HandEquityEstimator::_strata(const GameFoundation& gameFoundation, const IntVector& handTileIndices, std::mt19937& engine, IntVectorVector& groups) {
+    // the suit the hand holds most of, so the opponent holds few of it
+    IntVector suitCounts(gameFoundation.maxDominoSuit + 1, 0);
+    for (int i = 0; i < handTileIndices.size(); i++) {
+        const Domino& domino = gameFoundation.dominoSet[handTileIndices[i]];
+        suitCounts[domino.ends.first]++;
+        if (domino.ends.second != domino.ends.first) {
+            suitCounts[domino.ends.second]++;
+        }
+    }
+    const int longestSuit = (int)(std::max_element(suitCounts.begin(), suitCounts.end()) - suitCounts.begin());
+
+    groups = IntVectorVector(kHandEquityNumberOfGroups);
+    for (int i = 0; i < gameFoundation.numberOfDominoes; i++) {
+        if (std::find(handTileIndices.begin(), handTileIndices.end(), i) != handTileIndices.end()) {
+            continue;
+        }
+        const Domino& domino = gameFoundation.dominoSet[i];
+        if (domino.hasSuit(longestSuit)) {
+            groups[0].push_back(i);
+        } else if (domino.ends.first == domino.ends.second) {
+            groups[1].push_back(i);
+        } else {
+            groups[2].push_back(i);
+        }
+    }
+
+    DoubleVector groupPipMeans;
+    int tilesLeft = 0;
+    for (int g = 0; g < kHandEquityNumberOfGroups; g++) {
+        groupPipMeans.push_back(groups[g].empty() ? 0.0 : (double)pipsForTiles(gameFoundation, groups[g]) / groups[g].size());
+        tilesLeft += (int)groups[g].size();
+    }
+
+    HandEquityStratumVector result;
+    const int handSize = gameFoundation.handSize;
+    const double numberOfDeals = choose(tilesLeft, handSize);
+    std::uniform_real_distribution<double> shiftDistribution(0.0, 1.0);
+    for (int first = 0; first <= std::min(handSize, (int)groups[0].size()); first++) {
+        for (int second = 0; second <= std::min(handSize - first, (int)groups[1].size()); second++) {
+            const int third = handSize - first - second;
+            if (third > (int)groups[2].size()) {
+                continue;
+            }
+            HandEquityStratum stratum;
+            stratum.tilesFromGroups = { first, second, third };
+            for (int g = 0; g < kHandEquityNumberOfGroups; g++) {
+                const int fromGroup = stratum.tilesFromGroups[g];
+                stratum.numberOfDeals *= choose((int)groups[g].size(), fromGroup);
+                stratum.controlMean += fromGroup * groupPipMeans[g];
+                stratum.sequenceShifts.push_back(shiftDistribution(engine));
+            }
+            stratum.probability = stratum.numberOfDeals / numberOfDeals;
+            result.push_back(stratum);
+        }
+    }
+    return result;
+}
+
+IntVector HandEquityEstimator::_opponentHandForStratum(const IntVectorVector& groups, HandEquityStratum& stratum) {
+    stratum.sequenceIndex++;
+    IntVector result;
+    for (int g = 0; g < kHandEquityNumberOfGroups; g++) {
+        const int fromGroup = stratum.tilesFromGroups[g];
+        if (fromGroup == 0) {
+            continue;
+        }
+        const int groupSize = (int)groups[g].size();
+        const int numberOfCombinations = CombinationListCreator::numberOfCombinations(groupSize, fromGroup);
+        double position = stratum.sequenceShifts[g] + (stratum.sequenceIndex * kHandEquitySequenceSteps[g]);
+        position -= std::floor(position);
+        const int rank = std::min(numberOfCombinations - 1, (int)(position * numberOfCombinations));
+        const IntVector positions = CombinationListCreator::combinationForIndex(groupSize, fromGroup, rank);
+        for (int i = 0; i < positions.size(); i++) {
+            result.push_back(groups[g][positions[i]]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void HandEquityEstimator::_solveDeals(const GameFoundation& gameFoundation, const IntVector& handTileIndices, const IntVectorVector& opponentHands, const int numberOfThreads, SolutionStore& solutionStore, IntVector& values) {
+    values.assign(opponentHands.size(), 0);
+    std::atomic<int> nextDeal(0);
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < std::min(numberOfThreads, (int)opponentHands.size()); threadIndex++) {
+        threads.push_back(std::thread([&]() {
+            for (int i = nextDeal++; i < opponentHands.size(); i = nextDeal++) {
+                const Game game = Game::gameWithHands(gameFoundation, handTileIndices, opponentHands[i]);
+                GameState state(game);
+                values[i] = AlphaBetaMinimaxSearch::runOnState(state, false, &solutionStore).minimaxValue;
+            }
+        }));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+void HandEquityEstimator::_estimate(const HandEquityStratumVector& strata, HandEquityData& data) {
+    double pooledSxx = 0.0;
+    double pooledSxy = 0.0;
+    for (int i = 0; i < strata.size(); i++) {
+        pooledSxx += strata[i].getSxx();
+        pooledSxy += strata[i].getSxy();
+    }
+    data.controlCoefficient = pooledSxx > 0.0 ? pooledSxy / pooledSxx : 0.0;
+
+    double residualSumOfSquares = 0.0;
+    int degreesOfFreedom = 0;
+    for (int i = 0; i < strata.size(); i++) {
+        residualSumOfSquares += strata[i].getResidualSumOfSquares(data.controlCoefficient);
+        degreesOfFreedom += std::max(0, strata[i].count - 1);
+    }
+    data.pooledResidualVariance = degreesOfFreedom > 0 ? residualSumOfSquares / degreesOfFreedom : 0.0;
+
+    data.equity = 0.0;
+    double variance = 0.0;
+    double rawMean = 0.0;
+    for (int i = 0; i < strata.size(); i++) {
+        const HandEquityStratum& stratum = strata[i];
+        data.equity += stratum.probability * stratum.getAdjustedMean(data.controlCoefficient);
+        variance += stratum.probability * stratum.probability * stratum.getResidualVariance(data.controlCoefficient, data.pooledResidualVariance) / stratum.count;
+        rawMean += stratum.probability * (stratum.sumY / stratum.count);
+    }
+    data.standardError = std::sqrt(variance);
+
+    // law of total variance: a uniform draw varies within its stratum and between strata
+    double naiveVariance = 0.0;
+    for (int i = 0; i < strata.size(); i++) {
+        const HandEquityStratum& stratum = strata[i];
+        const double stratumMean = stratum.sumY / stratum.count;
+        const double withinVariance = stratum.count > 1 ? stratum.getSyy() / (stratum.count - 1) : 0.0;
+        naiveVariance += stratum.probability * (withinVariance + ((stratumMean - rawMean) * (stratumMean - rawMean)));
+    }
+    data.naiveStandardDeviation = std::sqrt(naiveVariance);
+}
+
+void HandEquityEstimator::_compareWithNaiveSampling(const GameFoundation& gameFoundation, const IntVector& handTileIndices, const HandEquitySettings& settings, SolutionStore& solutionStore, HandEquityData& data) {
+    uint64_t tilesLeft = 0;
+    for (int i = 0; i < gameFoundation.numberOfDominoes; i++) {
+        if (std::find(handTileIndices.begin(), handTileIndices.end(), i) == handTileIndices.end()) {
+            tilesLeft |= 1ULL << i;
+        }
+    }
+    const HandSampler handSampler(gameFoundation, tilesLeft, gameFoundation.handSize);
+    std::default_random_engine engine(settings.seed);
+    RunningStatistics values;
+    const int numberOfThreads = settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+    while (values.count < settings.maximumSolves && (values.count < 2 || std::sqrt(values.getVariance() / values.count) > data.standardError)) {
+        IntVectorVector opponentHands;
+        for (int i = 0; i < kHandEquityBatchSolves; i++) {
+            const IntVector sample = handSampler.sample(engine);
+            IntVector opponentHand;
+            for (int j = 0; j < sample.size(); j++) {
+                opponentHand.push_back(gameFoundation.indexForDomino(handSampler.getCandidates()[sample[j]]));
+            }
+            opponentHands.push_back(opponentHand);
+        }
+        IntVector batchValues;
+        _solveDeals(gameFoundation, handTileIndices, opponentHands, numberOfThreads, solutionStore, batchValues);
+        for (int i = 0; i < batchValues.size(); i++) {
+            values.add(batchValues[i]);
+        }
+    }
+    data.naiveSolves = (int)values.count;
+    data.naiveEquity = values.mean;
+    data.naiveStandardError = std::sqrt(values.getVariance() / values.count);
+}
+
+HandEquityData HandEquityEstimator::estimate(const GameFoundation& gameFoundation, const int handRank, const HandEquitySettings& settings) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    HandEquityData result;
+    result.handRank = handRank;
+    const IntVector handTileIndices = CombinationListCreator::combinationForIndex(gameFoundation.numberOfDominoes, gameFoundation.handSize, handRank);
+    for (int i = 0; i < handTileIndices.size(); i++) {
+        result.hand.push_back(&gameFoundation.dominoSet[handTileIndices[i]]);
+    }
+    const int numberOfThreads = settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+
+    std::mt19937 engine(settings.seed);
+    IntVectorVector groups;
+    HandEquityStratumVector strata = _strata(gameFoundation, handTileIndices, engine, groups);
+    result.numberOfStrata = (int)strata.size();
+    SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, settings.persistentSolutionCache); // every deal of the hand shares the max hand, so endgames repeat across deals
+
+    IntVector batchStrata;
+    for (int i = 0; i < strata.size(); i++) {
+        const int pilotSolves = (int)std::min((double)kHandEquityPilotSolvesPerStratum, strata[i].numberOfDeals);
+        batchStrata.insert(batchStrata.end(), pilotSolves, i);
+    }
+    while (!batchStrata.empty()) {
+        IntVectorVector opponentHands;
+        for (int i = 0; i < batchStrata.size(); i++) {
+            opponentHands.push_back(_opponentHandForStratum(groups, strata[batchStrata[i]]));
+        }
+        IntVector values;
+        _solveDeals(gameFoundation, handTileIndices, opponentHands, numberOfThreads, solutionStore, values);
+        for (int i = 0; i < batchStrata.size(); i++) {
+            strata[batchStrata[i]].add(pipsForTiles(gameFoundation, opponentHands[i]), values[i]);
+        }
+        result.solves += (int)batchStrata.size();
+        _estimate(strata, result);
+        if (result.standardError <= settings.targetStandardError || result.solves >= settings.maximumSolves) {
+            break;
+        }
+
+        // each solve goes where it cuts the variance of the estimate most. strata with a single deal are exact.
+        batchStrata.clear();
+        IntVector counts;
+        for (int i = 0; i < strata.size(); i++) {
+            counts.push_back(strata[i].count);
+        }
+        const int batchSolves = std::min(kHandEquityBatchSolves, settings.maximumSolves - result.solves);
+        for (int solve = 0; solve < batchSolves; solve++) {
+            int bestStratum = -1;
+            double bestReduction = 0.0;
+            for (int i = 0; i < strata.size(); i++) {
+                if (strata[i].numberOfDeals <= 1.0) {
+                    continue;
+                }
+                const double variance = strata[i].getResidualVariance(result.controlCoefficient, result.pooledResidualVariance);
+                const double reduction = strata[i].probability * strata[i].probability * variance * ((1.0 / counts[i]) - (1.0 / (counts[i] + 1)));
+                if (reduction > bestReduction) {
+                    bestReduction = reduction;
+                    bestStratum = i;
+                }
+            }
+            if (bestStratum < 0) {
+                break;
+            }
+            counts[bestStratum]++;
+            batchStrata.push_back(bestStratum);
+        }
+    }
+
+    if (settings.compareWithNaiveSampling) {
+        _compareWithNaiveSampling(gameFoundation, handTileIndices, settings, solutionStore, result);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    result.elapsed = elapsed.count();
+    return result;
+}
@@ -0,0 +1,40 @@
+//
+//  HandEquityEstimator.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef HandEquityEstimator_hpp
+#define HandEquityEstimator_hpp
+
+#include <random>
+
+#include "GameFoundation.hpp"
+#include "HandEquityData.hpp"
+#include "HandEquitySettings.hpp"
+#include "SolutionStore.hpp"
+
+struct HandEquityStratum;
+
+typedef std::vector<HandEquityStratum> HandEquityStratumVector;
+
+// estimates a max hand's expected minimax value over opponent deals with fewer solves than uniform sampling:
+// - the tiles left are split into the max hand's longest suit, the other doubles, and the rest. deals are
+//   stratified by how many opponent tiles come from each group, with exact hypergeometric weights, and
+//   batches go to the strata where a solve cuts the variance most.
+// - the opponent's pip total is a control variate. its mean in each stratum is known exactly.
+// - within a stratum each group's tiles are chosen by ranks from a randomly shifted Kronecker sequence,
+//   which covers the combinations more evenly than independent draws. the standard error treats them as
+//   independent draws.
+class HandEquityEstimator {
+private:
+    static HandEquityStratumVector _strata(const GameFoundation& gameFoundation, const IntVector& handTileIndices, std::mt19937& engine, IntVectorVector& groups);
+    static IntVector _opponentHandForStratum(const IntVectorVector& groups, HandEquityStratum& stratum);
+    static void _solveDeals(const GameFoundation& gameFoundation, const IntVector& handTileIndices, const IntVectorVector& opponentHands, const int numberOfThreads, SolutionStore& solutionStore, IntVector& values);
+    static void _estimate(const HandEquityStratumVector& strata, HandEquityData& data);
+    static void _compareWithNaiveSampling(const GameFoundation& gameFoundation, const IntVector& handTileIndices, const HandEquitySettings& settings, SolutionStore& solutionStore, HandEquityData& data);
+public:
+    static HandEquityData estimate(const GameFoundation& gameFoundation, const int handRank, const HandEquitySettings& settings);
+};
+
+#endif /* HandEquityEstimator_hpp */
@@ -0,0 +1,33 @@
+//
+//  HandEquitySettings.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef HandEquitySettings_hpp
+#define HandEquitySettings_hpp
+
+class PersistentSolutionCache;
+
+static const double kDefaultHandEquityTargetStandardError = 0.5; // points
+static const int kDefaultHandEquityMaximumSolves = 20000;
+static const int kHandEquityPilotSolvesPerStratum = 2; // enough for a variance in every stratum
+static const double kHandEquityVariancePriorSamples = 4.0; // weight of the pooled variance in each stratum's variance
+static const int kHandEquityBatchSolves = 32; // solves allocated between standard error checks
+
+struct HandEquitySettings {
+    HandEquitySettings(double targetStandardError = kDefaultHandEquityTargetStandardError, int maximumSolves = kDefaultHandEquityMaximumSolves, unsigned int seed = 1) : targetStandardError(targetStandardError), maximumSolves(maximumSolves), seed(seed) {
+        numberOfThreads = 0;
+        compareWithNaiveSampling = false;
+        persistentSolutionCache = NULL;
+    }
+
+    double targetStandardError;
+    int maximumSolves;
+    unsigned int seed; // randomizes the quasi-random sequences, and the naive draws
+    int numberOfThreads; // solves of a batch run in parallel. 0 uses every hardware core
+    bool compareWithNaiveSampling; // also sample uniformly to the same standard error and report the solves it took
+    PersistentSolutionCache* persistentSolutionCache; // behind the estimate's solution store. NULL disables
+};
+
+#endif /* HandEquitySettings_hpp */
@@ -0,0 +1,72 @@
+//
+//  HandSampler.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "HandSampler.hpp"
+
+HandSampler::HandSampler(const GameFoundation& gameFoundation, const uint64_t possibleTiles, const int handSize) : _candidates(gameFoundation.tilesForMask(possibleTiles)), _handSize(handSize) {
+    assert(_handSize <= (int)_candidates.size());
+}
+
+void HandSampler::setTileWeights(const GameFoundation& gameFoundation, const DoubleVector& weightsByTileIndex) {
+    _weights.clear();
+    for (int i = 0; i < _candidates.size(); i++) {
+        _weights.push_back(std::max(0.0, weightsByTileIndex[gameFoundation.indexForDomino(_candidates[i])]));
+    }
+}
+
+IntVector HandSampler::_uniformSample(std::default_random_engine& engine) const {
+    // Floyd: for each of the last handSize positions j, take a random position up to j, or j itself if that one is taken
+    const int numberOfCandidates = (int)_candidates.size();
+    uint64_t chosen = 0;
+    for (int j = numberOfCandidates - _handSize; j < numberOfCandidates; j++) {
+        const int position = std::uniform_int_distribution<int>(0, j)(engine);
+        chosen |= (chosen & (1ULL << position)) ? (1ULL << j) : (1ULL << position);
+    }
+    IntVector result;
+    result.reserve(_handSize);
+    while (chosen != 0) {
+        result.push_back(__builtin_ctzll(chosen));
+        chosen &= chosen - 1;
+    }
+    return result;
+}
+
+IntVector HandSampler::_weightedSample(std::default_random_engine& engine) const {
+    // Efraimidis-Spirakis: the handSize largest keys u^(1/w) are a weighted draw without replacement
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<std::pair<double, int>> keys;
+    for (int i = 0; i < _candidates.size(); i++) {
+        const double key = _weights[i] > 0.0 ? std::pow(distribution(engine), 1.0 / _weights[i]) : -distribution(engine);
+        keys.push_back(std::make_pair(key, i));
+    }
+    std::nth_element(keys.begin(), keys.begin() + _handSize, keys.end(), std::greater<std::pair<double, int>>());
+    IntVector result;
+    for (int i = 0; i < _handSize; i++) {
+        result.push_back(keys[i].second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+IntVector HandSampler::sample(std::default_random_engine& engine) const {
+    return _weights.empty() ? _uniformSample(engine) : _weightedSample(engine);
+}
+
+uint64_t HandSampler::maskForSample(const IntVector& sample) const {
+    uint64_t result = 0;
+    for (int i = 0; i < sample.size(); i++) {
+        result |= (1ULL << sample[i]);
+    }
+    return result;
+}
+
+double HandSampler::numberOfHands() const {
+    double result = 1.0;
+    for (int i = 0; i < _handSize; i++) {
+        result = result * (double)(_candidates.size() - i) / (double)(i + 1);
+    }
+    return result;
+}
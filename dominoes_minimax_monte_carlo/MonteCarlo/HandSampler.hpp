@@ -0,0 +1,47 @@
+//
+//  HandSampler.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef HandSampler_hpp
+#define HandSampler_hpp
+
+#include <functional>
+#include <random>
+#include <stdint.h>
+#include <vector>
+
+#include "GameFoundation.hpp"
+
+typedef std::vector<double> DoubleVector;
+
+// draws hidden hands from a possible-tile mask. every hand drawn is consistent with the mask, so
+// nothing is rejected: uniform draws take O(handSize) with Floyd's algorithm, weighted ones O(candidates).
+// hands are positions into getCandidates(), ascending, so they work as index combos for the sample loops.
+class HandSampler {
+private:
+    DominoPointerVector _candidates; // the possible tiles, ascending dominoSet index
+    DoubleVector _weights; // per candidate. empty for uniform draws
+    int _handSize;
+
+    IntVector _uniformSample(std::default_random_engine& engine) const;
+    IntVector _weightedSample(std::default_random_engine& engine) const;
+public:
+    HandSampler(const GameFoundation& gameFoundation, const uint64_t possibleTiles, const int handSize);
+
+    // weights by dominoSet index, e.g. from play history. a tile with weight 0 is only drawn when the
+    // hand cannot be filled otherwise
+    void setTileWeights(const GameFoundation& gameFoundation, const DoubleVector& weightsByTileIndex);
+    IntVector sample(std::default_random_engine& engine) const;
+    // the candidate mask of a sampled hand, for telling hands apart
+    uint64_t maskForSample(const IntVector& sample) const;
+    // (candidates choose hand size), as a double since it can exceed an int for larger sets
+    double numberOfHands() const;
+
+    inline const DominoPointerVector& getCandidates() const {
+        return _candidates;
+    }
+};
+
+#endif /* HandSampler_hpp */
@@ -10,9 +10,37 @@
 #include "GameState.hpp"
 
 typedef std::vector<GameState> GameStateVector;
+typedef std::vector<double> DoubleVector;
+typedef std::vector<long long> LongLongVector;
 
 struct MonteCarloData {
+    MonteCarloData() : solutionStoreHits(0), solutionStorePersistentHits(0), solutionStoreSize(0), partitionTableHits(0), openingBookMoves(0) {}
+
     GameStateVector path;
+    DoubleVector moveDurations; // seconds spent choosing each move in path
+    LongLongVector moveNodesVisited;
+    long long solutionStoreHits;
+    long long solutionStorePersistentHits; // of solutionStoreHits, those answered by the persistent cache
+    long long solutionStoreSize;
+    long long partitionTableHits;
+    int openingBookMoves; // moves answered from the opening book instead of sampled
+
+    inline double getTotalMoveDuration() const {
+        double total = 0.0;
+        for (int i = 0; i < moveDurations.size(); i++) {
+            total += moveDurations[i];
+        }
+        return total;
+    }
+
+    inline long long getTotalNodesVisited() const {
+        long long total = 0;
+        for (int i = 0; i < moveNodesVisited.size(); i++) {
+            total += moveNodesVisited[i];
+        }
+        return total;
+    }
+
     std::string prettyString() const {
         std::string result = "";
         result += "\nPath:\n";
@@ -23,6 +51,20 @@ struct MonteCarloData {
         result += "Final Score: " + std::to_string(finalState.getScore()) + "\n";
         return result;
     }
+
+    std::string timingString() const {
+        std::string result = "";
+        for (int i = 0; i < moveDurations.size(); i++) {
+            result += "Move " + std::to_string(i + 1) + ": " + std::to_string(moveDurations[i]) + " s, " + std::to_string(moveNodesVisited[i]) + " nodes\n";
+        }
+        result += "Total Move Time: " + std::to_string(getTotalMoveDuration()) + " s\n";
+        result += "Solution Store Hits: " + std::to_string(solutionStoreHits) + "\n";
+        result += "Persistent Cache Hits: " + std::to_string(solutionStorePersistentHits) + "\n";
+        result += "Solution Store Size: " + std::to_string(solutionStoreSize) + "\n";
+        result += "Partition Table Hits: " + std::to_string(partitionTableHits) + "\n";
+        result += "Opening Book Moves: " + std::to_string(openingBookMoves) + "\n";
+        return result;
+    }
 };
 
 #endif /* MonteCarloData_hpp */
@@ -6,11 +6,25 @@
 
 #include <thread>
 #include <random>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <sys/resource.h>
 
 #include "MonteCarloDataGenerator.hpp"
 
 #include "CombinationListCreator.hpp"
+#include "CpuTopology.hpp"
+#include "HandSampler.hpp"
 #include "MinimaxSearch.hpp"
+#include "MultiWorldSearch.hpp"
+#include "OpeningBook.hpp"
+#include "PartitionSearch.hpp"
+#include "ProofNumberSearch.hpp"
+#include "Tracer.hpp"
 
 void MonteCarloDataGenerator::_updateChildCounts(const bool isMaxPlayer, const GameFoundation& gameFoundation, GameState& workState, IntVector& childCounts) {
     int currentMinimaxValue = isMaxPlayer ? gameFoundation.negativeInfinity : gameFoundation.infinity;
@@ -27,7 +41,7 @@ void MonteCarloDataGenerator::_updateChildCounts(const bool isMaxPlayer, const G
     childCounts[bestChildIndex] = childCounts[bestChildIndex] + 1;
 }
 
-int MonteCarloDataGenerator::_getBestChildIndex(IntVector& childCounts) {
+int MonteCarloDataGenerator::_getBestChildIndex(const IntVector& childCounts) {
     int maxOccurences = 0;
     int indexToUse = -1;
     for (int i = 0; i < childCounts.size(); i++) {
@@ -39,8 +53,64 @@ int MonteCarloDataGenerator::_getBestChildIndex(IntVector& childCounts) {
     return indexToUse;
 }
 
-void MonteCarloDataGenerator::_processSamples(GameState& workState, IntVector& childCounts, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation) {
+void MonteCarloDataGenerator::_processSamplesInLockstep(GameState& workState, IntVector& childCounts, long long& nodesVisited, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation) {
+    // the player to move is the same in every sample, so its children are too
+    DominoPointerVector& opponentHand = isMaxPlayer ? workState.minPlayerHand : workState.maxPlayerHand;
+    opponentHand.clear();
+    workState.children.clear();
+    workState.expandAndGenerateChildren();
+    assert(workState.children.size() > 0);
+    if (workState.children.size() == 1) {
+        if (startIndex < endIndex) {
+            childCounts[0] = childCounts[0] + 1;
+        }
+        return;
+    }
+
+    std::vector<DominoPointerVector> hiddenHands;
+    for (int batchStart = startIndex; batchStart < endIndex; batchStart += kMultiWorldWidth) {
+        const int batchEnd = std::min(batchStart + kMultiWorldWidth, endIndex);
+        hiddenHands.clear();
+        for (int currentSampleNumber = batchStart; currentSampleNumber < batchEnd; currentSampleNumber++) {
+            const IntVector& indexCombo = indexCombos[currentSampleNumber];
+            assert(indexCombo.size() == opponentHandSize);
+            DominoPointerVector hand;
+            for (int i = 0; i < opponentHandSize; i++) {
+                hand.push_back(possibleTiles[indexCombo[i]]);
+            }
+            hiddenHands.push_back(hand);
+        }
+
+        Tracer::begin("Sample Batch Solve");
+        MultiWorldData multiWorldData = MultiWorldSearch::runOnWorlds(workState, hiddenHands);
+        Tracer::end("Sample Batch Solve");
+        nodesVisited += multiWorldData.nodesVisited;
+
+        // same vote as _updateChildCounts: the first child with the best value in each world
+        for (int world = 0; world < multiWorldData.childValues.size(); world++) {
+            const IntVector& values = multiWorldData.childValues[world];
+            int currentMinimaxValue = isMaxPlayer ? gameFoundation.negativeInfinity : gameFoundation.infinity;
+            int bestChildIndex = -1;
+            for (int i = 0; i < values.size(); i++) {
+                if ((isMaxPlayer && values[i] > currentMinimaxValue) ||
+                    (!isMaxPlayer && values[i] < currentMinimaxValue)) {
+                    currentMinimaxValue = values[i];
+                    bestChildIndex = i;
+                }
+            }
+            childCounts[bestChildIndex] = childCounts[bestChildIndex] + 1;
+        }
+    }
+}
+
+void MonteCarloDataGenerator::_processSamples(GameState& workState, IntVector& childCounts, long long& nodesVisited, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation, SolutionStore* solutionStore, PartitionTable* partitionTable, const MonteCarloVoteCriterion voteCriterion, const bool useMultiWorldSearch, const int searchDepth, const StaticEvaluatorWeights& evaluatorWeights) {
+    if (useMultiWorldSearch && voteCriterion == kVoteForBestMinimaxValue && partitionTable == NULL && searchDepth == 0) {
+        _processSamplesInLockstep(workState, childCounts, nodesVisited, startIndex, endIndex, indexCombos, isMaxPlayer, opponentHandSize, possibleTiles, gameFoundation);
+        return;
+    }
+    IntVector winningChildIndices;
     for (int currentSampleNumber = startIndex; currentSampleNumber < endIndex; currentSampleNumber++) {
+        const TraceScope sampleScope("Sample Solve");
         const IntVector& indexCombo = indexCombos[currentSampleNumber];
         workState.children.clear();
         // set opponent hand to the sample hand
@@ -50,11 +120,36 @@ void MonteCarloDataGenerator::_processSamples(GameState& workState, IntVector& c
         for (int i = 0; i < opponentHandSize; i++) {
             opponentHand.push_back(possibleTiles[indexCombo[i]]);
         }
-        // alpha-beta this state. this will generate children and assign scores.
-        MinimaxData alphaBetaData = AlphaBetaMinimaxSearch::runOnState(workState, false);
-        assert(workState.children.size() > 0);
-        // find child with best score and increment its count
-        _updateChildCounts(isMaxPlayer, gameFoundation, workState, childCounts);
+        if (voteCriterion == kVoteForBestMinimaxValue && searchDepth > 0) {
+            // too many tiles left to solve every sample exactly, so vote on estimated values
+            MinimaxData depthLimitedData = AlphaBetaMinimaxSearch::runOnStateToDepth(workState, searchDepth, evaluatorWeights);
+            nodesVisited += depthLimitedData.nodesVisited;
+            assert(workState.children.size() > 0);
+            _updateChildCounts(isMaxPlayer, gameFoundation, workState, childCounts);
+        } else if (voteCriterion == kVoteForWinningMove) {
+            // prove which children win for the player to move and vote for each of them, so the tally counts the
+            // samples each move wins. a sample that loses whatever is played casts no vote.
+            int proofNodesVisited = 0;
+            ProofNumberSearch::winningChildIndices(workState, winningChildIndices, proofNodesVisited);
+            nodesVisited += proofNodesVisited;
+            assert(workState.children.size() > 0);
+            for (int i = 0; i < winningChildIndices.size(); i++) {
+                childCounts[winningChildIndices[i]] = childCounts[winningChildIndices[i]] + 1;
+            }
+        } else if (partitionTable != NULL) {
+            // the sampled hand belongs to the opponent of the player to move
+            MinimaxData partitionData = PartitionSearch::runOnState(workState, isMaxPlayer ? 1 : 0, *partitionTable);
+            nodesVisited += partitionData.nodesVisited;
+            assert(workState.children.size() > 0);
+            _updateChildCounts(isMaxPlayer, gameFoundation, workState, childCounts);
+        } else {
+            // alpha-beta this state. this will generate children and assign scores.
+            MinimaxData alphaBetaData = AlphaBetaMinimaxSearch::runOnState(workState, false, solutionStore);
+            nodesVisited += alphaBetaData.nodesVisited;
+            assert(workState.children.size() > 0);
+            // find child with best score and increment its count
+            _updateChildCounts(isMaxPlayer, gameFoundation, workState, childCounts);
+        }
         // if there is only one move (i.e. child), do not need to sample anymore since that's the move we must make
         if (workState.children.size() == 1) {
             break;
@@ -69,19 +164,12 @@ void MonteCarloDataGenerator::_addNewStateToPathAndUpdatePossibleTiles(const Gam
 
     bool passed = false;
 
-    // determine if player passed and remove layout ends from possible tiles if so
+    // determine if player passed
     if (fromState.children.size() == 1) {
         const DominoPointerVector& fromHand = isMaxPlayer ? fromState.maxPlayerHand : fromState.minPlayerHand;
         const DominoPointerVector& toHand = isMaxPlayer ? toState.maxPlayerHand : toState.minPlayerHand;
         if (fromHand.size() == toHand.size()) {
             passed = true;
-            DominoPointerVector& possibleTiles = isMaxPlayer ? game.possibleMaxPlayerTiles : game.possibleMinPlayerTiles;
-            for (int i = 0; i < possibleTiles.size(); i++) {
-                if (possibleTiles[i]->hasSuit(fromState.layoutEnds.first) || possibleTiles[i]->hasSuit(fromState.layoutEnds.second)) {
-                    possibleTiles.erase(possibleTiles.begin() + i);
-                    i--;
-                }
-            }
         }
     }
 
@@ -111,18 +199,8 @@ void MonteCarloDataGenerator::_addNewStateToPathAndUpdatePossibleTiles(const Gam
             }
         }
         assert((int)handToUpdate.size() == oldHandToUpdateSize - 1);
-
-        // update possible tiles
-        DominoPointerVector& possibleTiles = isMaxPlayer ? game.possibleMaxPlayerTiles : game.possibleMinPlayerTiles;
-        const int oldPossibleTilesSize = (int)possibleTiles.size();
-        for (int i = 0; i < possibleTiles.size(); i++) {
-            if (possibleTiles[i] == recommendedDomino) {
-                possibleTiles.erase(possibleTiles.begin() + i);
-                break;
-            }
-        }
-        assert((int)possibleTiles.size() == oldPossibleTilesSize - 1);
     }
+    updatePossibleTilesForMove(fromState, toState, game);
 
     // update turn and minimax score
     const int newTurnIndex = 1 - mostRecentState.playerTurnIndex;
@@ -136,65 +214,510 @@ void MonteCarloDataGenerator::_addNewStateToPathAndUpdatePossibleTiles(const Gam
     data.path.push_back(stateToAdd);
 }
 
-MonteCarloData MonteCarloDataGenerator::generateData(const Game &game, const GameState &initialState, const int numberOfSamples) {
-    const int hardwareCores = std::thread::hardware_concurrency();
-
-    MonteCarloData result;
-    result.path.push_back(initialState);
+void MonteCarloDataGenerator::updatePossibleTilesForMove(const GameState& fromState, const GameState& toState, Game& game) {
+    const GameFoundation& gameFoundation = game.gameFoundation;
+    uint64_t& possibleTiles = fromState.isMaxPlayer() ? game.possibleMaxPlayerTiles : game.possibleMinPlayerTiles;
+    if (toState.playedTiles.size() == fromState.playedTiles.size()) {
+        // a pass shows the player holds nothing that fits either end
+        possibleTiles &= ~(gameFoundation.suitTileMasks[fromState.layoutEnds.first] | gameFoundation.suitTileMasks[fromState.layoutEnds.second]);
+        return;
+    }
+    const uint64_t playedTile = gameFoundation.tileMaskForDomino(toState.playedTiles.back());
+    assert(possibleTiles & playedTile);
+    possibleTiles &= ~playedTile;
+}
 
-    Game workGame = game; // need a copy so we can update possible tiles
+int MonteCarloDataGenerator::_searchDepthForState(const GameState& state, const MonteCarloSettings& settings) {
+    const int tilesLeft = (int)(state.maxPlayerHand.size() + state.minPlayerHand.size());
+    if (settings.depthLimitedSearchDepth <= 0 || tilesLeft <= settings.exactSearchMaximumTiles) {
+        return 0;
+    }
+    return settings.depthLimitedSearchDepth;
+}
 
-    while (true) {
-        const GameState& mostRecentState = result.path.back();
+int MonteCarloDataGenerator::_openingBookChildIndex(const GameState& state, const OpeningBook& openingBook, GameState& workState) {
+    // only the first move is fully determined by the max player's hand
+    if (!state.playedTiles.empty() || !state.isMaxPlayer()) {
+        return -1;
+    }
+    const GameFoundation& gameFoundation = state.game.gameFoundation;
+    IntVector handIndices;
+    for (int i = 0; i < state.maxPlayerHand.size(); i++) {
+        handIndices.push_back(gameFoundation.indexForDomino(state.maxPlayerHand[i]));
+    }
+    std::sort(handIndices.begin(), handIndices.end());
+    OpeningBookEntry entry;
+    if (!openingBook.lookup(CombinationListCreator::indexForCombination(gameFoundation.numberOfDominoes, handIndices), entry)) {
+        return -1;
+    }
 
-        if (mostRecentState.isLeafNode()) {
-            break;
+    workState.expandAndGenerateChildren();
+    for (int i = 0; i < workState.children.size(); i++) {
+        if (gameFoundation.indexForDomino(workState.children[i].playedTiles.back()) == entry.bestTileIndex) {
+            return i;
         }
+    }
+    return -1;
+}
 
-        const bool isMaxPlayer = mostRecentState.isMaxPlayer();
-        const int opponentHandSize = isMaxPlayer ? (int)mostRecentState.minPlayerHand.size() : (int)mostRecentState.maxPlayerHand.size();
-        const DominoPointerVector& possibleTiles = isMaxPlayer ? workGame.possibleMinPlayerTiles : workGame.possibleMaxPlayerTiles;
+int MonteCarloDataGenerator::_shuffledIndexCombos(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, IntVectorVector& indexCombos, DominoPointerVector& possibleTiles) {
+    const bool isMaxPlayer = state.isMaxPlayer();
+    const int opponentHandSize = isMaxPlayer ? (int)state.minPlayerHand.size() : (int)state.maxPlayerHand.size();
+    const HandSampler handSampler(workGame.gameFoundation, isMaxPlayer ? workGame.possibleMinPlayerTiles : workGame.possibleMaxPlayerTiles, opponentHandSize);
+    possibleTiles = handSampler.getCandidates();
 
-        IntVectorVector indexCombos = CombinationListCreator().listOfCombinationIndices((int)possibleTiles.size(), opponentHandSize);
-        const unsigned int seed = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
-        std::shuffle(std::begin(indexCombos), std::end(indexCombos), std::default_random_engine(seed));
+    const unsigned int seed = settings.seed != 0 ? settings.seed + (unsigned int)state.depth : (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
+    std::default_random_engine engine(seed);
 
-        const int samplesToUse = std::min(numberOfSamples, (int)indexCombos.size());
+    // when the samples cover a good part of the hands, enumerating them all is cheaper than drawing distinct ones
+    if (handSampler.numberOfHands() <= 2.0 * settings.numberOfSamples) {
+        indexCombos = CombinationListCreator().listOfCombinationIndices((int)possibleTiles.size(), opponentHandSize);
+        std::shuffle(std::begin(indexCombos), std::end(indexCombos), engine);
+        return std::min(settings.numberOfSamples, (int)indexCombos.size());
+    }
 
-        // sample random hands to find best move
-        const int cores = samplesToUse > hardwareCores ? hardwareCores : 1;
-        const int segmentSize = samplesToUse / cores;
-        IntVectorVector childCountsByCore;
-        std::vector<GameState> workStatesByCore;
-        for (int i = 0; i < cores; i++) {
-            childCountsByCore.push_back(IntVector(game.gameFoundation.handSize, 0));
-            workStatesByCore.push_back(GameState::stateForMonteCarloSampling(mostRecentState));
+    indexCombos.clear();
+    std::unordered_set<uint64_t> drawnHands;
+    while (indexCombos.size() < settings.numberOfSamples) {
+        IntVector indexCombo = handSampler.sample(engine);
+        if (drawnHands.insert(handSampler.maskForSample(indexCombo)).second) {
+            indexCombos.push_back(indexCombo);
         }
+    }
+    return settings.numberOfSamples;
+}
+
+// what one sampling thread of a move reads and writes. its thread allocates it after being placed, so it is in that
+// thread's node-local memory, and the padding keeps two workers from ever writing the same cache line.
+struct MonteCarloWorker {
+    MonteCarloWorker(const GameState& state, const int maxNumberOfChildren) : workState(GameState::stateForMonteCarloSampling(state)), childCounts(maxNumberOfChildren, 0), nodesVisited(0) {}
+
+    char leadingPadding[kCacheLineSize];
+    GameState workState;
+    IntVector childCounts;
+    long long nodesVisited;
+    IntVectorVector indexCombos; // this worker's share of the samples, copied so they are read from local memory
+    DominoPointerVector possibleTiles; // what indexCombos index, copied for the same reason
+    char trailingPadding[kCacheLineSize];
+};
+
+void MonteCarloDataGenerator::_runWorker(std::unique_ptr<MonteCarloWorker>& worker, const int workerIndex, const GameState& state, const int maxNumberOfChildren, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable) {
+    CpuTopology::current().placeCurrentThread(settings.threadPlacement, workerIndex);
+    worker.reset(new MonteCarloWorker(state, maxNumberOfChildren));
+    worker->indexCombos.assign(indexCombos.begin() + startIndex, indexCombos.begin() + endIndex);
+    worker->possibleTiles = possibleTiles;
+
+    const bool isMaxPlayer = state.isMaxPlayer();
+    const int opponentHandSize = isMaxPlayer ? (int)state.minPlayerHand.size() : (int)state.maxPlayerHand.size();
+    _processSamples(worker->workState, worker->childCounts, worker->nodesVisited, 0, endIndex - startIndex, worker->indexCombos, isMaxPlayer, opponentHandSize, worker->possibleTiles, gameFoundation, solutionStore, partitionTable, settings.voteCriterion, settings.useMultiWorldSearch, _searchDepthForState(state, settings), settings.evaluatorWeights);
+}
+
+IntVector MonteCarloDataGenerator::_voteOnMove(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable, MonteCarloWorkerVector& workers, long long& nodesVisited) {
+    const GameFoundation& gameFoundation = workGame.gameFoundation;
+    const int hardwareCores = settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+
+    const bool isMaxPlayer = state.isMaxPlayer();
+    const int opponentHandSize = isMaxPlayer ? (int)state.minPlayerHand.size() : (int)state.maxPlayerHand.size();
+
+    IntVectorVector indexCombos;
+    DominoPointerVector possibleTiles;
+    Tracer::begin("Draw Samples");
+    const int samplesToUse = _shuffledIndexCombos(state, workGame, settings, indexCombos, possibleTiles);
+    Tracer::end("Draw Samples");
+
+    // a tile that fits both layout ends makes two children, so a state can have up to twice as many children as tiles
+    const int maxNumberOfChildren = 2 * gameFoundation.handSize;
+
+    // sample random hands to find best move
+    const int cores = samplesToUse > hardwareCores ? hardwareCores : 1;
+    const int segmentSize = samplesToUse / cores;
+    workers.clear();
+    workers.resize(cores);
+    if (cores == 1) {
+        // no thread to start, and the sampling shows up in the caller's cpu time
+        workers[0].reset(new MonteCarloWorker(state, maxNumberOfChildren));
+        _processSamples(workers[0]->workState, workers[0]->childCounts, workers[0]->nodesVisited, 0, samplesToUse, indexCombos, isMaxPlayer, opponentHandSize, possibleTiles, gameFoundation, solutionStore, partitionTable, settings.voteCriterion, settings.useMultiWorldSearch, _searchDepthForState(state, settings), settings.evaluatorWeights);
+    } else {
+        // each worker places its own thread and builds its state and sample copies there, see _runWorker
         std::vector<std::thread> threads;
+        Tracer::begin("Start Threads");
         for (int i = 0; i < cores; i++) {
             const int startIndex = i * segmentSize;
             const int endIndex = (i == cores - 1) ? samplesToUse : std::min(startIndex + segmentSize, samplesToUse);
-            threads.push_back(std::thread(_processSamples, std::ref(workStatesByCore[i]), std::ref(childCountsByCore[i]), startIndex, endIndex, std::ref(indexCombos), isMaxPlayer, opponentHandSize, std::ref(possibleTiles), std::ref(game.gameFoundation)));
+            threads.push_back(std::thread(_runWorker, std::ref(workers[i]), i, std::cref(state), maxNumberOfChildren, startIndex, endIndex, std::cref(indexCombos), std::cref(possibleTiles), std::cref(gameFoundation), std::cref(settings), solutionStore, partitionTable));
         }
+        Tracer::end("Start Threads");
+        Tracer::begin("Join Threads");
         for (int i = 0; i < threads.size(); i++) {
             threads[i].join();
         }
-        IntVector childCounts(game.gameFoundation.handSize, 0);
-        for (int i = 0; i < cores; i++) {
-            for (int j = 0; j < game.gameFoundation.handSize; j++) {
-                childCounts[j] = childCounts[j] + childCountsByCore[i][j];
+        Tracer::end("Join Threads");
+    }
+    const TraceScope mergeScope("Merge Votes");
+    IntVector childCounts(maxNumberOfChildren, 0);
+    for (int i = 0; i < cores; i++) {
+        for (int j = 0; j < maxNumberOfChildren; j++) {
+            childCounts[j] = childCounts[j] + workers[i]->childCounts[j];
+        }
+        nodesVisited += workers[i]->nodesVisited;
+    }
+    return childCounts;
+}
+
+int MonteCarloDataGenerator::_bestChildIndexForLostPosition(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable, long long& nodesVisited) {
+    MonteCarloSettings exactSettings = settings;
+    exactSettings.voteCriterion = kVoteForBestMinimaxValue;
+    MonteCarloWorkerVector workers;
+    const int bestChildIndex = _getBestChildIndex(_voteOnMove(state, workGame, exactSettings, solutionStore, partitionTable, workers, nodesVisited));
+    // every sample casts an exact vote
+    assert(bestChildIndex >= 0);
+    return bestChildIndex;
+}
+
+IntVector MonteCarloDataGenerator::voteCountsForState(const Game& game, const GameState& state, const MonteCarloSettings& settings, DominoPointerVector& childTiles) {
+    MonteCarloWorkerVector workers;
+    long long nodesVisited = 0;
+    std::unique_ptr<SolutionStore> solutionStore;
+    if (settings.persistentSolutionCache != NULL) {
+        solutionStore.reset(new SolutionStore(kDefaultSolutionStoreSizeLog2, settings.persistentSolutionCache));
+    }
+    PartitionTable partitionTable;
+    IntVector childCounts = _voteOnMove(state, game, settings, solutionStore.get(), settings.usePartitionSearch ? &partitionTable : NULL, workers, nodesVisited);
+
+    const GameState& workState = workers[0]->workState;
+    childTiles.clear();
+    for (int i = 0; i < workState.children.size(); i++) {
+        const GameState& child = workState.children[i];
+        // a pass plays no tile
+        childTiles.push_back(child.playedTiles.size() > workState.playedTiles.size() ? child.playedTiles.back() : NULL);
+    }
+    childCounts.resize(workState.children.size());
+    return childCounts;
+}
+
+MonteCarloData MonteCarloDataGenerator::generateData(const Game &game, const GameState &initialState, const int numberOfSamples) {
+    return generateData(game, initialState, MonteCarloSettings(numberOfSamples));
+}
+
+MonteCarloData MonteCarloDataGenerator::generateData(const Game &game, const GameState &initialState, const MonteCarloSettings& settings) {
+    MonteCarloData result;
+    result.path.push_back(initialState);
+
+    Game workGame = game; // need a copy so we can update possible tiles
+
+    // solved positions from earlier moves stay valid for the rest of the game, so later moves search warm.
+    // the store's table is large, so it is only allocated when reuse is on.
+    std::unique_ptr<SolutionStore> solutionStore;
+    if (settings.reuseSolutions) {
+        solutionStore.reset(new SolutionStore(kDefaultSolutionStoreSizeLog2, settings.persistentSolutionCache));
+    }
+    std::unique_ptr<PartitionTable> partitionTable;
+    if (settings.usePartitionSearch) {
+        partitionTable.reset(new PartitionTable());
+    }
+
+    while (true) {
+        const GameState& mostRecentState = result.path.back();
+
+        if (mostRecentState.isLeafNode()) {
+            break;
+        }
+
+        const auto moveStart = std::chrono::high_resolution_clock::now();
+        const TraceScope moveScope("Move");
+
+        MonteCarloWorkerVector workers;
+        long long moveNodesVisited = 0;
+        int bestChildIndex = -1;
+
+        if (settings.openingBook != NULL) {
+            workers.push_back(std::unique_ptr<MonteCarloWorker>(new MonteCarloWorker(mostRecentState, 0)));
+            bestChildIndex = _openingBookChildIndex(mostRecentState, *settings.openingBook, workers[0]->workState);
+            if (bestChildIndex >= 0) {
+                result.openingBookMoves++;
+            }
+        }
+
+        if (bestChildIndex < 0) {
+            const IntVector childCounts = _voteOnMove(mostRecentState, workGame, settings, solutionStore.get(), partitionTable.get(), workers, moveNodesVisited);
+            // get best move from all samples (will have highest count in childIndexCounts)
+            bestChildIndex = _getBestChildIndex(childCounts);
+            if (bestChildIndex < 0) {
+                bestChildIndex = _bestChildIndexForLostPosition(mostRecentState, workGame, settings, solutionStore.get(), partitionTable.get(), moveNodesVisited);
             }
         }
 
-        // get best move from all samples (will have highest count in childIndexCounts)
-        GameState& workState = workStatesByCore[0];
-        const int bestChildIndex = _getBestChildIndex(childCounts);
+        GameState& workState = workers[0]->workState;
         const GameState bestChildRemovingChildren = GameState::stateRemovingChildren(workState.children[bestChildIndex]);
 
         // add state to path
+        Tracer::begin("Add State To Path");
         _addNewStateToPathAndUpdatePossibleTiles(workState, bestChildRemovingChildren, mostRecentState, workGame, result);
+        Tracer::end("Add State To Path");
+
+        const auto moveFinish = std::chrono::high_resolution_clock::now();
+        const std::chrono::duration<double> moveElapsed = moveFinish - moveStart;
+        result.moveDurations.push_back(moveElapsed.count());
+        result.moveNodesVisited.push_back(moveNodesVisited);
+    }
+
+    if (solutionStore) {
+        result.solutionStoreHits = solutionStore->getHits();
+        result.solutionStorePersistentHits = solutionStore->getPersistentHits();
+        result.solutionStoreSize = solutionStore->size();
+    }
+    if (partitionTable) {
+        result.partitionTableHits = partitionTable->getHits();
     }
 
     return result;
 }
 
+
+// one game being played by the shared pool. chunks of the current move's samples are handed out to workers,
+// and whichever worker returns the last chunk picks the move and prepares the next one.
+struct MonteCarloGameJob {
+    MonteCarloGameJob(const Game& game, const int gameIndex, const MonteCarloSettings& settings) : workGame(game), gameIndex(gameIndex), samplesToUse(0), nextSample(0), chunksOutstanding(0), moveNodesVisited(0), advancing(true), finished(false) {
+        data.path.push_back(GameState(game));
+        if (settings.reuseSolutions) {
+            solutionStore.reset(new SolutionStore(kDefaultSolutionStoreSizeLog2, settings.persistentSolutionCache));
+        }
+        if (settings.usePartitionSearch) {
+            partitionTable.reset(new PartitionTable());
+        }
+    }
+
+    Game workGame; // copy so possible tiles can be updated
+    const int gameIndex;
+    MonteCarloData data;
+    std::unique_ptr<SolutionStore> solutionStore;
+    std::unique_ptr<PartitionTable> partitionTable;
+
+    // current move
+    GameStateVector moveStates; // the state to move from, with its children
+    IntVectorVector indexCombos;
+    DominoPointerVector possibleTiles; // what indexCombos index
+    int samplesToUse;
+    int nextSample; // first sample not yet handed to a worker
+    int chunksOutstanding;
+    IntVector childCounts;
+    long long moveNodesVisited;
+    std::chrono::high_resolution_clock::time_point moveStart;
+    bool advancing; // a worker is finishing a move or preparing the next one, so there is nothing to hand out
+    bool finished;
+};
+
+struct MonteCarloGamePool {
+    MonteCarloGamePool(const GameVector& games, const MonteCarloSettings& settings, const int numberOfThreads, MonteCarloDataVector& results) : games(games), settings(settings), maxGamesInFlight(kMonteCarloGamesInFlightPerThread * numberOfThreads), numberOfThreads(numberOfThreads), nextGameIndex(0), gamesCompleted(0), results(results) {}
+
+    const GameVector& games;
+    const MonteCarloSettings& settings;
+    const int maxGamesInFlight;
+    const int numberOfThreads;
+
+    std::mutex lock;
+    std::condition_variable changed;
+    std::list<std::unique_ptr<MonteCarloGameJob>> jobs; // oldest first, so games in flight finish steadily
+    int nextGameIndex;
+    int gamesCompleted;
+    MonteCarloDataVector& results;
+};
+
+void MonteCarloDataGenerator::_finishMove(MonteCarloGameJob& job, const int bestChildIndex) {
+    const TraceScope finishScope("Finish Move");
+    const GameState& mostRecentState = job.data.path.back();
+    GameState& workState = job.moveStates[0];
+    const GameState bestChildRemovingChildren = GameState::stateRemovingChildren(workState.children[bestChildIndex]);
+    _addNewStateToPathAndUpdatePossibleTiles(workState, bestChildRemovingChildren, mostRecentState, job.workGame, job.data);
+
+    const std::chrono::duration<double> moveElapsed = std::chrono::high_resolution_clock::now() - job.moveStart;
+    job.data.moveDurations.push_back(moveElapsed.count());
+    job.data.moveNodesVisited.push_back(job.moveNodesVisited);
+}
+
+void MonteCarloDataGenerator::_startMove(MonteCarloGameJob& job, const MonteCarloSettings& settings) {
+    const TraceScope startScope("Start Move");
+    // moves that need no sampling are played right away
+    while (true) {
+        const GameState& mostRecentState = job.data.path.back();
+        if (mostRecentState.isLeafNode()) {
+            job.finished = true;
+            job.samplesToUse = 0;
+            job.nextSample = 0;
+            if (job.solutionStore) {
+                job.data.solutionStoreHits = job.solutionStore->getHits();
+                job.data.solutionStorePersistentHits = job.solutionStore->getPersistentHits();
+                job.data.solutionStoreSize = job.solutionStore->size();
+            }
+            if (job.partitionTable) {
+                job.data.partitionTableHits = job.partitionTable->getHits();
+            }
+            return;
+        }
+
+        job.moveStart = std::chrono::high_resolution_clock::now();
+        job.moveNodesVisited = 0;
+        job.moveStates.clear();
+        job.moveStates.push_back(GameState::stateForMonteCarloSampling(mostRecentState));
+        GameState& workState = job.moveStates[0];
+
+        int bestChildIndex = -1;
+        if (settings.openingBook != NULL) {
+            bestChildIndex = _openingBookChildIndex(mostRecentState, *settings.openingBook, workState);
+            if (bestChildIndex >= 0) {
+                job.data.openingBookMoves++;
+            }
+        }
+        if (bestChildIndex < 0) {
+            workState.children.clear();
+            workState.expandAndGenerateChildren();
+            if (workState.children.size() == 1) {
+                bestChildIndex = 0;
+            }
+        }
+        if (bestChildIndex >= 0) {
+            _finishMove(job, bestChildIndex);
+            continue;
+        }
+
+        job.samplesToUse = _shuffledIndexCombos(mostRecentState, job.workGame, settings, job.indexCombos, job.possibleTiles);
+        job.nextSample = 0;
+        job.childCounts.assign(2 * job.workGame.gameFoundation.handSize, 0);
+        return;
+    }
+}
+
+void MonteCarloDataGenerator::_poolWorker(MonteCarloGamePool& pool, const int workerIndex, double& busy) {
+    typedef std::chrono::high_resolution_clock Clock;
+    const MonteCarloSettings& settings = pool.settings;
+    CpuTopology::current().placeCurrentThread(settings.threadPlacement, workerIndex);
+    // busy times of neighbouring workers share a cache line, so each is written once on return
+    double busyTime = 0.0;
+
+    std::unique_lock<std::mutex> guard(pool.lock);
+    while (true) {
+        MonteCarloGameJob* job = NULL;
+        for (auto it = pool.jobs.begin(); it != pool.jobs.end(); ++it) {
+            if (!(*it)->advancing && (*it)->nextSample < (*it)->samplesToUse) {
+                job = it->get();
+                break;
+            }
+        }
+
+        if (job == NULL && pool.nextGameIndex < pool.games.size() && pool.jobs.size() < pool.maxGamesInFlight) {
+            const int gameIndex = pool.nextGameIndex++;
+            pool.jobs.push_back(std::unique_ptr<MonteCarloGameJob>(new MonteCarloGameJob(pool.games[gameIndex], gameIndex, settings)));
+            job = pool.jobs.back().get();
+        } else if (job != NULL) {
+            // split the move so every worker can take a share, in multiples of the lockstep width when that is used
+            int chunkSize = std::max(1, (job->samplesToUse + pool.numberOfThreads - 1) / pool.numberOfThreads);
+            if (settings.useMultiWorldSearch) {
+                chunkSize = ((chunkSize + kMultiWorldWidth - 1) / kMultiWorldWidth) * kMultiWorldWidth;
+            }
+            const int startIndex = job->nextSample;
+            const int endIndex = std::min(startIndex + chunkSize, job->samplesToUse);
+            job->nextSample = endIndex;
+            job->chunksOutstanding++;
+            guard.unlock();
+
+            const auto chunkStart = Clock::now();
+            const GameState& state = job->data.path.back();
+            const bool isMaxPlayer = state.isMaxPlayer();
+            const int opponentHandSize = isMaxPlayer ? (int)state.minPlayerHand.size() : (int)state.maxPlayerHand.size();
+            GameState workState = GameState::stateForMonteCarloSampling(state);
+            IntVector childCounts(job->childCounts.size(), 0);
+            long long nodesVisited = 0;
+            _processSamples(workState, childCounts, nodesVisited, startIndex, endIndex, job->indexCombos, isMaxPlayer, opponentHandSize, job->possibleTiles, job->workGame.gameFoundation, job->solutionStore.get(), job->partitionTable.get(), settings.voteCriterion, settings.useMultiWorldSearch, _searchDepthForState(state, settings), settings.evaluatorWeights);
+            const std::chrono::duration<double> chunkElapsed = Clock::now() - chunkStart;
+            busyTime += chunkElapsed.count();
+
+            guard.lock();
+            for (int i = 0; i < childCounts.size(); i++) {
+                job->childCounts[i] += childCounts[i];
+            }
+            job->moveNodesVisited += nodesVisited;
+            job->chunksOutstanding--;
+            if (job->nextSample < job->samplesToUse || job->chunksOutstanding > 0) {
+                continue;
+            }
+            job->advancing = true;
+        } else {
+            if (pool.jobs.empty() && pool.nextGameIndex >= pool.games.size()) {
+                pool.changed.notify_all();
+                busy = busyTime;
+                return;
+            }
+            pool.changed.wait(guard);
+            continue;
+        }
+
+        // this worker owns the job until advancing is cleared: finish the voted move if there was one and prepare the next
+        guard.unlock();
+        const auto advanceStart = Clock::now();
+        if (job->samplesToUse > 0) {
+            int bestChildIndex = _getBestChildIndex(job->childCounts);
+            if (bestChildIndex < 0) {
+                // the other workers are busy with other games, so this vote runs on this worker alone
+                MonteCarloSettings workerSettings = settings;
+                workerSettings.numberOfThreads = 1;
+                bestChildIndex = _bestChildIndexForLostPosition(job->data.path.back(), job->workGame, workerSettings, job->solutionStore.get(), job->partitionTable.get(), job->moveNodesVisited);
+            }
+            job->samplesToUse = 0;
+            _finishMove(*job, bestChildIndex);
+        }
+        _startMove(*job, settings);
+        const std::chrono::duration<double> advanceElapsed = Clock::now() - advanceStart;
+        busyTime += advanceElapsed.count();
+
+        guard.lock();
+        job->advancing = false;
+        if (job->finished) {
+            pool.results[job->gameIndex] = std::move(job->data);
+            pool.gamesCompleted++;
+            for (auto it = pool.jobs.begin(); it != pool.jobs.end(); ++it) {
+                if (it->get() == job) {
+                    pool.jobs.erase(it);
+                    break;
+                }
+            }
+        }
+        pool.changed.notify_all();
+    }
+}
+
+static double processCpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)usage.ru_utime.tv_sec + (double)usage.ru_utime.tv_usec / 1000000.0 + (double)usage.ru_stime.tv_sec + (double)usage.ru_stime.tv_usec / 1000000.0;
+}
+
+MonteCarloDataVector MonteCarloDataGenerator::generateDataForGames(const GameVector& games, const MonteCarloSettings& settings, MonteCarloPoolData& poolData) {
+    const int numberOfThreads = settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+
+    MonteCarloDataVector results(games.size());
+    MonteCarloGamePool pool(games, settings, numberOfThreads, results);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const double cpuStart = processCpuSeconds();
+
+    std::vector<double> busyByThread(numberOfThreads, 0.0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.push_back(std::thread(_poolWorker, std::ref(pool), i, std::ref(busyByThread[i])));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    poolData.gamesCompleted = pool.gamesCompleted;
+    poolData.numberOfThreads = numberOfThreads;
+    poolData.elapsed = elapsed.count();
+    poolData.processCpuTime = processCpuSeconds() - cpuStart;
+    poolData.workerBusy = 0.0;
+    for (int i = 0; i < numberOfThreads; i++) {
+        poolData.workerBusy += busyByThread[i];
+    }
+
+    return results;
+}
@@ -7,20 +7,64 @@
 #ifndef MonteCarloDataGenerator_hpp
 #define MonteCarloDataGenerator_hpp
 
+#include <memory>
+
 #include "Game.hpp"
 #include "GameState.hpp"
 #include "MonteCarloData.hpp"
+#include "MonteCarloPoolData.hpp"
+#include "MonteCarloSettings.hpp"
+#include "PartitionTable.hpp"
+#include "SolutionStore.hpp"
 
 typedef std::vector<IntVector> IntVectorVector;
+typedef std::vector<Game> GameVector;
+typedef std::vector<MonteCarloData> MonteCarloDataVector;
+
+static const int kMonteCarloGamesInFlightPerThread = 2; // games the shared pool keeps started, so short moves still fill every core
+
+struct MonteCarloGameJob;
+struct MonteCarloGamePool;
+struct MonteCarloWorker;
+
+typedef std::vector<std::unique_ptr<MonteCarloWorker>> MonteCarloWorkerVector;
 
 class MonteCarloDataGenerator {
 private:
     static void _updateChildCounts(const bool isMaxPlayer, const GameFoundation& gameFoundation, GameState& workState, IntVector& childCounts);
-    static int _getBestChildIndex(IntVector& childCounts);
+    static int _getBestChildIndex(const IntVector& childCounts);
     static void _addNewStateToPathAndUpdatePossibleTiles(const GameState& fromState, const GameState& toState, const GameState& mostRecentState, Game& game, MonteCarloData& data);
-    static void _processSamples(GameState& workState, IntVector& childCounts, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation);
+    static void _processSamplesInLockstep(GameState& workState, IntVector& childCounts, long long& nodesVisited, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation);
+    static void _processSamples(GameState& workState, IntVector& childCounts, long long& nodesVisited, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const bool isMaxPlayer, const int opponentHandSize, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation, SolutionStore* solutionStore, PartitionTable* partitionTable, const MonteCarloVoteCriterion voteCriterion, const bool useMultiWorldSearch, const int searchDepth, const StaticEvaluatorWeights& evaluatorWeights);
+    // the depth-limited search depth for the samples of state, or 0 to solve them exactly
+    static int _searchDepthForState(const GameState& state, const MonteCarloSettings& settings);
+    static int _openingBookChildIndex(const GameState& state, const OpeningBook& openingBook, GameState& workState);
+    // fills possibleTiles with the tiles the opponent may hold and indexCombos with distinct opponent hands (positions
+    // into possibleTiles) in sampling order, and returns how many to sample. small sets are enumerated, larger ones drawn.
+    static int _shuffledIndexCombos(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, IntVectorVector& indexCombos, DominoPointerVector& possibleTiles);
+    // places the calling thread as worker workerIndex, then allocates worker there and samples startIndex to endIndex
+    static void _runWorker(std::unique_ptr<MonteCarloWorker>& worker, const int workerIndex, const GameState& state, const int maxNumberOfChildren, const int startIndex, const int endIndex, const IntVectorVector& indexCombos, const DominoPointerVector& possibleTiles, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable);
+    // leaves the move's root, with its children, in workers[0]->workState
+    static IntVector _voteOnMove(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable, MonteCarloWorkerVector& workers, long long& nodesVisited);
+    // when voting for winning moves and every sample is lost whatever is played, no child gets a vote. the exact
+    // vote over the samples then picks the move that most often loses by the least.
+    static int _bestChildIndexForLostPosition(const GameState& state, const Game& workGame, const MonteCarloSettings& settings, SolutionStore* solutionStore, PartitionTable* partitionTable, long long& nodesVisited);
+    static void _finishMove(MonteCarloGameJob& job, const int bestChildIndex);
+    static void _startMove(MonteCarloGameJob& job, const MonteCarloSettings& settings);
+    static void _poolWorker(MonteCarloGamePool& pool, const int workerIndex, double& busy);
 public:
+    // removes what a move shows about the mover's hand from its possible tiles in game: the tile played, or on a
+    // pass every tile that fits either end
+    static void updatePossibleTilesForMove(const GameState& fromState, const GameState& toState, Game& game);
+    // sample votes for each child of state, with the tile each child plays (NULL for a pass).
+    // the samples share a solution store only when settings has a persistent cache to put behind it.
+    static IntVector voteCountsForState(const Game& game, const GameState& state, const MonteCarloSettings& settings, DominoPointerVector& childTiles);
     static MonteCarloData generateData(const Game& game, const GameState& initialState, const int numberOfSamples);
+    static MonteCarloData generateData(const Game& game, const GameState& initialState, const MonteCarloSettings& settings);
+    // plays every game from its initial state on one shared pool of settings.numberOfThreads workers. the pool samples
+    // moves of several games at once, so moves with fewer samples than cores still keep every core busy.
+    // games must outlive the returned data, which is in the same order.
+    static MonteCarloDataVector generateDataForGames(const GameVector& games, const MonteCarloSettings& settings, MonteCarloPoolData& poolData);
 };
 
 #endif /* MonteCarloDataGenerator_hpp */
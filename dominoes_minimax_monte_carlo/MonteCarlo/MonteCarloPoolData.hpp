@@ -0,0 +1,46 @@
+//
+//  MonteCarloPoolData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MonteCarloPoolData_hpp
+#define MonteCarloPoolData_hpp
+
+#include <string>
+
+struct MonteCarloPoolData {
+    MonteCarloPoolData() : gamesCompleted(0), numberOfThreads(0), elapsed(0.0), workerBusy(0.0), processCpuTime(0.0) {}
+
+    int gamesCompleted;
+    int numberOfThreads;
+    double elapsed; // wall clock seconds for all games
+    double workerBusy; // summed seconds the pool's workers spent sampling or advancing games
+    double processCpuTime; // user + system seconds for the whole process over the same interval
+
+    inline double getGamesPerHour() const {
+        return elapsed > 0.0 ? (3600.0 * (double)gamesCompleted) / elapsed : 0.0;
+    }
+
+    // fraction of the pool's cores that were doing work
+    inline double getCpuUtilization() const {
+        return elapsed > 0.0 && numberOfThreads > 0 ? processCpuTime / (elapsed * (double)numberOfThreads) : 0.0;
+    }
+
+    inline double getWorkerUtilization() const {
+        return elapsed > 0.0 && numberOfThreads > 0 ? workerBusy / (elapsed * (double)numberOfThreads) : 0.0;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Games Completed: " + std::to_string(gamesCompleted) + "\n";
+        result += "Threads: " + std::to_string(numberOfThreads) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        result += "Games Per Hour: " + std::to_string(getGamesPerHour()) + "\n";
+        result += "CPU Utilization: " + std::to_string(100.0 * getCpuUtilization()) + " %\n";
+        result += "Worker Utilization: " + std::to_string(100.0 * getWorkerUtilization()) + " %\n";
+        return result;
+    }
+};
+
+#endif /* MonteCarloPoolData_hpp */
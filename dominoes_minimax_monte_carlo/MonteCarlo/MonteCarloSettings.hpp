@@ -0,0 +1,54 @@
+//
+//  MonteCarloSettings.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MonteCarloSettings_hpp
+#define MonteCarloSettings_hpp
+
+#include <stdio.h>
+
+#include "CpuTopology.hpp"
+#include "StaticEvaluator.hpp"
+
+class OpeningBook;
+class PersistentSolutionCache;
+
+static const int kDefaultNumberOfSamples = 100;
+static const int kDefaultExactSearchMaximumTiles = 10;
+
+enum MonteCarloVoteCriterion {
+    kVoteForBestMinimaxValue, // each sample is solved exactly and votes for its best child
+    kVoteForWinningMove // each sample is only proven win/loss and votes for every child that wins, which is much cheaper
+};
+
+struct MonteCarloSettings {
+    MonteCarloSettings(int numberOfSamples = kDefaultNumberOfSamples, bool reuseSolutions = true, unsigned int seed = 0) : numberOfSamples(numberOfSamples), reuseSolutions(reuseSolutions), seed(seed) {
+        numberOfThreads = 0;
+        openingBook = NULL;
+        persistentSolutionCache = NULL;
+        voteCriterion = kVoteForBestMinimaxValue;
+        usePartitionSearch = false;
+        useMultiWorldSearch = false;
+        depthLimitedSearchDepth = 0;
+        exactSearchMaximumTiles = kDefaultExactSearchMaximumTiles;
+        threadPlacement = kThreadPlacementNone;
+    }
+
+    int numberOfSamples;
+    bool reuseSolutions; // keep solved positions across the moves of a game
+    unsigned int seed; // 0 uses a time-based seed for every move
+    int numberOfThreads; // sampling threads per move. 0 uses every hardware core
+    const OpeningBook* openingBook; // answers the first max player move without sampling when it has the hand
+    PersistentSolutionCache* persistentSolutionCache; // behind each game's solution store, so only used with reuseSolutions
+    MonteCarloVoteCriterion voteCriterion;
+    bool usePartitionSearch; // solve samples with PartitionSearch, sharing results between samples that differ in unplayed hidden tiles
+    bool useMultiWorldSearch; // solve samples kMultiWorldWidth at a time with MultiWorldSearch. only used with kVoteForBestMinimaxValue and no partition search
+    int depthLimitedSearchDepth; // > 0 searches samples only this many plies, with StaticEvaluator below that. only used with kVoteForBestMinimaxValue
+    int exactSearchMaximumTiles; // positions with at most this many tiles left in both hands are always solved exactly
+    StaticEvaluatorWeights evaluatorWeights;
+    ThreadPlacement threadPlacement; // where sampling threads run. see CpuTopology
+};
+
+#endif /* MonteCarloSettings_hpp */
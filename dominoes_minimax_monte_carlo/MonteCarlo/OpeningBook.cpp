@@ -0,0 +1,104 @@
+//
+//  OpeningBook.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "OpeningBook.hpp"
+#include "CombinationListCreator.hpp"
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::headerMatches(const OpeningBookHeader& header, const GameFoundation& gameFoundation) {
+    return memcmp(header.magic, kOpeningBookMagic, sizeof(kOpeningBookMagic)) == 0 &&
+           header.version == kOpeningBookVersion &&
+           header.handSize == (uint32_t)gameFoundation.handSize &&
+           header.maxDominoSuit == (uint32_t)gameFoundation.maxDominoSuit &&
+           header.numberOfRecords == (uint32_t)CombinationListCreator::numberOfCombinations(gameFoundation.numberOfDominoes, gameFoundation.handSize) &&
+           header.recordSize == recordSizeForHandSize(gameFoundation.handSize);
+}
+
+bool OpeningBook::open(const std::string& path, const GameFoundation& gameFoundation) {
+    close();
+
+    const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < (off_t)sizeof(OpeningBookHeader)) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    void* mapping = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor); // the mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const OpeningBookHeader* header = (const OpeningBookHeader*)mapping;
+    const size_t expectedSize = sizeof(OpeningBookHeader) + ((size_t)header->numberOfRecords * header->recordSize);
+    if (!headerMatches(*header, gameFoundation) || (size_t)fileStatus.st_size < expectedSize) {
+        munmap(mapping, (size_t)fileStatus.st_size);
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappingSize = (size_t)fileStatus.st_size;
+    _header = header;
+    _records = (const uint8_t*)mapping + sizeof(OpeningBookHeader);
+    return true;
+}
+
+void OpeningBook::close() {
+    if (_mapping != NULL) {
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = NULL;
+    _mappingSize = 0;
+    _header = NULL;
+    _records = NULL;
+}
+
+bool OpeningBook::lookup(const int maxPlayerHandNumber, OpeningBookEntry& entry) const {
+    if (!isOpen() || maxPlayerHandNumber < 0 || maxPlayerHandNumber >= (int)_header->numberOfRecords) {
+        return false;
+    }
+    const uint8_t* record = _records + ((size_t)maxPlayerHandNumber * _header->recordSize);
+    const int handSize = (int)_header->handSize;
+    if (record[0] == kOpeningBookEmptyRecord || record[0] >= handSize) {
+        return false;
+    }
+
+    const int numberOfDominoes = ((_header->maxDominoSuit + 1) * (_header->maxDominoSuit + 2)) / 2;
+    entry.tileIndices = CombinationListCreator::combinationForIndex(numberOfDominoes, handSize, maxPlayerHandNumber);
+    entry.bestTileIndex = entry.tileIndices[record[0]];
+    entry.votes.clear();
+    for (int i = 0; i < handSize; i++) {
+        uint16_t votes;
+        memcpy(&votes, record + 2 + (2 * i), sizeof(votes));
+        entry.votes.push_back(votes);
+    }
+    return true;
+}
+
+int OpeningBook::numberOfBuiltRecords() const {
+    if (!isOpen()) {
+        return 0;
+    }
+    int result = 0;
+    for (uint32_t i = 0; i < _header->numberOfRecords; i++) {
+        if (_records[(size_t)i * _header->recordSize] != kOpeningBookEmptyRecord) {
+            result++;
+        }
+    }
+    return result;
+}
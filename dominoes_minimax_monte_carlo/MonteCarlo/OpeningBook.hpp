@@ -0,0 +1,71 @@
+//
+//  OpeningBook.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef OpeningBook_hpp
+#define OpeningBook_hpp
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "GameFoundation.hpp"
+
+static const char kOpeningBookMagic[8] = { 'D', 'O', 'M', 'B', 'O', 'O', 'K', '1' };
+static const uint32_t kOpeningBookVersion = 1;
+static const uint8_t kOpeningBookEmptyRecord = 0xFF;
+
+// file layout: header, then one fixed-size record per max player hand number (the ranks
+// CombinationListCreator::indexList produces). a record is the best tile's position in the
+// hand, a reserved byte, then a uint16 vote count for each tile of the hand in ascending order.
+struct OpeningBookHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t handSize;
+    uint32_t maxDominoSuit;
+    uint32_t numberOfSamples;
+    uint32_t numberOfRecords;
+    uint32_t recordSize;
+};
+
+struct OpeningBookEntry {
+    int bestTileIndex; // index into GameFoundation::dominoSet
+    IntVector tileIndices; // the hand, ascending
+    IntVector votes; // votes for each tile in tileIndices
+};
+
+// read-only memory-mapped view of an opening book file
+class OpeningBook {
+private:
+    void* _mapping;
+    size_t _mappingSize;
+    const OpeningBookHeader* _header;
+    const uint8_t* _records;
+
+    OpeningBook(const OpeningBook&);
+    OpeningBook& operator=(const OpeningBook&);
+public:
+    OpeningBook() : _mapping(NULL), _mappingSize(0), _header(NULL), _records(NULL) {}
+    ~OpeningBook();
+
+    bool open(const std::string& path, const GameFoundation& gameFoundation);
+    void close();
+    bool lookup(const int maxPlayerHandNumber, OpeningBookEntry& entry) const;
+    int numberOfBuiltRecords() const;
+
+    inline bool isOpen() const {
+        return _header != NULL;
+    }
+    inline int numberOfSamples() const {
+        return isOpen() ? (int)_header->numberOfSamples : 0;
+    }
+
+    static inline uint32_t recordSizeForHandSize(const int handSize) {
+        return 2 + (2 * (uint32_t)handSize);
+    }
+    static bool headerMatches(const OpeningBookHeader& header, const GameFoundation& gameFoundation);
+};
+
+#endif /* OpeningBook_hpp */
@@ -0,0 +1,140 @@
+//
+//  OpeningBookBuilder.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+
+#include "OpeningBookBuilder.hpp"
+#include "CombinationListCreator.hpp"
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "MonteCarloDataGenerator.hpp"
+
+bool OpeningBookBuilder::_mapBookForWriting(const std::string& path, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, void*& mapping, size_t& mappingSize) {
+    const int fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    OpeningBookHeader header;
+    memcpy(header.magic, kOpeningBookMagic, sizeof(kOpeningBookMagic));
+    header.version = kOpeningBookVersion;
+    header.handSize = (uint32_t)gameFoundation.handSize;
+    header.maxDominoSuit = (uint32_t)gameFoundation.maxDominoSuit;
+    header.numberOfSamples = (uint32_t)settings.numberOfSamples;
+    header.numberOfRecords = (uint32_t)CombinationListCreator::numberOfCombinations(gameFoundation.numberOfDominoes, gameFoundation.handSize);
+    header.recordSize = OpeningBook::recordSizeForHandSize(gameFoundation.handSize);
+    mappingSize = sizeof(OpeningBookHeader) + ((size_t)header.numberOfRecords * header.recordSize);
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0) {
+        close(fileDescriptor);
+        return false;
+    }
+    const bool isNewFile = fileStatus.st_size == 0;
+    if (isNewFile && ftruncate(fileDescriptor, (off_t)mappingSize) != 0) {
+        close(fileDescriptor);
+        return false;
+    }
+    if (!isNewFile && (size_t)fileStatus.st_size != mappingSize) {
+        close(fileDescriptor);
+        return false;
+    }
+
+    mapping = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    if (isNewFile) {
+        memcpy(mapping, &header, sizeof(header));
+        memset((uint8_t*)mapping + sizeof(header), kOpeningBookEmptyRecord, mappingSize - sizeof(header));
+    } else if (!OpeningBook::headerMatches(*(const OpeningBookHeader*)mapping, gameFoundation)) {
+        munmap(mapping, mappingSize);
+        return false;
+    }
+    return true;
+}
+
+void OpeningBookBuilder::_buildHands(uint8_t* records, const uint32_t recordSize, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, std::atomic<int>& nextHandNumber, const int endHandNumber, std::atomic<int>& handsBuilt) {
+    while (true) {
+        const int handNumber = nextHandNumber++;
+        if (handNumber >= endHandNumber) {
+            break;
+        }
+        uint8_t* record = records + ((size_t)handNumber * recordSize);
+        if (record[0] != kOpeningBookEmptyRecord) {
+            continue;
+        }
+
+        // the opponent's hand is sampled from all unseen tiles, so the dealt one does not matter
+        const Game game = Game::gameWithStartingMaxPayerHandNumber(gameFoundation, handNumber);
+        const GameState initialState(game);
+        DominoPointerVector childTiles;
+        const IntVector childCounts = MonteCarloDataGenerator::voteCountsForState(game, initialState, settings, childTiles);
+
+        // game.maxPlayerHand is in ascending dominoSet order, and the first move has one child per tile
+        assert(childTiles.size() == gameFoundation.handSize);
+        IntVector votes(gameFoundation.handSize, 0);
+        for (int i = 0; i < childTiles.size(); i++) {
+            for (int j = 0; j < game.maxPlayerHand.size(); j++) {
+                if (game.maxPlayerHand[j] == childTiles[i]) {
+                    votes[j] += childCounts[i];
+                }
+            }
+        }
+        int bestPosition = 0;
+        for (int i = 0; i < votes.size(); i++) {
+            const uint16_t clampedVotes = (uint16_t)std::min(votes[i], 0xFFFF);
+            memcpy(record + 2 + (2 * i), &clampedVotes, sizeof(clampedVotes));
+            if (votes[i] > votes[bestPosition]) {
+                bestPosition = i;
+            }
+        }
+        record[1] = 0;
+        // written last so a record is never marked built before its votes are
+        record[0] = (uint8_t)bestPosition;
+        handsBuilt++;
+    }
+}
+
+int OpeningBookBuilder::buildHands(const std::string& path, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, const int firstHandNumber, const int endHandNumber, const int numberOfThreads) {
+    void* mapping = NULL;
+    size_t mappingSize = 0;
+    if (!_mapBookForWriting(path, gameFoundation, settings, mapping, mappingSize)) {
+        return -1;
+    }
+    const OpeningBookHeader* header = (const OpeningBookHeader*)mapping;
+    uint8_t* records = (uint8_t*)mapping + sizeof(OpeningBookHeader);
+
+    // hands are solved in parallel, so each hand's samples run on one thread
+    MonteCarloSettings handSettings = settings;
+    handSettings.numberOfThreads = 1;
+    handSettings.openingBook = NULL;
+
+    const int threadsToUse = numberOfThreads > 0 ? numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+    std::atomic<int> nextHandNumber(std::max(0, firstHandNumber));
+    std::atomic<int> handsBuilt(0);
+    const int lastHandNumber = std::min(endHandNumber, (int)header->numberOfRecords);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsToUse; i++) {
+        threads.push_back(std::thread(_buildHands, records, header->recordSize, std::ref(gameFoundation), std::ref(handSettings), std::ref(nextHandNumber), lastHandNumber, std::ref(handsBuilt)));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    msync(mapping, mappingSize, MS_SYNC);
+    munmap(mapping, mappingSize);
+
+    return handsBuilt.load();
+}
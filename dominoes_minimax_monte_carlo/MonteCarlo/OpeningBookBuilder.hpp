@@ -0,0 +1,29 @@
+//
+//  OpeningBookBuilder.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef OpeningBookBuilder_hpp
+#define OpeningBookBuilder_hpp
+
+#include <atomic>
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "MonteCarloSettings.hpp"
+#include "OpeningBook.hpp"
+
+// fills an opening book file with the Monte Carlo vote for the first max player move of each hand.
+// the file is created with every record empty if it does not exist, and records that are already
+// built are skipped, so the book can be built in pieces over several runs.
+class OpeningBookBuilder {
+private:
+    static bool _mapBookForWriting(const std::string& path, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, void*& mapping, size_t& mappingSize);
+    static void _buildHands(uint8_t* records, const uint32_t recordSize, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, std::atomic<int>& nextHandNumber, const int endHandNumber, std::atomic<int>& handsBuilt);
+public:
+    // returns the number of hands built, or -1 if the file could not be created or does not match gameFoundation
+    static int buildHands(const std::string& path, const GameFoundation& gameFoundation, const MonteCarloSettings& settings, const int firstHandNumber, const int endHandNumber, const int numberOfThreads = 0);
+};
+
+#endif /* OpeningBookBuilder_hpp */
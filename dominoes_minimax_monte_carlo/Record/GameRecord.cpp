@@ -0,0 +1,154 @@
+//
+//  GameRecord.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <string.h>
+
+#include "GameRecord.hpp"
+#include "CombinationListCreator.hpp"
+
+static IntVector tileIndicesForHand(const GameFoundation& gameFoundation, const DominoPointerVector& hand) {
+    IntVector tileIndices;
+    for (int i = 0; i < hand.size(); i++) {
+        tileIndices.push_back(gameFoundation.indexForDomino(hand[i]));
+    }
+    std::sort(tileIndices.begin(), tileIndices.end());
+    return tileIndices;
+}
+
+// tiles not in the max hand, ascending. the min hand is ranked by its positions in this list.
+static IntVector tilesLeftByHand(const GameFoundation& gameFoundation, const IntVector& maxPlayerTileIndices) {
+    IntVector tileIndices;
+    for (int i = 0; i < gameFoundation.numberOfDominoes; i++) {
+        if (std::find(maxPlayerTileIndices.begin(), maxPlayerTileIndices.end(), i) == maxPlayerTileIndices.end()) {
+            tileIndices.push_back(i);
+        }
+    }
+    return tileIndices;
+}
+
+GameRecord GameRecord::recordForPath(const GameStateVector& path, const uint32_t seed) {
+    const GameState& initialState = path.front();
+    const GameFoundation& gameFoundation = initialState.game.gameFoundation;
+    assert(initialState.playedTiles.empty());
+
+    const IntVector maxPlayerTileIndices = tileIndicesForHand(gameFoundation, initialState.maxPlayerHand);
+    const IntVector minPlayerTileIndices = tileIndicesForHand(gameFoundation, initialState.minPlayerHand);
+    const IntVector tilesLeft = tilesLeftByHand(gameFoundation, maxPlayerTileIndices);
+    IntVector minPlayerPositions;
+    for (int i = 0; i < minPlayerTileIndices.size(); i++) {
+        minPlayerPositions.push_back((int)(std::find(tilesLeft.begin(), tilesLeft.end(), minPlayerTileIndices[i]) - tilesLeft.begin()));
+    }
+
+    GameRecord record((uint32_t)CombinationListCreator::indexForCombination(gameFoundation.numberOfDominoes, maxPlayerTileIndices), (uint32_t)CombinationListCreator::indexForCombination((int)tilesLeft.size(), minPlayerPositions), seed);
+
+    for (int i = 1; i < path.size(); i++) {
+        record.moves.push_back(moveForStates(path[i - 1], path[i]));
+    }
+
+    return record;
+}
+
+uint8_t GameRecord::moveForStates(const GameState& fromState, const GameState& toState) {
+    if (toState.playedTiles.size() == fromState.playedTiles.size()) {
+        return kGameRecordPass;
+    }
+    Domino const* domino = toState.playedTiles.back();
+    uint8_t move = (uint8_t)fromState.game.gameFoundation.indexForDomino(domino);
+    if (!fromState.playedTiles.empty()) {
+        // played on the first end when that end now shows the tile's other suit and the second end is unchanged
+        const int firstEnd = fromState.layoutEnds.first;
+        const bool fitsFirst = domino->hasSuit(firstEnd);
+        const int otherSuit = domino->ends.first == firstEnd ? domino->ends.second : domino->ends.first;
+        const bool playedOnFirst = fitsFirst && toState.layoutEnds.first == otherSuit && toState.layoutEnds.second == fromState.layoutEnds.second;
+        if (!playedOnFirst) {
+            move |= kGameRecordSecondEnd;
+        }
+    }
+    return move;
+}
+
+void GameRecord::encode(ByteVector& bytes) const {
+    assert(moves.size() <= 0xFF);
+    const uint32_t fields[3] = { maxPlayerHandRank, minPlayerHandRank, seed };
+    bytes.insert(bytes.end(), (const uint8_t*)fields, (const uint8_t*)fields + sizeof(fields));
+    bytes.push_back((uint8_t)moves.size());
+    bytes.insert(bytes.end(), moves.begin(), moves.end());
+}
+
+int GameRecord::decode(const uint8_t* bytes, const int size, GameRecord& record) {
+    if (size < kGameRecordFixedSize) {
+        return 0;
+    }
+    uint32_t fields[3];
+    memcpy(fields, bytes, sizeof(fields));
+    const int numberOfMoves = bytes[sizeof(fields)];
+    if (size < kGameRecordFixedSize + numberOfMoves) {
+        return 0;
+    }
+    record.maxPlayerHandRank = fields[0];
+    record.minPlayerHandRank = fields[1];
+    record.seed = fields[2];
+    record.moves.assign(bytes + kGameRecordFixedSize, bytes + kGameRecordFixedSize + numberOfMoves);
+    return kGameRecordFixedSize + numberOfMoves;
+}
+
+Game GameRecord::game(const GameFoundation& gameFoundation) const {
+    const IntVector maxPlayerTileIndices = CombinationListCreator::combinationForIndex(gameFoundation.numberOfDominoes, gameFoundation.handSize, (int)maxPlayerHandRank);
+    const IntVector tilesLeft = tilesLeftByHand(gameFoundation, maxPlayerTileIndices);
+    const IntVector minPlayerPositions = CombinationListCreator::combinationForIndex((int)tilesLeft.size(), gameFoundation.handSize, (int)minPlayerHandRank);
+    IntVector minPlayerTileIndices;
+    for (int i = 0; i < minPlayerPositions.size(); i++) {
+        minPlayerTileIndices.push_back(tilesLeft[minPlayerPositions[i]]);
+    }
+    return Game::gameWithHands(gameFoundation, maxPlayerTileIndices, minPlayerTileIndices);
+}
+
+bool GameRecord::replay(const Game& game, GameStateVector& states) const {
+    const GameFoundation& gameFoundation = game.gameFoundation;
+    states.clear();
+    states.reserve(moves.size() + 1);
+    states.push_back(GameState(game));
+
+    for (int i = 0; i < moves.size(); i++) {
+        GameState workState = GameState::stateRemovingChildren(states.back());
+        workState.expandAndGenerateChildren();
+
+        // children come in hand order, and a tile that fits both ends makes its first-end child first
+        IntVector matches;
+        for (int j = 0; j < workState.children.size(); j++) {
+            const GameState& child = workState.children[j];
+            const bool childPassed = child.playedTiles.size() == workState.playedTiles.size();
+            if (moves[i] == kGameRecordPass ? childPassed : (!childPassed && gameFoundation.indexForDomino(child.playedTiles.back()) == (moves[i] & kGameRecordTileMask))) {
+                matches.push_back(j);
+            }
+        }
+        if (matches.empty()) {
+            return false;
+        }
+        const int matchIndex = (moves[i] != kGameRecordPass && (moves[i] & kGameRecordSecondEnd)) ? (int)matches.size() - 1 : 0;
+        states.push_back(GameState::stateRemovingChildren(workState.children[matches[matchIndex]]));
+        // reserved above, so earlier states do not move
+        states.back().parent = &states[states.size() - 2];
+    }
+    return true;
+}
+
+std::string GameRecord::prettyString() const {
+    std::string result = "";
+    result += "Max Hand Rank: " + std::to_string(maxPlayerHandRank) + "\n";
+    result += "Min Hand Rank: " + std::to_string(minPlayerHandRank) + "\n";
+    result += "Seed: " + std::to_string(seed) + "\n";
+    result += "Moves:";
+    for (int i = 0; i < moves.size(); i++) {
+        if (moves[i] == kGameRecordPass) {
+            result += " pass";
+        } else {
+            result += " " + std::to_string(moves[i] & kGameRecordTileMask) + ((moves[i] & kGameRecordSecondEnd) ? "b" : "a");
+        }
+    }
+    result += "\n";
+    return result;
+}
@@ -0,0 +1,66 @@
+//
+//  GameRecord.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameRecord_hpp
+#define GameRecord_hpp
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "GameState.hpp"
+
+typedef std::vector<GameState> GameStateVector;
+typedef std::vector<uint8_t> ByteVector;
+
+static const char kGameRecordMagic[8] = { 'D', 'O', 'M', 'G', 'A', 'M', 'E', '1' };
+static const uint32_t kGameRecordVersion = 1;
+static const uint8_t kGameRecordPass = 0xFF;
+static const uint8_t kGameRecordSecondEnd = 0x40; // set on a move's tile index when it was played on layoutEnds.second
+static const uint8_t kGameRecordTileMask = 0x3F;
+static const int kGameRecordFixedSize = 13; // three uint32 fields and the move count
+
+// file layout: header, then records back to back. a record is the max hand rank, min hand rank and seed
+// as uint32, a uint8 move count, then one byte per move. the boneyard is every tile in neither hand, so
+// it follows from the two ranks and is not stored.
+struct GameRecordFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t handSize;
+    uint32_t maxDominoSuit;
+    uint32_t reserved;
+};
+
+struct GameRecord {
+    GameRecord(uint32_t maxPlayerHandRank = 0, uint32_t minPlayerHandRank = 0, uint32_t seed = 0) : maxPlayerHandRank(maxPlayerHandRank), minPlayerHandRank(minPlayerHandRank), seed(seed) {}
+
+    uint32_t maxPlayerHandRank; // combination index of the max hand among all tiles
+    uint32_t minPlayerHandRank; // combination index of the min hand among the tiles the max hand leaves
+    uint32_t seed;
+    ByteVector moves; // tile index (| kGameRecordSecondEnd), or kGameRecordPass
+
+    // path is root first, like MonteCarloData::path. MinimaxData::path is stored leaf first and must be reversed.
+    static GameRecord recordForPath(const GameStateVector& path, const uint32_t seed);
+    // the move byte for the move from fromState to its child toState
+    static uint8_t moveForStates(const GameState& fromState, const GameState& toState);
+    Game game(const GameFoundation& gameFoundation) const;
+    // rebuilds every state of the game, root first and without children. false if a move is not legal.
+    bool replay(const Game& game, GameStateVector& states) const;
+
+    // appends the record in file layout
+    void encode(ByteVector& bytes) const;
+    // reads one record in file layout from the start of bytes. returns the bytes used, or 0 if bytes ends mid-record
+    static int decode(const uint8_t* bytes, const int size, GameRecord& record);
+
+    inline int encodedSize() const {
+        return kGameRecordFixedSize + (int)moves.size();
+    }
+
+    std::string prettyString() const;
+};
+
+#endif /* GameRecord_hpp */
@@ -0,0 +1,65 @@
+//
+//  GameRecordReader.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <string.h>
+
+#include "GameRecordReader.hpp"
+
+static const int kGameRecordReaderBufferSize = 1 << 20;
+
+GameRecordReader::~GameRecordReader() {
+    close();
+}
+
+bool GameRecordReader::open(const std::string& path, const GameFoundation& gameFoundation) {
+    close();
+
+    _file = fopen(path.c_str(), "rb");
+    if (_file == NULL) {
+        return false;
+    }
+    setvbuf(_file, NULL, _IOFBF, kGameRecordReaderBufferSize);
+
+    GameRecordFileHeader header;
+    if (fread(&header, sizeof(header), 1, _file) != 1 ||
+        memcmp(header.magic, kGameRecordMagic, sizeof(kGameRecordMagic)) != 0 ||
+        header.version != kGameRecordVersion ||
+        header.handSize != (uint32_t)gameFoundation.handSize ||
+        header.maxDominoSuit != (uint32_t)gameFoundation.maxDominoSuit) {
+        close();
+        return false;
+    }
+    _recordsRead = 0;
+    return true;
+}
+
+bool GameRecordReader::next(GameRecord& record) {
+    if (_file == NULL) {
+        return false;
+    }
+    uint8_t fixed[kGameRecordFixedSize];
+    if (fread(fixed, 1, sizeof(fixed), _file) != sizeof(fixed)) {
+        return false;
+    }
+    uint32_t fields[3];
+    memcpy(fields, fixed, sizeof(fields));
+    record.maxPlayerHandRank = fields[0];
+    record.minPlayerHandRank = fields[1];
+    record.seed = fields[2];
+    record.moves.resize(fixed[sizeof(fields)]);
+    if (!record.moves.empty() && fread(record.moves.data(), 1, record.moves.size(), _file) != record.moves.size()) {
+        return false;
+    }
+    _recordsRead++;
+    return true;
+}
+
+void GameRecordReader::close() {
+    if (_file != NULL) {
+        fclose(_file);
+        _file = NULL;
+    }
+}
@@ -0,0 +1,42 @@
+//
+//  GameRecordReader.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameRecordReader_hpp
+#define GameRecordReader_hpp
+
+#include <stdio.h>
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "GameRecord.hpp"
+
+// reads game records one at a time, so a file of any size streams through a single record
+class GameRecordReader {
+private:
+    FILE* _file;
+    long long _recordsRead;
+
+    GameRecordReader(const GameRecordReader&);
+    GameRecordReader& operator=(const GameRecordReader&);
+public:
+    GameRecordReader() : _file(NULL), _recordsRead(0) {}
+    ~GameRecordReader();
+
+    // false if the file is missing or was written for other game settings
+    bool open(const std::string& path, const GameFoundation& gameFoundation);
+    // false at the end of the file or on a truncated record
+    bool next(GameRecord& record);
+    void close();
+
+    inline bool isOpen() const {
+        return _file != NULL;
+    }
+    inline long long getRecordsRead() const {
+        return _recordsRead;
+    }
+};
+
+#endif /* GameRecordReader_hpp */
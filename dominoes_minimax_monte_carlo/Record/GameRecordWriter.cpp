@@ -0,0 +1,61 @@
+//
+//  GameRecordWriter.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <string.h>
+
+#include "GameRecordWriter.hpp"
+
+GameRecordWriter::~GameRecordWriter() {
+    close();
+}
+
+bool GameRecordWriter::open(const std::string& path, const GameFoundation& gameFoundation) {
+    close();
+
+    _file = fopen(path.c_str(), "wb");
+    if (_file == NULL) {
+        return false;
+    }
+
+    GameRecordFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kGameRecordMagic, sizeof(kGameRecordMagic));
+    header.version = kGameRecordVersion;
+    header.handSize = (uint32_t)gameFoundation.handSize;
+    header.maxDominoSuit = (uint32_t)gameFoundation.maxDominoSuit;
+    _buffer.reserve(kGameRecordWriterBufferSize);
+    _buffer.insert(_buffer.end(), (const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+    _recordsWritten = 0;
+    _bytesWritten = 0;
+    return true;
+}
+
+void GameRecordWriter::_flushBuffer() {
+    if (!_buffer.empty()) {
+        fwrite(_buffer.data(), 1, _buffer.size(), _file);
+        _bytesWritten += (long long)_buffer.size();
+        _buffer.clear();
+    }
+}
+
+void GameRecordWriter::write(const GameRecord& record) {
+    assert(isOpen());
+
+    record.encode(_buffer);
+    _recordsWritten++;
+
+    if (_buffer.size() >= kGameRecordWriterBufferSize) {
+        _flushBuffer();
+    }
+}
+
+void GameRecordWriter::close() {
+    if (_file != NULL) {
+        _flushBuffer();
+        fclose(_file);
+        _file = NULL;
+    }
+}
@@ -0,0 +1,51 @@
+//
+//  GameRecordWriter.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef GameRecordWriter_hpp
+#define GameRecordWriter_hpp
+
+#include <stdio.h>
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "GameRecord.hpp"
+
+static const int kGameRecordWriterBufferSize = 1 << 20;
+
+// appends game records to a file. records are encoded into an in-memory buffer that is written out
+// a megabyte at a time, so a write costs about as much as copying the record's bytes.
+class GameRecordWriter {
+private:
+    FILE* _file;
+    ByteVector _buffer;
+    long long _recordsWritten;
+    long long _bytesWritten;
+
+    void _flushBuffer();
+
+    GameRecordWriter(const GameRecordWriter&);
+    GameRecordWriter& operator=(const GameRecordWriter&);
+public:
+    GameRecordWriter() : _file(NULL), _recordsWritten(0), _bytesWritten(0) {}
+    ~GameRecordWriter();
+
+    // creates or truncates path and writes the file header
+    bool open(const std::string& path, const GameFoundation& gameFoundation);
+    void write(const GameRecord& record);
+    void close();
+
+    inline bool isOpen() const {
+        return _file != NULL;
+    }
+    inline long long getRecordsWritten() const {
+        return _recordsWritten;
+    }
+    inline long long getBytesWritten() const {
+        return _bytesWritten;
+    }
+};
+
+#endif /* GameRecordWriter_hpp */
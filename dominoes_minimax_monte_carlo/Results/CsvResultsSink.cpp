@@ -0,0 +1,113 @@
+//
+//  CsvResultsSink.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "CsvResultsSink.hpp"
+
+#include "MemoryTracker.hpp"
+
+void CsvResultsSink::writeHeader(ResultsBuffer& buffer) const {
+    buffer.appendString("game,max_hand_number,tree_nodes,full_minimax_value,full_minimax_nodes,alpha_beta_value,alpha_beta_nodes,monte_carlo_score,monte_carlo_moves,monte_carlo_nodes,monte_carlo_seconds,solution_store_hits,opening_book_moves,analysis_seconds");
+    if (_perPlyDetail) {
+        buffer.appendString(",ply_moves,ply_nodes,ply_seconds");
+    }
+    if (_memoryDetail) {
+        for (int i = 0; i < kResultsMemoryPhaseCount; i++) {
+            const std::string prefix = std::string(",") + kResultsMemoryPhasePrefixes[i];
+            buffer.appendString((prefix + "_peak_live_bytes" + prefix + "_bytes_per_node" + prefix + "_process_peak_resident_bytes").c_str());
+        }
+    }
+    buffer.appendChar('\n');
+}
+
+void CsvResultsSink::writeGame(ResultsBuffer& buffer, const GameAnalysis& analysis) const {
+    const MonteCarloData& monteCarloData = analysis.monteCarloData;
+    long long monteCarloNodes = 0;
+    for (int i = 0; i < monteCarloData.moveNodesVisited.size(); i++) {
+        monteCarloNodes += monteCarloData.moveNodesVisited[i];
+    }
+
+    buffer.appendInt(analysis.gameNumber + 1);
+    buffer.appendChar(',');
+    buffer.appendInt(analysis.maxPlayerHandNumber);
+    buffer.appendChar(',');
+    // perfect information columns are empty when only Monte Carlo ran, full minimax ones when it did not run
+    if (analysis.ranPerfectInformation) {
+        buffer.appendInt(analysis.gameTreeData.getTotalNodes());
+    }
+    buffer.appendChar(',');
+    if (analysis.ranPerfectInformation && analysis.ranFullMinimax) {
+        buffer.appendInt(analysis.fullMinimaxData.minimaxValue);
+        buffer.appendChar(',');
+        buffer.appendInt(analysis.fullMinimaxData.nodesVisited);
+    } else {
+        buffer.appendChar(',');
+    }
+    buffer.appendChar(',');
+    if (analysis.ranPerfectInformation) {
+        buffer.appendInt(analysis.alphaBetaMinimaxData.minimaxValue);
+        buffer.appendChar(',');
+        buffer.appendInt(analysis.alphaBetaMinimaxData.nodesVisited);
+    } else {
+        buffer.appendChar(',');
+    }
+    buffer.appendChar(',');
+    buffer.appendInt(monteCarloData.path.back().getScore());
+    buffer.appendChar(',');
+    buffer.appendInt((long long)monteCarloData.path.size() - 1);
+    buffer.appendChar(',');
+    buffer.appendInt(monteCarloNodes);
+    buffer.appendChar(',');
+    buffer.appendDouble(monteCarloData.getTotalMoveDuration());
+    buffer.appendChar(',');
+    buffer.appendInt(monteCarloData.solutionStoreHits);
+    buffer.appendChar(',');
+    buffer.appendInt(monteCarloData.openingBookMoves);
+    buffer.appendChar(',');
+    buffer.appendDouble(analysis.analysisDuration);
+
+    if (_perPlyDetail) {
+        buffer.appendChar(',');
+        for (int i = 1; i < monteCarloData.path.size(); i++) {
+            if (i > 1) {
+                buffer.appendChar(' ');
+            }
+            appendMove(buffer, monteCarloData.path[i - 1], monteCarloData.path[i]);
+        }
+        buffer.appendChar(',');
+        for (int i = 0; i < monteCarloData.moveNodesVisited.size(); i++) {
+            if (i > 0) {
+                buffer.appendChar(' ');
+            }
+            buffer.appendInt(monteCarloData.moveNodesVisited[i]);
+        }
+        buffer.appendChar(',');
+        for (int i = 0; i < monteCarloData.moveDurations.size(); i++) {
+            if (i > 0) {
+                buffer.appendChar(' ');
+            }
+            buffer.appendDouble(monteCarloData.moveDurations[i]);
+        }
+    }
+    if (_memoryDetail) {
+        for (int i = 0; i < kResultsMemoryPhaseCount; i++) {
+            const MemoryPhaseData* phase = analysis.memoryData.phaseNamed(kResultsMemoryPhaseNames[i]);
+            // allocation figures are empty unless built with TRACK_ALLOCATIONS, and for phases that overlapped others
+            buffer.appendChar(',');
+            if (phase != NULL && !phase->overlapping && MemoryTracker::isTrackingAllocations()) {
+                buffer.appendInt(phase->peakLiveBytes);
+                buffer.appendChar(',');
+                buffer.appendInt(phase->getBytesPerNode());
+            } else {
+                buffer.appendChar(',');
+            }
+            buffer.appendChar(',');
+            if (phase != NULL) {
+                buffer.appendInt(phase->processPeakResidentBytes);
+            }
+        }
+    }
+    buffer.appendChar('\n');
+}
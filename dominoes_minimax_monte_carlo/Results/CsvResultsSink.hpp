@@ -0,0 +1,26 @@
+//
+//  CsvResultsSink.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef CsvResultsSink_hpp
+#define CsvResultsSink_hpp
+
+#include "ResultsSink.hpp"
+
+// one row per game. with per-ply detail, three more columns hold the Monte Carlo moves,
+// their nodes and their seconds as space separated lists. with memory detail, three columns per
+// memory phase follow, left empty when the phase was not measured.
+class CsvResultsSink : public ResultsSink {
+private:
+    const bool _perPlyDetail;
+    const bool _memoryDetail;
+public:
+    CsvResultsSink(const bool perPlyDetail = false, const bool memoryDetail = false) : _perPlyDetail(perPlyDetail), _memoryDetail(memoryDetail) {}
+
+    void writeHeader(ResultsBuffer& buffer) const override;
+    void writeGame(ResultsBuffer& buffer, const GameAnalysis& analysis) const override;
+};
+
+#endif /* CsvResultsSink_hpp */
@@ -0,0 +1,106 @@
+//
+//  JsonLinesResultsSink.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "JsonLinesResultsSink.hpp"
+
+#include "MemoryTracker.hpp"
+
+void JsonLinesResultsSink::writeGame(ResultsBuffer& buffer, const GameAnalysis& analysis) const {
+    const MonteCarloData& monteCarloData = analysis.monteCarloData;
+    long long monteCarloNodes = 0;
+    for (int i = 0; i < monteCarloData.moveNodesVisited.size(); i++) {
+        monteCarloNodes += monteCarloData.moveNodesVisited[i];
+    }
+
+    buffer.appendString("{\"game\":");
+    buffer.appendInt(analysis.gameNumber + 1);
+    buffer.appendString(",\"max_hand_number\":");
+    buffer.appendInt(analysis.maxPlayerHandNumber);
+    // perfect information values are null when only Monte Carlo ran, and full minimax values when it was skipped,
+    // so every line has the same keys
+    if (analysis.ranPerfectInformation) {
+        buffer.appendString(",\"tree_nodes\":");
+        buffer.appendInt(analysis.gameTreeData.getTotalNodes());
+        if (analysis.ranFullMinimax) {
+            buffer.appendString(",\"full_minimax_value\":");
+            buffer.appendInt(analysis.fullMinimaxData.minimaxValue);
+            buffer.appendString(",\"full_minimax_nodes\":");
+            buffer.appendInt(analysis.fullMinimaxData.nodesVisited);
+        } else {
+            buffer.appendString(",\"full_minimax_value\":null,\"full_minimax_nodes\":null");
+        }
+        buffer.appendString(",\"alpha_beta_value\":");
+        buffer.appendInt(analysis.alphaBetaMinimaxData.minimaxValue);
+        buffer.appendString(",\"alpha_beta_nodes\":");
+        buffer.appendInt(analysis.alphaBetaMinimaxData.nodesVisited);
+    } else {
+        buffer.appendString(",\"tree_nodes\":null,\"full_minimax_value\":null,\"full_minimax_nodes\":null,\"alpha_beta_value\":null,\"alpha_beta_nodes\":null");
+    }
+    buffer.appendString(",\"monte_carlo_score\":");
+    buffer.appendInt(monteCarloData.path.back().getScore());
+    buffer.appendString(",\"monte_carlo_moves\":");
+    buffer.appendInt((long long)monteCarloData.path.size() - 1);
+    buffer.appendString(",\"monte_carlo_nodes\":");
+    buffer.appendInt(monteCarloNodes);
+    buffer.appendString(",\"monte_carlo_seconds\":");
+    buffer.appendDouble(monteCarloData.getTotalMoveDuration());
+    buffer.appendString(",\"solution_store_hits\":");
+    buffer.appendInt(monteCarloData.solutionStoreHits);
+    buffer.appendString(",\"opening_book_moves\":");
+    buffer.appendInt(monteCarloData.openingBookMoves);
+    buffer.appendString(",\"analysis_seconds\":");
+    buffer.appendDouble(analysis.analysisDuration);
+
+    if (_perPlyDetail) {
+        buffer.appendString(",\"plies\":[");
+        for (int i = 1; i < monteCarloData.path.size(); i++) {
+            const GameState& fromState = monteCarloData.path[i - 1];
+            if (i > 1) {
+                buffer.appendChar(',');
+            }
+            buffer.appendString("{\"player\":\"");
+            buffer.appendString(fromState.isMaxPlayer() ? "max" : "min");
+            buffer.appendString("\",\"move\":\"");
+            appendMove(buffer, fromState, monteCarloData.path[i]);
+            buffer.appendString("\",\"nodes\":");
+            buffer.appendInt(i - 1 < monteCarloData.moveNodesVisited.size() ? monteCarloData.moveNodesVisited[i - 1] : 0);
+            buffer.appendString(",\"seconds\":");
+            buffer.appendDouble(i - 1 < monteCarloData.moveDurations.size() ? monteCarloData.moveDurations[i - 1] : 0.0);
+            buffer.appendChar('}');
+        }
+        buffer.appendChar(']');
+    }
+    if (_memoryDetail) {
+        buffer.appendString(",\"memory\":{");
+        for (int i = 0; i < kResultsMemoryPhaseCount; i++) {
+            const MemoryPhaseData* phase = analysis.memoryData.phaseNamed(kResultsMemoryPhaseNames[i]);
+            if (i > 0) {
+                buffer.appendChar(',');
+            }
+            buffer.appendChar('"');
+            buffer.appendString(kResultsMemoryPhasePrefixes[i]);
+            buffer.appendString("\":");
+            if (phase == NULL) {
+                buffer.appendString("null");
+                continue;
+            }
+            // allocation figures are null unless built with TRACK_ALLOCATIONS, and for phases that overlapped others
+            if (!phase->overlapping && MemoryTracker::isTrackingAllocations()) {
+                buffer.appendString("{\"peak_live_bytes\":");
+                buffer.appendInt(phase->peakLiveBytes);
+                buffer.appendString(",\"bytes_per_node\":");
+                buffer.appendInt(phase->getBytesPerNode());
+            } else {
+                buffer.appendString("{\"peak_live_bytes\":null,\"bytes_per_node\":null");
+            }
+            buffer.appendString(",\"process_peak_resident_bytes\":");
+            buffer.appendInt(phase->processPeakResidentBytes);
+            buffer.appendChar('}');
+        }
+        buffer.appendChar('}');
+    }
+    buffer.appendString("}\n");
+}
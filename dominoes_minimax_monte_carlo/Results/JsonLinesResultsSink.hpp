@@ -0,0 +1,25 @@
+//
+//  JsonLinesResultsSink.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef JsonLinesResultsSink_hpp
+#define JsonLinesResultsSink_hpp
+
+#include "ResultsSink.hpp"
+
+// one JSON object per line and game. with per-ply detail, "plies" lists each Monte Carlo move.
+// with memory detail, "memory" holds an object per memory phase, or null when it was not measured.
+class JsonLinesResultsSink : public ResultsSink {
+private:
+    const bool _perPlyDetail;
+    const bool _memoryDetail;
+public:
+    JsonLinesResultsSink(const bool perPlyDetail = false, const bool memoryDetail = false) : _perPlyDetail(perPlyDetail), _memoryDetail(memoryDetail) {}
+
+    void writeHeader(ResultsBuffer&) const override {}
+    void writeGame(ResultsBuffer& buffer, const GameAnalysis& analysis) const override;
+};
+
+#endif /* JsonLinesResultsSink_hpp */
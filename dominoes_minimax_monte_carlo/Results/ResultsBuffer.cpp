@@ -0,0 +1,48 @@
+//
+//  ResultsBuffer.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ResultsBuffer.hpp"
+
+ResultsBuffer::~ResultsBuffer() {
+    flush();
+}
+
+void ResultsBuffer::appendString(const char* string) {
+    size_t length = strlen(string);
+    while (length > 0) {
+        _reserve(1);
+        const size_t chunk = std::min(length, _data.size() - _size);
+        memcpy(&_data[_size], string, chunk);
+        _size += chunk;
+        string += chunk;
+        length -= chunk;
+    }
+}
+
+void ResultsBuffer::appendChar(const char character) {
+    _reserve(1);
+    _data[_size++] = character;
+}
+
+void ResultsBuffer::appendInt(const long long value) {
+    _reserve(kResultsBufferFieldSize);
+    _size += snprintf(&_data[_size], kResultsBufferFieldSize, "%lld", value);
+}
+
+void ResultsBuffer::appendDouble(const double value) {
+    _reserve(kResultsBufferFieldSize);
+    _size += snprintf(&_data[_size], kResultsBufferFieldSize, "%.6f", value);
+}
+
+void ResultsBuffer::flush() {
+    if (_size > 0) {
+        _file.write(_data.data(), _size);
+        _size = 0;
+    }
+}
@@ -0,0 +1,44 @@
+//
+//  ResultsBuffer.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ResultsBuffer_hpp
+#define ResultsBuffer_hpp
+
+#include <vector>
+
+#include "ResultsFile.hpp"
+
+static const size_t kDefaultResultsBufferSize = 1 << 20;
+static const size_t kResultsBufferFieldSize = 64; // room kept for one formatted number
+
+// one thread's output buffer. fields are formatted straight into a preallocated block, so writing a
+// result allocates nothing, and the block goes to the shared file only when it fills or on flush.
+class ResultsBuffer {
+private:
+    ResultsFile& _file;
+    std::vector<char> _data;
+    size_t _size;
+
+    inline void _reserve(const size_t size) {
+        if (_size + size > _data.size()) {
+            flush();
+        }
+    }
+
+    ResultsBuffer(const ResultsBuffer&);
+    ResultsBuffer& operator=(const ResultsBuffer&);
+public:
+    ResultsBuffer(ResultsFile& file, const size_t capacity = kDefaultResultsBufferSize) : _file(file), _data(std::max(capacity, kResultsBufferFieldSize)), _size(0) {}
+    ~ResultsBuffer();
+
+    void appendString(const char* string);
+    void appendChar(const char character);
+    void appendInt(const long long value);
+    void appendDouble(const double value);
+    void flush();
+};
+
+#endif /* ResultsBuffer_hpp */
@@ -0,0 +1,37 @@
+//
+//  ResultsFile.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "ResultsFile.hpp"
+
+ResultsFile::~ResultsFile() {
+    close();
+}
+
+bool ResultsFile::open(const std::string& path) {
+    close();
+    _file = fopen(path.c_str(), "w");
+    _ownsFile = _file != NULL;
+    return _file != NULL;
+}
+
+void ResultsFile::write(const char* data, const size_t size) {
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_file != NULL) {
+        fwrite(data, 1, size, _file);
+    }
+}
+
+void ResultsFile::close() {
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_file != NULL) {
+        if (_ownsFile) {
+            fclose(_file);
+        } else {
+            fflush(_file);
+        }
+        _file = NULL;
+    }
+}
@@ -0,0 +1,37 @@
+//
+//  ResultsFile.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ResultsFile_hpp
+#define ResultsFile_hpp
+
+#include <mutex>
+#include <stdio.h>
+#include <string>
+
+// destination shared by every thread's ResultsBuffer. writes are whole buffers, taken under a lock.
+class ResultsFile {
+private:
+    FILE* _file;
+    bool _ownsFile;
+    std::mutex _lock;
+
+    ResultsFile(const ResultsFile&);
+    ResultsFile& operator=(const ResultsFile&);
+public:
+    ResultsFile() : _file(NULL), _ownsFile(false) {}
+    explicit ResultsFile(FILE* file) : _file(file), _ownsFile(false) {} // e.g. stdout, left open
+    ~ResultsFile();
+
+    bool open(const std::string& path);
+    void write(const char* data, const size_t size);
+    void close();
+
+    inline bool isOpen() const {
+        return _file != NULL;
+    }
+};
+
+#endif /* ResultsFile_hpp */
@@ -0,0 +1,31 @@
+//
+//  ResultsSink.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "ResultsSink.hpp"
+#include "CsvResultsSink.hpp"
+#include "JsonLinesResultsSink.hpp"
+
+std::unique_ptr<ResultsSink> ResultsSink::sinkForFormat(const ResultsFormat format, const bool perPlyDetail, const bool memoryDetail) {
+    switch (format) {
+        case kResultsFormatCsv:
+            return std::unique_ptr<ResultsSink>(new CsvResultsSink(perPlyDetail, memoryDetail));
+        case kResultsFormatJsonLines:
+            return std::unique_ptr<ResultsSink>(new JsonLinesResultsSink(perPlyDetail, memoryDetail));
+        default:
+            return std::unique_ptr<ResultsSink>();
+    }
+}
+
+void ResultsSink::appendMove(ResultsBuffer& buffer, const GameState& fromState, const GameState& toState) {
+    if (toState.playedTiles.size() == fromState.playedTiles.size()) {
+        buffer.appendString("pass");
+        return;
+    }
+    const Domino* domino = toState.playedTiles.back();
+    buffer.appendInt(domino->ends.first);
+    buffer.appendChar('-');
+    buffer.appendInt(domino->ends.second);
+}
@@ -0,0 +1,43 @@
+//
+//  ResultsSink.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef ResultsSink_hpp
+#define ResultsSink_hpp
+
+#include <memory>
+
+#include "GameAnalysis.hpp"
+#include "ResultsBuffer.hpp"
+
+enum ResultsFormat {
+    kResultsFormatPrettyString, // the human-readable prettyString output
+    kResultsFormatCsv, // one row per game
+    kResultsFormatJsonLines // one JSON object per game
+};
+
+// the memory phases written with memory detail, and the prefixes of their columns
+static const int kResultsMemoryPhaseCount = 4;
+static const char* const kResultsMemoryPhaseNames[kResultsMemoryPhaseCount] = { kMemoryPhaseGameTree, kMemoryPhaseFullMinimax, kMemoryPhaseAlphaBetaMinimax, kMemoryPhaseMonteCarlo };
+static const char* const kResultsMemoryPhasePrefixes[kResultsMemoryPhaseCount] = { "game_tree", "full_minimax", "alpha_beta", "monte_carlo" };
+
+// formats one game's results into the calling thread's buffer. sinks hold no per-game state,
+// so one sink can be shared by every thread.
+class ResultsSink {
+public:
+    virtual ~ResultsSink() {}
+
+    // written once before any game, e.g. a CSV header row
+    virtual void writeHeader(ResultsBuffer& buffer) const = 0;
+    virtual void writeGame(ResultsBuffer& buffer, const GameAnalysis& analysis) const = 0;
+
+    // NULL for kResultsFormatPrettyString. perPlyDetail adds each Monte Carlo move with its nodes and time.
+    // memoryDetail adds peak live bytes, bytes per node and the process peak resident bytes for each memory phase.
+    static std::unique_ptr<ResultsSink> sinkForFormat(const ResultsFormat format, const bool perPlyDetail, const bool memoryDetail = false);
+    // the tile a path state played, "a-b", or "pass"
+    static void appendMove(ResultsBuffer& buffer, const GameState& fromState, const GameState& toState);
+};
+
+#endif /* ResultsSink_hpp */
@@ -0,0 +1,88 @@
+//
+//  BatchStatistics.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include "BatchStatistics.hpp"
+
+static const double kScoreHistogramMinimum = -200.0;
+static const double kScoreHistogramBinWidth = 10.0;
+static const int kScoreHistogramBins = 40;
+
+static inline int sign(const int value) {
+    return (value > 0) - (value < 0);
+}
+
+BatchStatistics::BatchStatistics() : games(0), perfectInformationGames(0), alphaBetaValues(kScoreHistogramMinimum, kScoreHistogramBinWidth, kScoreHistogramBins), monteCarloScores(kScoreHistogramMinimum, kScoreHistogramBinWidth, kScoreHistogramBins), monteCarloSameWinner(0), monteCarloSameScore(0), branchingFactors(0.0, 0.25, 32), minLeafDepths(0.0, 1.0, 32), maxLeafDepths(0.0, 1.0, 32) {}
+
+void BatchStatistics::addMonteCarloData(const MonteCarloData& monteCarloData) {
+    games++;
+    monteCarloScores.add(monteCarloData.path.back().getScore());
+    for (int i = 0; i < monteCarloData.moveDurations.size(); i++) {
+        moveSeconds.add(monteCarloData.moveDurations[i]);
+        moveSecondsSummary.add(monteCarloData.moveDurations[i]);
+    }
+    for (int i = 0; i < monteCarloData.moveNodesVisited.size(); i++) {
+        moveNodes.add((double)monteCarloData.moveNodesVisited[i]);
+    }
+}
+
+void BatchStatistics::addGame(const GameAnalysis& analysis) {
+    addMonteCarloData(analysis.monteCarloData);
+
+    perfectInformationGames++;
+    const int perfectValue = analysis.alphaBetaMinimaxData.minimaxValue;
+    const int monteCarloScore = analysis.monteCarloData.path.back().getScore();
+    alphaBetaValues.add(perfectValue);
+    monteCarloSameWinner += sign(perfectValue) == sign(monteCarloScore) ? 1 : 0;
+    monteCarloSameScore += perfectValue == monteCarloScore ? 1 : 0;
+    monteCarloScoreDifference.add(monteCarloScore - perfectValue);
+
+    const GameTreeData& gameTreeData = analysis.gameTreeData;
+    branchingFactors.add(gameTreeData.getAverageBranchingFactor());
+    minLeafDepths.add(gameTreeData.minLeafDepth);
+    maxLeafDepths.add(gameTreeData.maxLeafDepth);
+    treeNodes.add(gameTreeData.getTotalNodes());
+    alphaBetaNodes.add(analysis.alphaBetaMinimaxData.nodesVisited);
+}
+
+void BatchStatistics::merge(const BatchStatistics& other) {
+    games += other.games;
+    perfectInformationGames += other.perfectInformationGames;
+    alphaBetaValues.merge(other.alphaBetaValues);
+    monteCarloScores.merge(other.monteCarloScores);
+    monteCarloSameWinner += other.monteCarloSameWinner;
+    monteCarloSameScore += other.monteCarloSameScore;
+    monteCarloScoreDifference.merge(other.monteCarloScoreDifference);
+    branchingFactors.merge(other.branchingFactors);
+    minLeafDepths.merge(other.minLeafDepths);
+    maxLeafDepths.merge(other.maxLeafDepths);
+    treeNodes.merge(other.treeNodes);
+    alphaBetaNodes.merge(other.alphaBetaNodes);
+    moveSeconds.merge(other.moveSeconds);
+    moveNodes.merge(other.moveNodes);
+    moveSecondsSummary.merge(other.moveSecondsSummary);
+}
+
+std::string BatchStatistics::prettyString() const {
+    std::string result = "";
+    result += "Games: " + std::to_string(games) + "\n";
+    result += "Monte Carlo Scores:\n" + monteCarloScores.prettyString();
+    result += "Monte Carlo Move Seconds: " + moveSeconds.prettyString() + "\n";
+    result += "Monte Carlo Move Seconds Summary: " + moveSecondsSummary.prettyString() + "\n";
+    result += "Monte Carlo Move Nodes: " + moveNodes.prettyString() + "\n";
+    if (perfectInformationGames > 0) {
+        const double games = (double)perfectInformationGames;
+        result += "Alpha-Beta Values:\n" + alphaBetaValues.prettyString();
+        result += "Monte Carlo Same Winner As Perfect Play: " + std::to_string(100.0 * monteCarloSameWinner / games) + " %\n";
+        result += "Monte Carlo Same Score As Perfect Play: " + std::to_string(100.0 * monteCarloSameScore / games) + " %\n";
+        result += "Monte Carlo Score Minus Alpha-Beta Value: " + monteCarloScoreDifference.prettyString() + "\n";
+        result += "Average Branching Factors:\n" + branchingFactors.prettyString();
+        result += "Min Leaf Depths:\n" + minLeafDepths.prettyString();
+        result += "Max Leaf Depths:\n" + maxLeafDepths.prettyString();
+        result += "Tree Nodes: " + treeNodes.prettyString() + "\n";
+        result += "Alpha-Beta Nodes: " + alphaBetaNodes.prettyString() + "\n";
+    }
+    return result;
+}
@@ -0,0 +1,44 @@
+//
+//  BatchStatistics.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef BatchStatistics_hpp
+#define BatchStatistics_hpp
+
+#include <string>
+
+#include "GameAnalysis.hpp"
+#include "Histogram.hpp"
+#include "QuantileSketch.hpp"
+#include "RunningStatistics.hpp"
+
+// summary distributions for a batch in constant memory. each worker adds its own games and the
+// per-worker statistics are merged once the batch is done.
+struct BatchStatistics {
+    BatchStatistics();
+
+    long long games;
+    long long perfectInformationGames; // games with alpha-beta and tree data, the rest only ran Monte Carlo
+    Histogram alphaBetaValues;
+    Histogram monteCarloScores;
+    long long monteCarloSameWinner; // Monte Carlo play ended with the winner perfect play predicts
+    long long monteCarloSameScore;
+    RunningStatistics monteCarloScoreDifference; // Monte Carlo score minus alpha-beta value
+    Histogram branchingFactors;
+    Histogram minLeafDepths;
+    Histogram maxLeafDepths;
+    RunningStatistics treeNodes;
+    RunningStatistics alphaBetaNodes;
+    QuantileSketch moveSeconds; // per Monte Carlo move
+    QuantileSketch moveNodes;
+    RunningStatistics moveSecondsSummary;
+
+    void addGame(const GameAnalysis& analysis);
+    void addMonteCarloData(const MonteCarloData& monteCarloData);
+    void merge(const BatchStatistics& other);
+    std::string prettyString() const;
+};
+
+#endif /* BatchStatistics_hpp */
@@ -0,0 +1,62 @@
+//
+//  Histogram.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <assert.h>
+#include <cmath>
+#include <stdio.h>
+
+#include "Histogram.hpp"
+
+static std::string numberString(const double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", value);
+    return buffer;
+}
+
+void Histogram::add(const double value) {
+    const int numberOfBins = (int)_counts.size() - 2;
+    const double position = std::floor((value - _minimum) / _binWidth);
+    int bin = 0;
+    if (position >= numberOfBins) {
+        bin = numberOfBins + 1;
+    } else if (position >= 0) {
+        bin = (int)position + 1;
+    }
+    _counts[bin]++;
+}
+
+void Histogram::merge(const Histogram& other) {
+    assert(other._counts.size() == _counts.size() && other._minimum == _minimum && other._binWidth == _binWidth);
+    for (int i = 0; i < _counts.size(); i++) {
+        _counts[i] += other._counts[i];
+    }
+}
+
+long long Histogram::getCount() const {
+    long long count = 0;
+    for (int i = 0; i < _counts.size(); i++) {
+        count += _counts[i];
+    }
+    return count;
+}
+
+std::string Histogram::prettyString() const {
+    const int numberOfBins = (int)_counts.size() - 2;
+    std::string result = "";
+    if (_counts[0] > 0) {
+        result += "  < " + numberString(_minimum) + ": " + std::to_string(_counts[0]) + "\n";
+    }
+    for (int i = 0; i < numberOfBins; i++) {
+        if (_counts[i + 1] > 0) {
+            const double low = _minimum + i * _binWidth;
+            result += "  [" + numberString(low) + ", " + numberString(low + _binWidth) + "): " + std::to_string(_counts[i + 1]) + "\n";
+        }
+    }
+    if (_counts[numberOfBins + 1] > 0) {
+        result += "  >= " + numberString(_minimum + numberOfBins * _binWidth) + ": " + std::to_string(_counts[numberOfBins + 1]) + "\n";
+    }
+    return result;
+}
@@ -0,0 +1,32 @@
+//
+//  Histogram.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef Histogram_hpp
+#define Histogram_hpp
+
+#include <string>
+#include <vector>
+
+typedef std::vector<long long> LongLongVector;
+
+// fixed bins of equal width over [minimum, minimum + numberOfBins * binWidth), plus one bin on each side
+// for values outside. histograms with the same bins merge by adding counts.
+class Histogram {
+private:
+    double _minimum;
+    double _binWidth;
+    LongLongVector _counts; // underflow, bins, overflow
+public:
+    Histogram(const double minimum = 0.0, const double binWidth = 1.0, const int numberOfBins = 1) : _minimum(minimum), _binWidth(binWidth), _counts(numberOfBins + 2, 0) {}
+
+    void add(const double value);
+    void merge(const Histogram& other);
+    long long getCount() const;
+    // one line per non-empty bin
+    std::string prettyString() const;
+};
+
+#endif /* Histogram_hpp */
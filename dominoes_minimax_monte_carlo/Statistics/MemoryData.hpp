@@ -0,0 +1,75 @@
+//
+//  MemoryData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MemoryData_hpp
+#define MemoryData_hpp
+
+#include <string>
+#include <vector>
+
+// phase names shared by main, the batch pipeline and the results sinks
+static const char* const kMemoryPhaseGameTree = "Game Tree";
+static const char* const kMemoryPhaseFullMinimax = "Full Minimax";
+static const char* const kMemoryPhaseAlphaBetaMinimax = "Alpha-Beta Minimax";
+static const char* const kMemoryPhaseMonteCarlo = "Monte Carlo";
+
+struct MemoryPhaseData {
+    MemoryPhaseData(const std::string& name = "") : name(name), nodesVisited(0), allocations(0), bytesAllocated(0), liveBytesChange(0), peakLiveBytes(0), residentBytes(0), processPeakResidentBytes(0), overlapping(false) {}
+
+    std::string name;
+    long long nodesVisited; // the phase's own node count, for bytes per node
+    long long allocations;
+    long long bytesAllocated;
+    long long liveBytesChange; // still allocated at the end of the phase
+    long long peakLiveBytes;
+    long long residentBytes; // at the end of the phase
+    long long processPeakResidentBytes; // the peak since the process started, not within the phase
+    bool overlapping; // other work ran alongside the phase, so its allocation figures are not its own
+
+    // 0 without a node count
+    long long getBytesPerNode() const {
+        return nodesVisited > 0 ? bytesAllocated / nodesVisited : 0;
+    }
+
+    std::string prettyString() const {
+        std::string result = name + ": ";
+        if (nodesVisited > 0) {
+            result += std::to_string(nodesVisited) + " nodes, ";
+        }
+        if (overlapping) {
+            result += "overlapping other stages, ";
+        } else {
+            result += std::to_string(allocations) + " allocations, " + std::to_string(bytesAllocated) + " bytes, ";
+            result += std::to_string(liveBytesChange) + " bytes retained, " + std::to_string(peakLiveBytes) + " peak live bytes, ";
+        }
+        result += std::to_string(residentBytes / 1024) + " KB resident, " + std::to_string(processPeakResidentBytes / 1024) + " KB process peak resident\n";
+        return result;
+    }
+};
+
+struct MemoryData {
+    std::vector<MemoryPhaseData> phases;
+
+    // NULL when the phase was not measured
+    const MemoryPhaseData* phaseNamed(const std::string& name) const {
+        for (int i = 0; i < phases.size(); i++) {
+            if (phases[i].name == name) {
+                return &phases[i];
+            }
+        }
+        return NULL;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        for (int i = 0; i < phases.size(); i++) {
+            result += phases[i].prettyString();
+        }
+        return result;
+    }
+};
+
+#endif /* MemoryData_hpp */
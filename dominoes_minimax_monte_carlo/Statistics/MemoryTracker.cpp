@@ -0,0 +1,166 @@
+//
+//  MemoryTracker.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <atomic>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+#include "MemoryTracker.hpp"
+
+static std::atomic<long long> allocationCount(0);
+static std::atomic<long long> allocatedByteCount(0);
+static std::atomic<long long> liveByteCount(0);
+static std::atomic<long long> peakLiveByteCount(0);
+
+#if TRACK_ALLOCATIONS
+
+// each block starts with its size, keeping the 16 byte alignment malloc gives
+static const size_t kAllocationHeaderSize = 16;
+
+static void* trackedAllocate(size_t size) {
+    void* block = malloc(size + kAllocationHeaderSize);
+    if (block == NULL) {
+        return NULL;
+    }
+    *(size_t*)block = size;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedByteCount.fetch_add((long long)size, std::memory_order_relaxed);
+    const long long live = liveByteCount.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+    long long peak = peakLiveByteCount.load(std::memory_order_relaxed);
+    while (live > peak && !peakLiveByteCount.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return (char*)block + kAllocationHeaderSize;
+}
+
+static void trackedFree(void* pointer) {
+    if (pointer == NULL) {
+        return;
+    }
+    void* block = (char*)pointer - kAllocationHeaderSize;
+    liveByteCount.fetch_sub((long long)*(size_t*)block, std::memory_order_relaxed);
+    free(block);
+}
+
+void* operator new(size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (pointer == NULL) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+#endif
+
+void MemoryTracker::_readResidentBytes(long long& residentBytes, long long& peakResidentBytes) {
+    residentBytes = 0;
+    peakResidentBytes = 0;
+#if defined(__linux__)
+    // VmRSS and VmHWM are reported in kB
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), status) != NULL) {
+            long long kilobytes = 0;
+            if (sscanf(line, "VmRSS: %lld", &kilobytes) == 1) {
+                residentBytes = kilobytes * 1024;
+            } else if (sscanf(line, "VmHWM: %lld", &kilobytes) == 1) {
+                peakResidentBytes = kilobytes * 1024;
+            }
+        }
+        fclose(status);
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS) {
+        residentBytes = (long long)info.resident_size;
+        peakResidentBytes = (long long)info.resident_size_max;
+    }
+#else
+    // ru_maxrss is the only portable measure, and only of the peak
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        peakResidentBytes = (long long)usage.ru_maxrss * 1024;
+    }
+#endif
+}
+
+MemorySnapshot MemoryTracker::snapshot() {
+    MemorySnapshot result;
+    result.allocations = allocationCount.load(std::memory_order_relaxed);
+    result.bytesAllocated = allocatedByteCount.load(std::memory_order_relaxed);
+    result.liveBytes = liveByteCount.load(std::memory_order_relaxed);
+    result.peakLiveBytes = peakLiveByteCount.load(std::memory_order_relaxed);
+    _readResidentBytes(result.residentBytes, result.peakResidentBytes);
+    return result;
+}
+
+void MemoryTracker::resetPeakLiveBytes() {
+    peakLiveByteCount.store(liveByteCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+static MemorySnapshot snapshotResettingPeak() {
+    MemoryTracker::resetPeakLiveBytes();
+    return MemoryTracker::snapshot();
+}
+
+MemoryPhase::MemoryPhase(const std::string& name) : _name(name), _start(snapshotResettingPeak()) {}
+
+MemoryPhaseData MemoryPhase::finish(const long long nodesVisited) const {
+    const MemorySnapshot end = MemoryTracker::snapshot();
+    MemoryPhaseData result(_name);
+    result.nodesVisited = nodesVisited;
+    result.allocations = end.allocations - _start.allocations;
+    result.bytesAllocated = end.bytesAllocated - _start.bytesAllocated;
+    result.liveBytesChange = end.liveBytes - _start.liveBytes;
+    // relative to the live bytes when the phase began
+    result.peakLiveBytes = end.peakLiveBytes - _start.liveBytes;
+    result.residentBytes = end.residentBytes;
+    result.processPeakResidentBytes = end.peakResidentBytes;
+    return result;
+}
@@ -0,0 +1,52 @@
+//
+//  MemoryTracker.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef MemoryTracker_hpp
+#define MemoryTracker_hpp
+
+#include "MemoryData.hpp"
+
+// build with -DTRACK_ALLOCATIONS=1 to replace the global operator new/delete with counting versions.
+// without it only resident set sizes are measured and allocation counts stay zero.
+#ifndef TRACK_ALLOCATIONS
+#define TRACK_ALLOCATIONS 0
+#endif
+
+struct MemorySnapshot {
+    MemorySnapshot() : allocations(0), bytesAllocated(0), liveBytes(0), peakLiveBytes(0), residentBytes(0), peakResidentBytes(0) {}
+
+    long long allocations;
+    long long bytesAllocated;
+    long long liveBytes;
+    long long peakLiveBytes; // since the last resetPeakLiveBytes
+    long long residentBytes;
+    long long peakResidentBytes; // since the process started
+};
+
+// process-wide counters, so a phase includes allocations from every thread running during it
+class MemoryTracker {
+private:
+    static void _readResidentBytes(long long& residentBytes, long long& peakResidentBytes);
+public:
+    static inline bool isTrackingAllocations() {
+        return TRACK_ALLOCATIONS != 0;
+    }
+    static MemorySnapshot snapshot();
+    // peak live bytes restart from the current live bytes
+    static void resetPeakLiveBytes();
+};
+
+// measures from construction to finish(). phases should not overlap, since each one resets the live byte peak.
+class MemoryPhase {
+private:
+    const std::string _name;
+    const MemorySnapshot _start;
+public:
+    MemoryPhase(const std::string& name);
+    MemoryPhaseData finish(const long long nodesVisited = 0) const;
+};
+
+#endif /* MemoryTracker_hpp */
@@ -0,0 +1,57 @@
+//
+//  QuantileSketch.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "QuantileSketch.hpp"
+
+QuantileSketch::QuantileSketch() : _count(0) {
+    const double gamma = (1.0 + kQuantileSketchRelativeAccuracy) / (1.0 - kQuantileSketchRelativeAccuracy);
+    _logGamma = std::log(gamma);
+    _minimumIndex = (int)std::ceil(std::log(kQuantileSketchSmallestValue) / _logGamma);
+    const int maximumIndex = (int)std::ceil(std::log(kQuantileSketchLargestValue) / _logGamma);
+    _counts.assign(maximumIndex - _minimumIndex + 1, 0);
+}
+
+int QuantileSketch::_bucketForValue(const double value) const {
+    const double clamped = std::min(std::max(value, kQuantileSketchSmallestValue), kQuantileSketchLargestValue);
+    const int index = (int)std::ceil(std::log(clamped) / _logGamma);
+    return std::min(std::max(index - _minimumIndex, 0), (int)_counts.size() - 1);
+}
+
+void QuantileSketch::add(const double value) {
+    _counts[_bucketForValue(value)]++;
+    _count++;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    for (int i = 0; i < _counts.size(); i++) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+}
+
+double QuantileSketch::getQuantile(const double quantile) const {
+    if (_count == 0) {
+        return 0.0;
+    }
+    const long long rank = (long long)(std::min(std::max(quantile, 0.0), 1.0) * (double)(_count - 1));
+    long long seen = 0;
+    for (int i = 0; i < _counts.size(); i++) {
+        seen += _counts[i];
+        if (seen > rank) {
+            // bucket i holds (gamma^(k - 1), gamma^k]. its midpoint in relative terms is within the accuracy of both ends
+            const double upper = std::exp((double)(i + _minimumIndex) * _logGamma);
+            return 2.0 * upper / (1.0 + std::exp(_logGamma));
+        }
+    }
+    return kQuantileSketchLargestValue;
+}
+
+std::string QuantileSketch::prettyString() const {
+    return "p50 " + std::to_string(getQuantile(0.5)) + ", p90 " + std::to_string(getQuantile(0.9)) + ", p99 " + std::to_string(getQuantile(0.99)) + ", max " + std::to_string(getQuantile(1.0));
+}
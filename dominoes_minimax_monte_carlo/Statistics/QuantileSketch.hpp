@@ -0,0 +1,45 @@
+//
+//  QuantileSketch.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef QuantileSketch_hpp
+#define QuantileSketch_hpp
+
+#include <string>
+#include <vector>
+
+typedef std::vector<long long> LongLongVector;
+
+static const double kQuantileSketchRelativeAccuracy = 0.01;
+static const double kQuantileSketchSmallestValue = 1e-9; // e.g. seconds; anything at or below counts as this
+static const double kQuantileSketchLargestValue = 1e9;
+
+// quantiles of positive values within kQuantileSketchRelativeAccuracy, in constant memory. values fall into
+// logarithmic buckets, so sketches merge by adding bucket counts.
+class QuantileSketch {
+private:
+    double _logGamma;
+    int _minimumIndex;
+    LongLongVector _counts;
+    long long _count;
+
+    int _bucketForValue(const double value) const;
+public:
+    QuantileSketch();
+
+    void add(const double value);
+    void merge(const QuantileSketch& other);
+    // 0 <= quantile <= 1. 0 for an empty sketch
+    double getQuantile(const double quantile) const;
+
+    inline long long getCount() const {
+        return _count;
+    }
+
+    // median, 90th, 99th percentiles and max
+    std::string prettyString() const;
+};
+
+#endif /* QuantileSketch_hpp */
@@ -0,0 +1,64 @@
+//
+//  RunningStatistics.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef RunningStatistics_hpp
+#define RunningStatistics_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// count, mean, variance, min and max in constant memory (Welford). two accumulators merge exactly,
+// so workers can keep their own and combine them at the end.
+struct RunningStatistics {
+    RunningStatistics() : count(0), mean(0.0), sumOfSquaredDeviations(0.0), minimum(0.0), maximum(0.0) {}
+
+    long long count;
+    double mean;
+    double sumOfSquaredDeviations;
+    double minimum;
+    double maximum;
+
+    inline void add(const double value) {
+        count++;
+        const double delta = value - mean;
+        mean += delta / (double)count;
+        sumOfSquaredDeviations += delta * (value - mean);
+        minimum = count == 1 ? value : std::min(minimum, value);
+        maximum = count == 1 ? value : std::max(maximum, value);
+    }
+
+    inline void merge(const RunningStatistics& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const long long mergedCount = count + other.count;
+        const double delta = other.mean - mean;
+        mean += delta * (double)other.count / (double)mergedCount;
+        sumOfSquaredDeviations += other.sumOfSquaredDeviations + delta * delta * (double)count * (double)other.count / (double)mergedCount;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+        count = mergedCount;
+    }
+
+    inline double getVariance() const {
+        return count > 1 ? sumOfSquaredDeviations / (double)(count - 1) : 0.0;
+    }
+
+    inline double getStandardDeviation() const {
+        return std::sqrt(getVariance());
+    }
+
+    std::string prettyString() const {
+        return "n " + std::to_string(count) + ", mean " + std::to_string(mean) + ", sd " + std::to_string(getStandardDeviation()) + ", min " + std::to_string(minimum) + ", max " + std::to_string(maximum);
+    }
+};
+
+#endif /* RunningStatistics_hpp */
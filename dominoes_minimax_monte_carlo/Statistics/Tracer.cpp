@@ -0,0 +1,125 @@
+//
+//  Tracer.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+#include "Tracer.hpp"
+
+typedef std::chrono::steady_clock TraceClock;
+
+// written only by the thread holding it. written counts every event ever recorded, so the ring holds
+// the last min(written, capacity) of them.
+struct TraceBuffer {
+    TraceBuffer(const int threadIndex) : events(1 << kTraceBufferEventsLog2), written(0), threadIndex(threadIndex) {}
+
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written;
+    const int threadIndex;
+};
+
+std::atomic<bool> Tracer::_enabled(false);
+
+static std::mutex traceBuffersLock;
+static std::vector<std::unique_ptr<TraceBuffer>> traceBuffers;
+static std::vector<TraceBuffer*> freeTraceBuffers; // from threads that exited
+static TraceClock::time_point traceStart = TraceClock::now();
+
+static TraceBuffer* acquireTraceBuffer() {
+    std::lock_guard<std::mutex> lock(traceBuffersLock);
+    if (!freeTraceBuffers.empty()) {
+        TraceBuffer* buffer = freeTraceBuffers.back();
+        freeTraceBuffers.pop_back();
+        return buffer;
+    }
+    traceBuffers.push_back(std::unique_ptr<TraceBuffer>(new TraceBuffer((int)traceBuffers.size())));
+    return traceBuffers.back().get();
+}
+
+// hands the thread's buffer on when the thread exits. buffers are never freed, so a dump can still read it.
+struct TraceBufferHolder {
+    TraceBufferHolder() : buffer(NULL) {}
+    ~TraceBufferHolder() {
+        if (buffer != NULL) {
+            std::lock_guard<std::mutex> lock(traceBuffersLock);
+            freeTraceBuffers.push_back(buffer);
+        }
+    }
+
+    TraceBuffer* buffer;
+};
+
+static thread_local TraceBufferHolder traceBufferHolder;
+
+void Tracer::_record(const char* name, const char phase) {
+    TraceBuffer* buffer = traceBufferHolder.buffer;
+    if (buffer == NULL) {
+        buffer = acquireTraceBuffer();
+        traceBufferHolder.buffer = buffer;
+    }
+    const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[index & ((1 << kTraceBufferEventsLog2) - 1)];
+    event.name = name;
+    event.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(TraceClock::now() - traceStart).count();
+    event.phase = phase;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::enable() {
+    std::lock_guard<std::mutex> lock(traceBuffersLock);
+    if (!_enabled.load()) {
+        bool hasEvents = false;
+        for (int i = 0; i < traceBuffers.size(); i++) {
+            hasEvents = hasEvents || traceBuffers[i]->written.load() > 0;
+        }
+        if (!hasEvents) {
+            traceStart = TraceClock::now();
+        }
+    }
+    _enabled.store(true);
+}
+
+void Tracer::disable() {
+    _enabled.store(false);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(traceBuffersLock);
+    for (int i = 0; i < traceBuffers.size(); i++) {
+        traceBuffers[i]->written.store(0);
+    }
+    traceStart = TraceClock::now();
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(traceBuffersLock);
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (int i = 0; i < traceBuffers.size(); i++) {
+        const TraceBuffer& buffer = *traceBuffers[i];
+        const uint64_t written = buffer.written.load(std::memory_order_acquire);
+        if (written == 0) {
+            continue;
+        }
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Worker %d\"}}", first ? "" : ",\n", buffer.threadIndex, buffer.threadIndex);
+        first = false;
+        const uint64_t capacity = 1 << kTraceBufferEventsLog2;
+        for (uint64_t index = written > capacity ? written - capacity : 0; index < written; index++) {
+            const TraceEvent& event = buffer.events[index & (capacity - 1)];
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", event.name, event.phase, event.timestamp / 1000.0, buffer.threadIndex);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
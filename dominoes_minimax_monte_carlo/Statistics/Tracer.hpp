@@ -0,0 +1,74 @@
+//
+//  Tracer.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef Tracer_hpp
+#define Tracer_hpp
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+static const int kTraceBufferEventsLog2 = 16; // events kept per thread. older ones are overwritten
+
+struct TraceEvent {
+    const char* name; // a string literal, so recording never allocates
+    uint64_t timestamp; // nanoseconds since Tracer::enable
+    char phase; // 'B' or 'E', as in the Chrome trace-event format
+};
+
+// begin/end events for a Chrome trace-event timeline. each thread records into its own ring buffer with
+// no locks. a buffer is handed to the next thread when its thread exits, so a timeline row is a worker slot
+// rather than one thread. while disabled, recording an event costs one predictable branch.
+class Tracer {
+private:
+    static std::atomic<bool> _enabled;
+
+    static void _record(const char* name, const char phase);
+public:
+    static void enable();
+    static void disable();
+    // drops every recorded event
+    static void clear();
+    // writes the events recorded so far as Chrome trace-event JSON. call once the traced threads are idle.
+    static bool writeChromeTrace(const std::string& path);
+
+    static inline bool isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+    static inline void begin(const char* name) {
+        if (isEnabled()) {
+            _record(name, 'B');
+        }
+    }
+    static inline void end(const char* name) {
+        if (isEnabled()) {
+            _record(name, 'E');
+        }
+    }
+};
+
+// begin at construction, end at destruction. the end is recorded only if the begin was
+class TraceScope {
+private:
+    const char* _name;
+
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+public:
+    inline TraceScope(const char* name) : _name(NULL) {
+        if (Tracer::isEnabled()) {
+            _name = name;
+            Tracer::begin(name);
+        }
+    }
+    inline ~TraceScope() {
+        if (_name != NULL) {
+            Tracer::end(_name);
+        }
+    }
+};
+
+#endif /* Tracer_hpp */
@@ -0,0 +1,217 @@
+//
+//  SweepCoordinator.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+
+#include "SweepCoordinator.hpp"
+
+static const int kSweepReceiveBufferSize = 1 << 16;
+
+SweepCoordinator::SweepCoordinator(const GameFoundation& gameFoundation, const int firstRank, const int endRank, const int leaseSize, const int leaseTimeoutSeconds) : _gameFoundation(gameFoundation), _leaseTimeoutSeconds(leaseTimeoutSeconds), _listener(-1) {
+    assert(leaseSize > 0);
+    for (int rank = firstRank; rank < endRank; rank += leaseSize) {
+        _leases.push_back(SweepLease(rank, std::min(rank + leaseSize, endRank)));
+    }
+    _leasesLeft = (long long)_leases.size();
+}
+
+SweepCoordinator::~SweepCoordinator() {
+    for (int i = 0; i < _connections.size(); i++) {
+        SweepProtocol::closeSocket(_connections[i].socket);
+    }
+    SweepProtocol::closeSocket(_listener);
+}
+
+bool SweepCoordinator::listen(const int port) {
+    SweepProtocol::closeSocket(_listener);
+    _listener = SweepProtocol::listenOnPort(port);
+    return _listener >= 0;
+}
+
+int SweepCoordinator::getPort() const {
+    return SweepProtocol::getPort(_listener);
+}
+
+int SweepCoordinator::_nextLeaseIndex() const {
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < _leases.size(); i++) {
+        const SweepLease& lease = _leases[i];
+        if (!lease.completed && (lease.holder < 0 || lease.deadline <= now)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SweepCoordinator::_handleRequest(SweepConnection& connection, const ByteVector& payload) {
+    if (payload.size() != 2 * sizeof(uint32_t)) {
+        return false;
+    }
+    if (SweepProtocol::readUInt32(payload.data()) != (uint32_t)_gameFoundation.handSize || SweepProtocol::readUInt32(payload.data() + sizeof(uint32_t)) != (uint32_t)_gameFoundation.maxDominoSuit) {
+        // its records would not mean the same hands, so turn it away
+        SweepProtocol::sendMessage(connection.socket, kSweepMessageDone, ByteVector());
+        return false;
+    }
+
+    const int leaseIndex = _nextLeaseIndex();
+    ByteVector reply;
+    if (leaseIndex < 0) {
+        SweepProtocol::appendUInt32(reply, kSweepWaitMilliseconds);
+        return SweepProtocol::sendMessage(connection.socket, kSweepMessageWait, reply);
+    }
+
+    SweepLease& lease = _leases[leaseIndex];
+    if (lease.issued) {
+        _data.leasesReissued++;
+    }
+    lease.issued = true;
+    lease.holder = connection.socket;
+    lease.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(_leaseTimeoutSeconds);
+    _data.leasesIssued++;
+
+    SweepProtocol::appendUInt32(reply, (uint32_t)leaseIndex);
+    SweepProtocol::appendUInt32(reply, (uint32_t)lease.firstRank);
+    SweepProtocol::appendUInt32(reply, (uint32_t)lease.endRank);
+    return SweepProtocol::sendMessage(connection.socket, kSweepMessageLease, reply);
+}
+
+bool SweepCoordinator::_handleResults(const ByteVector& payload, GameRecordWriter& writer) {
+    if (payload.size() < 2 * sizeof(uint32_t)) {
+        return false;
+    }
+    const uint32_t leaseIndex = SweepProtocol::readUInt32(payload.data());
+    const uint32_t numberOfRecords = SweepProtocol::readUInt32(payload.data() + sizeof(uint32_t));
+    if (leaseIndex >= _leases.size()) {
+        return false;
+    }
+    SweepLease& lease = _leases[leaseIndex];
+    if (numberOfRecords != (uint32_t)(lease.endRank - lease.firstRank)) {
+        return false;
+    }
+
+    // check the whole message before writing any of it
+    std::vector<GameRecord> records(numberOfRecords);
+    std::vector<bool> rankSeen(numberOfRecords, false);
+    int offset = 2 * sizeof(uint32_t);
+    for (int i = 0; i < records.size(); i++) {
+        const int used = SweepProtocol::readRecord(payload.data() + offset, (int)payload.size() - offset, records[i]);
+        if (used == 0 || records[i].maxPlayerHandRank < (uint32_t)lease.firstRank || records[i].maxPlayerHandRank >= (uint32_t)lease.endRank) {
+            return false;
+        }
+        // with as many records as ranks, no repeat means no rank is missing either
+        const int rankIndex = (int)records[i].maxPlayerHandRank - lease.firstRank;
+        if (rankSeen[rankIndex]) {
+            return false;
+        }
+        rankSeen[rankIndex] = true;
+        offset += used;
+    }
+    if (offset != payload.size()) {
+        return false;
+    }
+
+    if (lease.completed) {
+        _data.duplicateResults++;
+        return true;
+    }
+    for (int i = 0; i < records.size(); i++) {
+        writer.write(records[i]);
+    }
+    lease.completed = true;
+    lease.holder = -1;
+    _leasesLeft--;
+    _data.leasesCompleted++;
+    _data.gamesReceived += numberOfRecords;
+    return true;
+}
+
+bool SweepCoordinator::_handleReadable(SweepConnection& connection, GameRecordWriter& writer) {
+    uint8_t received[kSweepReceiveBufferSize];
+    const ssize_t size = recv(connection.socket, received, sizeof(received), 0);
+    if (size <= 0) {
+        return false;
+    }
+    connection.buffer.insert(connection.buffer.end(), received, received + size);
+
+    uint8_t type;
+    ByteVector payload;
+    bool malformed = false;
+    while (SweepProtocol::takeMessage(connection.buffer, type, payload, malformed)) {
+        bool handled = false;
+        if (type == kSweepMessageRequest) {
+            handled = _handleRequest(connection, payload);
+        } else if (type == kSweepMessageResults) {
+            handled = _handleResults(payload, writer);
+        }
+        if (!handled) {
+            return false;
+        }
+    }
+    return !malformed;
+}
+
+void SweepCoordinator::_releaseLeasesHeldBy(const int socket) {
+    for (int i = 0; i < _leases.size(); i++) {
+        if (_leases[i].holder == socket) {
+            _leases[i].holder = -1;
+        }
+    }
+}
+
+SweepData SweepCoordinator::run(GameRecordWriter& writer) {
+    assert(_listener >= 0);
+    // a worker that disconnects mid-send must not kill the coordinator
+    signal(SIGPIPE, SIG_IGN);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<struct pollfd> pollDescriptors;
+    while (_leasesLeft > 0) {
+        pollDescriptors.clear();
+        for (int i = 0; i < _connections.size(); i++) {
+            pollDescriptors.push_back({ _connections[i].socket, POLLIN, 0 });
+        }
+        pollDescriptors.push_back({ _listener, POLLIN, 0 });
+        // wake up now and then even when idle, so leases past their deadline are noticed
+        if (poll(pollDescriptors.data(), (nfds_t)pollDescriptors.size(), kSweepWaitMilliseconds) < 0) {
+            continue;
+        }
+
+        std::vector<SweepConnection> openConnections;
+        for (int i = 0; i < _connections.size(); i++) {
+            if (pollDescriptors[i].revents != 0 && !_handleReadable(_connections[i], writer)) {
+                _releaseLeasesHeldBy(_connections[i].socket);
+                SweepProtocol::closeSocket(_connections[i].socket);
+                continue;
+            }
+            openConnections.push_back(_connections[i]);
+        }
+        _connections.swap(openConnections);
+
+        if (pollDescriptors.back().revents & POLLIN) {
+            const int socket = accept(_listener, NULL, NULL);
+            if (socket >= 0) {
+                const int noDelay = 1;
+                setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                _connections.push_back(SweepConnection(socket));
+                _data.workersConnected++;
+            }
+        }
+    }
+
+    for (int i = 0; i < _connections.size(); i++) {
+        SweepProtocol::sendMessage(_connections[i].socket, kSweepMessageDone, ByteVector());
+        SweepProtocol::closeSocket(_connections[i].socket);
+    }
+    _connections.clear();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    _data.elapsed = elapsed.count();
+    return _data;
+}
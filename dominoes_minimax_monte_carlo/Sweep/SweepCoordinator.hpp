@@ -0,0 +1,73 @@
+//
+//  SweepCoordinator.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SweepCoordinator_hpp
+#define SweepCoordinator_hpp
+
+#include <chrono>
+#include <vector>
+
+#include "GameFoundation.hpp"
+#include "GameRecordWriter.hpp"
+#include "SweepData.hpp"
+#include "SweepProtocol.hpp"
+
+static const int kDefaultSweepLeaseSize = 64;
+static const int kDefaultSweepLeaseTimeoutSeconds = 900;
+static const int kSweepWaitMilliseconds = 1000;
+
+struct SweepLease {
+    SweepLease(int firstRank = 0, int endRank = 0) : firstRank(firstRank), endRank(endRank), holder(-1), issued(false), completed(false) {}
+
+    int firstRank;
+    int endRank;
+    int holder; // socket of the worker playing it, or -1
+    bool issued; // handed out at least once
+    bool completed;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+struct SweepConnection {
+    SweepConnection(int socket = -1) : socket(socket) {}
+
+    int socket;
+    ByteVector buffer; // received bytes not yet forming a whole message
+};
+
+// hands out leases of hand ranks [firstRank, endRank) to workers over TCP and writes the game records they send
+// back. a lease goes back out when its worker disconnects or its deadline passes, and the first results for a
+// lease win, so a dead or slow worker never stalls the sweep. single threaded: one poll loop serves every worker.
+class SweepCoordinator {
+private:
+    const GameFoundation& _gameFoundation;
+    std::vector<SweepLease> _leases;
+    std::vector<SweepConnection> _connections;
+    const int _leaseTimeoutSeconds;
+    int _listener;
+    long long _leasesLeft;
+    SweepData _data;
+
+    int _nextLeaseIndex() const;
+    bool _handleRequest(SweepConnection& connection, const ByteVector& payload);
+    // results for a lease must hold each of its ranks exactly once
+    bool _handleResults(const ByteVector& payload, GameRecordWriter& writer);
+    bool _handleReadable(SweepConnection& connection, GameRecordWriter& writer);
+    void _releaseLeasesHeldBy(const int socket);
+
+    SweepCoordinator(const SweepCoordinator&);
+    SweepCoordinator& operator=(const SweepCoordinator&);
+public:
+    SweepCoordinator(const GameFoundation& gameFoundation, const int firstRank, const int endRank, const int leaseSize = kDefaultSweepLeaseSize, const int leaseTimeoutSeconds = kDefaultSweepLeaseTimeoutSeconds);
+    ~SweepCoordinator();
+
+    // port 0 picks a free port
+    bool listen(const int port);
+    int getPort() const;
+    // serves workers until every lease is completed, then tells them the sweep is done
+    SweepData run(GameRecordWriter& writer);
+};
+
+#endif /* SweepCoordinator_hpp */
@@ -0,0 +1,40 @@
+//
+//  SweepData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SweepData_hpp
+#define SweepData_hpp
+
+#include <string>
+
+struct SweepData {
+    SweepData() : leasesIssued(0), leasesReissued(0), leasesCompleted(0), gamesReceived(0), duplicateResults(0), workersConnected(0), elapsed(0.0) {}
+
+    long long leasesIssued; // including reissues
+    long long leasesReissued; // issued again after a timeout or a lost worker
+    long long leasesCompleted;
+    long long gamesReceived; // written to the record file. duplicates are not counted
+    long long duplicateResults; // results for a lease another worker had already completed
+    long long workersConnected;
+    double elapsed;
+
+    inline double getGamesPerHour() const {
+        return elapsed > 0.0 ? (3600.0 * gamesReceived) / elapsed : 0.0;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Games Received: " + std::to_string(gamesReceived) + "\n";
+        result += "Leases Issued: " + std::to_string(leasesIssued) + " (" + std::to_string(leasesReissued) + " reissued)\n";
+        result += "Leases Completed: " + std::to_string(leasesCompleted) + "\n";
+        result += "Duplicate Results: " + std::to_string(duplicateResults) + "\n";
+        result += "Workers Connected: " + std::to_string(workersConnected) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        result += "Games Per Hour: " + std::to_string(getGamesPerHour()) + "\n";
+        return result;
+    }
+};
+
+#endif /* SweepData_hpp */
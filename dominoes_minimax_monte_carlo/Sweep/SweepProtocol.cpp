@@ -0,0 +1,181 @@
+//
+//  SweepProtocol.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <assert.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SweepProtocol.hpp"
+
+static const int kSweepListenBacklog = 64;
+
+void SweepProtocol::appendUInt32(ByteVector& bytes, const uint32_t value) {
+    const uint32_t networkValue = htonl(value);
+    bytes.insert(bytes.end(), (const uint8_t*)&networkValue, (const uint8_t*)&networkValue + sizeof(networkValue));
+}
+
+uint32_t SweepProtocol::readUInt32(const uint8_t* bytes) {
+    uint32_t networkValue;
+    memcpy(&networkValue, bytes, sizeof(networkValue));
+    return ntohl(networkValue);
+}
+
+void SweepProtocol::appendRecord(ByteVector& bytes, const GameRecord& record) {
+    assert(record.moves.size() <= 0xFF);
+    appendUInt32(bytes, record.maxPlayerHandRank);
+    appendUInt32(bytes, record.minPlayerHandRank);
+    appendUInt32(bytes, record.seed);
+    bytes.push_back((uint8_t)record.moves.size());
+    bytes.insert(bytes.end(), record.moves.begin(), record.moves.end());
+}
+
+int SweepProtocol::readRecord(const uint8_t* bytes, const int size, GameRecord& record) {
+    if (size < kGameRecordFixedSize) {
+        return 0;
+    }
+    const int numberOfMoves = bytes[3 * sizeof(uint32_t)];
+    if (size < kGameRecordFixedSize + numberOfMoves) {
+        return 0;
+    }
+    record.maxPlayerHandRank = readUInt32(bytes);
+    record.minPlayerHandRank = readUInt32(bytes + sizeof(uint32_t));
+    record.seed = readUInt32(bytes + (2 * sizeof(uint32_t)));
+    record.moves.assign(bytes + kGameRecordFixedSize, bytes + kGameRecordFixedSize + numberOfMoves);
+    return kGameRecordFixedSize + numberOfMoves;
+}
+
+static bool sendAll(const int socket, const uint8_t* bytes, size_t size) {
+    while (size > 0) {
+        const ssize_t sent = send(socket, bytes, size, 0);
+        if (sent <= 0) {
+            return false;
+        }
+        bytes += sent;
+        size -= (size_t)sent;
+    }
+    return true;
+}
+
+static bool receiveAll(const int socket, uint8_t* bytes, size_t size) {
+    while (size > 0) {
+        const ssize_t received = recv(socket, bytes, size, 0);
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= (size_t)received;
+    }
+    return true;
+}
+
+bool SweepProtocol::sendMessage(const int socket, const SweepMessageType type, const ByteVector& payload) {
+    ByteVector message;
+    message.reserve(sizeof(uint32_t) + 1 + payload.size());
+    appendUInt32(message, (uint32_t)(1 + payload.size()));
+    message.push_back((uint8_t)type);
+    message.insert(message.end(), payload.begin(), payload.end());
+    return sendAll(socket, message.data(), message.size());
+}
+
+bool SweepProtocol::receiveMessage(const int socket, uint8_t& type, ByteVector& payload) {
+    uint8_t lengthBytes[sizeof(uint32_t)];
+    if (!receiveAll(socket, lengthBytes, sizeof(lengthBytes))) {
+        return false;
+    }
+    const uint32_t length = readUInt32(lengthBytes);
+    if (length == 0 || length > kSweepMaxMessageSize || !receiveAll(socket, &type, 1)) {
+        return false;
+    }
+    payload.resize(length - 1);
+    return payload.empty() || receiveAll(socket, payload.data(), payload.size());
+}
+
+bool SweepProtocol::takeMessage(ByteVector& buffer, uint8_t& type, ByteVector& payload, bool& malformed) {
+    malformed = false;
+    if (buffer.size() < sizeof(uint32_t)) {
+        return false;
+    }
+    const uint32_t length = readUInt32(buffer.data());
+    if (length == 0 || length > kSweepMaxMessageSize) {
+        malformed = true;
+        return false;
+    }
+    if (buffer.size() < sizeof(uint32_t) + length) {
+        return false;
+    }
+    type = buffer[sizeof(uint32_t)];
+    payload.assign(buffer.begin() + sizeof(uint32_t) + 1, buffer.begin() + sizeof(uint32_t) + length);
+    buffer.erase(buffer.begin(), buffer.begin() + sizeof(uint32_t) + length);
+    return true;
+}
+
+int SweepProtocol::listenOnPort(const int port) {
+    const int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return -1;
+    }
+    const int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listener, kSweepListenBacklog) != 0) {
+        close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+int SweepProtocol::getPort(const int socket) {
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+    if (getsockname(socket, (struct sockaddr*)&address, &addressLength) != 0) {
+        return -1;
+    }
+    return ntohs(address.sin_port);
+}
+
+int SweepProtocol::connectToHost(const std::string& host, const int port) {
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = NULL;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+    int result = -1;
+    for (struct addrinfo* address = addresses; address != NULL && result < 0; address = address->ai_next) {
+        const int candidate = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (candidate < 0) {
+            continue;
+        }
+        if (connect(candidate, address->ai_addr, address->ai_addrlen) == 0) {
+            result = candidate;
+        } else {
+            close(candidate);
+        }
+    }
+    freeaddrinfo(addresses);
+    if (result >= 0) {
+        // requests are small and answered one at a time, so do not let them sit in Nagle's buffer
+        const int noDelay = 1;
+        setsockopt(result, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return result;
+}
+
+void SweepProtocol::closeSocket(const int socket) {
+    if (socket >= 0) {
+        close(socket);
+    }
+}
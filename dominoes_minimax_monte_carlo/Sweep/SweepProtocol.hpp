@@ -0,0 +1,59 @@
+//
+//  SweepProtocol.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SweepProtocol_hpp
+#define SweepProtocol_hpp
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "GameRecord.hpp"
+
+static const int kDefaultSweepPort = 7807;
+static const uint32_t kSweepMaxMessageSize = 64 << 20;
+
+enum SweepRole {
+    kSweepRoleNone,
+    kSweepRoleCoordinator,
+    kSweepRoleWorker,
+    kSweepRoleSmokeTest // a coordinator and workers in one process on localhost, checking the sweep end to end
+};
+
+// message types. every message is a uint32 length (type byte and payload), the type byte, then the payload.
+// integers are uint32 in network byte order, so workers and the coordinator need not share an endianness.
+enum SweepMessageType {
+    kSweepMessageRequest = 1, // worker: handSize, maxDominoSuit
+    kSweepMessageLease = 2, // coordinator: leaseId, firstRank, endRank
+    kSweepMessageWait = 3, // coordinator: milliseconds to wait before requesting again, as every open lease is out
+    kSweepMessageDone = 4, // coordinator: the sweep is finished, or the worker's game settings do not match
+    kSweepMessageResults = 5 // worker: leaseId, record count, then that many game records, as in the
+                               // file layout but with the uint32 fields in network byte order
+};
+
+// blocking socket helpers shared by the coordinator and the workers
+class SweepProtocol {
+public:
+    static void appendUInt32(ByteVector& bytes, const uint32_t value);
+    static uint32_t readUInt32(const uint8_t* bytes);
+    static void appendRecord(ByteVector& bytes, const GameRecord& record);
+    // reads one record from the start of bytes. returns the bytes used, or 0 if bytes ends mid-record
+    static int readRecord(const uint8_t* bytes, const int size, GameRecord& record);
+
+    static bool sendMessage(const int socket, const SweepMessageType type, const ByteVector& payload);
+    static bool receiveMessage(const int socket, uint8_t& type, ByteVector& payload);
+    // removes one complete message from the front of buffer. false if buffer does not hold one yet, or holds
+    // an oversized one, which sets malformed
+    static bool takeMessage(ByteVector& buffer, uint8_t& type, ByteVector& payload, bool& malformed);
+
+    // -1 on failure. port 0 picks a free port, which getPort reports
+    static int listenOnPort(const int port);
+    static int getPort(const int socket);
+    static int connectToHost(const std::string& host, const int port);
+    static void closeSocket(const int socket);
+};
+
+#endif /* SweepProtocol_hpp */
@@ -0,0 +1,63 @@
+//
+//  SweepWorker.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <signal.h>
+#include <thread>
+
+#include "SweepWorker.hpp"
+#include "GameRecord.hpp"
+#include "MonteCarloDataGenerator.hpp"
+#include "SweepProtocol.hpp"
+
+long long SweepWorker::run(const std::string& host, const int port, const GameFoundation& gameFoundation, const MonteCarloSettings& settings) {
+    const int socket = SweepProtocol::connectToHost(host, port);
+    if (socket < 0) {
+        return -1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    ByteVector request;
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.handSize);
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.maxDominoSuit);
+
+    long long gamesPlayed = 0;
+    uint8_t type;
+    ByteVector payload;
+    while (SweepProtocol::sendMessage(socket, kSweepMessageRequest, request) && SweepProtocol::receiveMessage(socket, type, payload)) {
+        if (type == kSweepMessageWait && payload.size() == sizeof(uint32_t)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SweepProtocol::readUInt32(payload.data())));
+            continue;
+        }
+        if (type != kSweepMessageLease || payload.size() != 3 * sizeof(uint32_t)) {
+            break;
+        }
+        const uint32_t leaseIndex = SweepProtocol::readUInt32(payload.data());
+        const int firstRank = (int)SweepProtocol::readUInt32(payload.data() + sizeof(uint32_t));
+        const int endRank = (int)SweepProtocol::readUInt32(payload.data() + (2 * sizeof(uint32_t)));
+
+        GameVector games;
+        games.reserve(endRank - firstRank);
+        for (int rank = firstRank; rank < endRank; rank++) {
+            games.push_back(Game::gameWithStartingMaxPayerHandNumber(gameFoundation, rank));
+        }
+        MonteCarloPoolData poolData;
+        const MonteCarloDataVector results = MonteCarloDataGenerator::generateDataForGames(games, settings, poolData);
+
+        ByteVector message;
+        SweepProtocol::appendUInt32(message, leaseIndex);
+        SweepProtocol::appendUInt32(message, (uint32_t)results.size());
+        for (int i = 0; i < results.size(); i++) {
+            SweepProtocol::appendRecord(message, GameRecord::recordForPath(results[i].path, settings.seed));
+        }
+        if (!SweepProtocol::sendMessage(socket, kSweepMessageResults, message)) {
+            break;
+        }
+        gamesPlayed += (long long)results.size();
+    }
+
+    SweepProtocol::closeSocket(socket);
+    return gamesPlayed;
+}
@@ -0,0 +1,23 @@
+//
+//  SweepWorker.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SweepWorker_hpp
+#define SweepWorker_hpp
+
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "MonteCarloSettings.hpp"
+
+class SweepWorker {
+public:
+    // leases hand ranks from the coordinator at host:port and plays a Monte Carlo game for each one on the shared game
+    // pool, sending the game records back, until the coordinator says the sweep is done or goes away.
+    // returns the games played, or -1 if the coordinator could not be reached.
+    static long long run(const std::string& host, const int port, const GameFoundation& gameFoundation, const MonteCarloSettings& settings);
+};
+
+#endif /* SweepWorker_hpp */
@@ -0,0 +1,190 @@
+//
+//  CpuTopology.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "CpuTopology.hpp"
+
+static const char* kSysfsCpuPath = "/sys/devices/system/cpu";
+static const char* kSysfsNodePath = "/sys/devices/system/node";
+
+CpuTopology::CpuTopology() : _numberOfCores(0), _numberOfPackages(0), _numberOfNodes(0), _fromSysfs(false) {
+    _discover();
+    if (_cpus.empty()) {
+        _guess();
+    }
+}
+
+const CpuTopology& CpuTopology::current() {
+    static const CpuTopology topology;
+    return topology;
+}
+
+// parses a kernel cpu list such as "0-3,8-11"
+std::vector<int> CpuTopology::_cpuList(const std::string& path) {
+    std::vector<int> result;
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == NULL) {
+        return result;
+    }
+    char line[4096];
+    if (fgets(line, sizeof(line), file) != NULL) {
+        char* range = strtok(line, ",\n");
+        while (range != NULL) {
+            int first = 0;
+            int last = 0;
+            const int fields = sscanf(range, "%d-%d", &first, &last);
+            if (fields == 1) {
+                last = first;
+            }
+            for (int cpu = first; fields >= 1 && cpu <= last; cpu++) {
+                result.push_back(cpu);
+            }
+            range = strtok(NULL, ",\n");
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+int CpuTopology::_readInt(const std::string& path, const int defaultValue) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == NULL) {
+        return defaultValue;
+    }
+    int value = defaultValue;
+    if (fscanf(file, "%d", &value) != 1) {
+        value = defaultValue;
+    }
+    fclose(file);
+    return value;
+}
+
+void CpuTopology::_discover() {
+#if defined(__linux__)
+    const std::vector<int> onlineCpus = _cpuList(std::string(kSysfsCpuPath) + "/online");
+    if (onlineCpus.empty()) {
+        return;
+    }
+
+    // machines without NUMA have no node directory, and everything is node 0
+    std::map<int, int> nodeByCpu;
+    DIR* nodeDirectory = opendir(kSysfsNodePath);
+    if (nodeDirectory != NULL) {
+        struct dirent* entry;
+        while ((entry = readdir(nodeDirectory)) != NULL) {
+            int node = 0;
+            if (strncmp(entry->d_name, "node", 4) != 0 || sscanf(entry->d_name + 4, "%d", &node) != 1) {
+                continue;
+            }
+            const std::vector<int> nodeCpus = _cpuList(std::string(kSysfsNodePath) + "/" + entry->d_name + "/cpulist");
+            for (int i = 0; i < nodeCpus.size(); i++) {
+                nodeByCpu[nodeCpus[i]] = node;
+            }
+        }
+        closedir(nodeDirectory);
+    }
+
+    std::map<std::pair<int, int>, int> threadsByCore;
+    std::set<int> packages;
+    std::set<int> nodes;
+    for (int i = 0; i < onlineCpus.size(); i++) {
+        const int cpu = onlineCpus[i];
+        const std::string topologyPath = std::string(kSysfsCpuPath) + "/cpu" + std::to_string(cpu) + "/topology/";
+        const int core = _readInt(topologyPath + "core_id", cpu);
+        // some virtual machines report -1 for the package
+        const int package = std::max(0, _readInt(topologyPath + "physical_package_id", 0));
+        const int node = nodeByCpu.count(cpu) > 0 ? nodeByCpu[cpu] : 0;
+        // online cpus are in increasing order, so a core's first hardware thread is its lowest cpu
+        const int siblingRank = threadsByCore[std::make_pair(package, core)]++;
+        _cpus.push_back(CpuInfo(cpu, core, package, node, siblingRank));
+        packages.insert(package);
+        nodes.insert(node);
+    }
+    std::stable_sort(_cpus.begin(), _cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        if (a.siblingRank != b.siblingRank) {
+            return a.siblingRank < b.siblingRank;
+        }
+        if (a.node != b.node) {
+            return a.node < b.node;
+        }
+        if (a.package != b.package) {
+            return a.package < b.package;
+        }
+        return a.core < b.core;
+    });
+    _numberOfCores = (int)threadsByCore.size();
+    _numberOfPackages = (int)packages.size();
+    _numberOfNodes = (int)nodes.size();
+    _fromSysfs = true;
+#endif
+}
+
+void CpuTopology::_guess() {
+    const int cpus = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        _cpus.push_back(CpuInfo(cpu, cpu, 0, 0, 0));
+    }
+    _numberOfCores = cpus;
+    _numberOfPackages = 1;
+    _numberOfNodes = 1;
+    _fromSysfs = false;
+}
+
+const CpuInfo& CpuTopology::cpuForWorker(const int workerIndex) const {
+    return _cpus[workerIndex % _cpus.size()];
+}
+
+bool CpuTopology::placeCurrentThread(const ThreadPlacement placement, const int workerIndex) const {
+    if (placement == kThreadPlacementNone) {
+        return true;
+    }
+#if defined(__linux__)
+    if (!_fromSysfs) {
+        return false;
+    }
+    const CpuInfo& target = cpuForWorker(workerIndex);
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int i = 0; i < _cpus.size(); i++) {
+        if ((placement == kThreadPlacementCore && _cpus[i].cpu == target.cpu) ||
+            (placement == kThreadPlacementNode && _cpus[i].node == target.node)) {
+            CPU_SET(_cpus[i].cpu, &cpuSet);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    // macOS only takes affinity hints, and only between threads of one process
+    return false;
+#endif
+}
+
+std::string CpuTopology::prettyString() const {
+    std::string result = "";
+    result += "Source: " + std::string(_fromSysfs ? "sysfs" : "guessed") + "\n";
+    result += "CPUs: " + std::to_string(_cpus.size()) + "\n";
+    result += "Cores: " + std::to_string(_numberOfCores) + "\n";
+    result += "Packages: " + std::to_string(_numberOfPackages) + "\n";
+    result += "NUMA Nodes: " + std::to_string(_numberOfNodes) + "\n";
+    result += "Worker Order:";
+    for (int i = 0; i < _cpus.size(); i++) {
+        result += " " + std::to_string(_cpus[i].cpu) + "/n" + std::to_string(_cpus[i].node);
+    }
+    result += "\n";
+    return result;
+}
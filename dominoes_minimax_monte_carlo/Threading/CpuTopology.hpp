@@ -0,0 +1,67 @@
+//
+//  CpuTopology.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef CpuTopology_hpp
+#define CpuTopology_hpp
+
+#include <string>
+#include <vector>
+
+static const int kCacheLineSize = 64; // bytes. per-thread state padded to this never shares a line with another thread's
+
+enum ThreadPlacement {
+    kThreadPlacementNone, // workers run wherever the scheduler puts them
+    kThreadPlacementNode, // each worker is confined to the cpus of its NUMA node
+    kThreadPlacementCore // each worker is pinned to one cpu
+};
+
+struct CpuInfo {
+    CpuInfo(int cpu = 0, int core = 0, int package = 0, int node = 0, int siblingRank = 0) : cpu(cpu), core(core), package(package), node(node), siblingRank(siblingRank) {}
+
+    int cpu; // the id the kernel schedules on
+    int core; // physical core id, unique only within its package
+    int package; // socket
+    int node; // NUMA node
+    int siblingRank; // 0 for the first hardware thread of its core, 1 for the second, ...
+};
+
+typedef std::vector<CpuInfo> CpuInfoVector;
+
+// the online cpus, read from sysfs on Linux. elsewhere, or when sysfs is not readable, every cpu is its own
+// core on one node and placement does nothing. cpus are kept in the order workers are placed on them: the first
+// hardware thread of every core before any second one, and within that node by node, so a few workers share
+// one node's cache and memory (and the solution store they write) before spilling onto the next.
+class CpuTopology {
+private:
+    CpuInfoVector _cpus;
+    int _numberOfCores;
+    int _numberOfPackages;
+    int _numberOfNodes;
+    bool _fromSysfs;
+
+    CpuTopology();
+    void _discover();
+    void _guess();
+    static std::vector<int> _cpuList(const std::string& path);
+    static int _readInt(const std::string& path, const int defaultValue);
+public:
+    // discovered once per process
+    static const CpuTopology& current();
+
+    inline int numberOfCpus() const {
+        return (int)_cpus.size();
+    }
+    inline int numberOfNodes() const {
+        return _numberOfNodes;
+    }
+    // the cpu worker workerIndex is placed on. workers beyond the number of cpus wrap around.
+    const CpuInfo& cpuForWorker(const int workerIndex) const;
+    // confines the calling thread as placement says for worker workerIndex. false if it could not be placed.
+    bool placeCurrentThread(const ThreadPlacement placement, const int workerIndex) const;
+    std::string prettyString() const;
+};
+
+#endif /* CpuTopology_hpp */
@@ -0,0 +1,139 @@
+//
+//  Tournament.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <atomic>
+#include <thread>
+#include <time.h>
+
+#include "Tournament.hpp"
+#include "MonteCarloDataGenerator.hpp"
+
+double Tournament::_threadCpuSeconds() {
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (double)time.tv_sec + ((double)time.tv_nsec / 1e9);
+}
+
+int Tournament::_chooseChildIndex(const TournamentStrategy& strategy, const Game& workGame, const GameState& state, const unsigned int seed, std::mt19937& engine) {
+    const int numberOfChildren = (int)state.children.size();
+    switch (strategy.type) {
+        case kTournamentStrategyMonteCarlo: {
+            MonteCarloSettings settings = strategy.settings;
+            settings.seed = seed;
+            settings.numberOfThreads = 1; // the tournament already keeps every core busy with games
+            DominoPointerVector childTiles;
+            const IntVector childCounts = MonteCarloDataGenerator::voteCountsForState(workGame, state, settings, childTiles);
+            assert(childCounts.size() == numberOfChildren);
+            // first child with the most votes, as MonteCarloDataGenerator picks. none only when every sample is lost
+            return (int)(std::max_element(childCounts.begin(), childCounts.end()) - childCounts.begin());
+        }
+        case kTournamentStrategyGreedy: {
+            int bestChildIndex = 0;
+            int bestTileTotal = -1;
+            for (int i = 0; i < numberOfChildren; i++) {
+                const GameState& child = state.children[i];
+                if (child.playedTiles.size() > state.playedTiles.size() && child.playedTiles.back()->getTileTotal() > bestTileTotal) {
+                    bestTileTotal = child.playedTiles.back()->getTileTotal();
+                    bestChildIndex = i;
+                }
+            }
+            return bestChildIndex;
+        }
+        case kTournamentStrategyRandom:
+        default:
+            return std::uniform_int_distribution<int>(0, numberOfChildren - 1)(engine);
+    }
+}
+
+int Tournament::_playGame(const Game& game, const TournamentStrategy& maxStrategy, const TournamentStrategy& minStrategy, const unsigned int seed, TournamentStrategyData& maxStrategyData, TournamentStrategyData& minStrategyData) {
+    Game workGame = game; // possible tiles follow what each player has shown
+    std::mt19937 engine(seed);
+
+    // GameState is not assignable, so the states played through are kept in a vector
+    GameStateVector line;
+    line.reserve(game.gameFoundation.maxDepth + 1);
+    line.push_back(GameState(game));
+    while (!line.back().isLeafNode()) {
+        GameState state = GameState::stateRemovingChildren(line.back());
+        state.expandAndGenerateChildren();
+
+        int childIndex = 0;
+        if (state.children.size() > 1) {
+            const bool isMaxPlayer = state.isMaxPlayer();
+            TournamentStrategyData& strategyData = isMaxPlayer ? maxStrategyData : minStrategyData;
+            const double cpuStart = _threadCpuSeconds();
+            childIndex = _chooseChildIndex(isMaxPlayer ? maxStrategy : minStrategy, workGame, state, seed + (unsigned int)state.depth, engine);
+            strategyData.cpuSeconds += _threadCpuSeconds() - cpuStart;
+            strategyData.decisions++;
+        }
+
+        MonteCarloDataGenerator::updatePossibleTilesForMove(state, state.children[childIndex], workGame);
+        line.push_back(GameState::stateRemovingChildren(state.children[childIndex]));
+        line.back().parent = NULL;
+    }
+
+    const int score = line.back().getScore();
+    maxStrategyData.games++;
+    maxStrategyData.points.add(score);
+    minStrategyData.games++;
+    minStrategyData.points.add(-score);
+    return score;
+}
+
+TournamentData Tournament::run(const GameFoundation& gameFoundation, const TournamentStrategyVector& strategies, const int deals, const unsigned int seed, const int numberOfThreads) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    TournamentData result;
+    result.deals = deals;
+    result.numberOfThreads = numberOfThreads > 0 ? numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+    for (int i = 0; i < strategies.size(); i++) {
+        result.strategies.push_back(TournamentStrategyData(strategies[i].name));
+    }
+    for (int i = 0; i < strategies.size(); i++) {
+        for (int j = i + 1; j < strategies.size(); j++) {
+            result.pairings.push_back(TournamentPairingData(i, j));
+        }
+    }
+
+    // a job is one deal of one pairing, both seatings. workers keep their own totals and merge them at the end.
+    const int numberOfJobs = (int)result.pairings.size() * deals;
+    std::atomic<int> nextJob(0);
+    std::vector<std::vector<TournamentStrategyData>> strategyDataByThread(result.numberOfThreads, result.strategies);
+    std::vector<std::vector<TournamentPairingData>> pairingDataByThread(result.numberOfThreads, result.pairings);
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < result.numberOfThreads; threadIndex++) {
+        threads.push_back(std::thread([&, threadIndex]() {
+            std::vector<TournamentStrategyData>& strategyData = strategyDataByThread[threadIndex];
+            std::vector<TournamentPairingData>& pairingData = pairingDataByThread[threadIndex];
+            for (int job = nextJob++; job < numberOfJobs; job = nextJob++) {
+                TournamentPairingData& pairing = pairingData[job / deals];
+                const unsigned int dealSeed = seed + (unsigned int)(job % deals);
+                const Game game = Game::gameForSeed(gameFoundation, dealSeed);
+                const int first = pairing.firstStrategyIndex;
+                const int second = pairing.secondStrategyIndex;
+                const int firstSeatedMaxScore = _playGame(game, strategies[first], strategies[second], dealSeed, strategyData[first], strategyData[second]);
+                const int secondSeatedMaxScore = _playGame(game, strategies[second], strategies[first], dealSeed, strategyData[second], strategyData[first]);
+                pairing.pointDifferential.add((firstSeatedMaxScore - secondSeatedMaxScore) / 2.0);
+            }
+        }));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    for (int threadIndex = 0; threadIndex < result.numberOfThreads; threadIndex++) {
+        for (int i = 0; i < result.strategies.size(); i++) {
+            result.strategies[i].merge(strategyDataByThread[threadIndex][i]);
+        }
+        for (int i = 0; i < result.pairings.size(); i++) {
+            result.pairings[i].pointDifferential.merge(pairingDataByThread[threadIndex][i].pointDifferential);
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    result.elapsed = elapsed.count();
+    return result;
+}
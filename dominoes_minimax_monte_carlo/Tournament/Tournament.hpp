@@ -0,0 +1,33 @@
+//
+//  Tournament.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef Tournament_hpp
+#define Tournament_hpp
+
+#include <random>
+#include <vector>
+
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "TournamentData.hpp"
+#include "TournamentStrategy.hpp"
+
+typedef std::vector<TournamentStrategy> TournamentStrategyVector;
+
+// round robin self-play. every pairing plays the same seeded deals, each twice with the seats swapped,
+// and deals are spread over worker threads that each play one game at a time, so a Monte Carlo strategy
+// samples on its own thread and its cpu time per decision is its real cost.
+class Tournament {
+private:
+    static double _threadCpuSeconds();
+    static int _chooseChildIndex(const TournamentStrategy& strategy, const Game& workGame, const GameState& state, const unsigned int seed, std::mt19937& engine);
+    // plays the deal with maxStrategy in the max seat and returns the final score (positive when max wins)
+    static int _playGame(const Game& game, const TournamentStrategy& maxStrategy, const TournamentStrategy& minStrategy, const unsigned int seed, TournamentStrategyData& maxStrategyData, TournamentStrategyData& minStrategyData);
+public:
+    static TournamentData run(const GameFoundation& gameFoundation, const TournamentStrategyVector& strategies, const int deals, const unsigned int seed, const int numberOfThreads = 0);
+};
+
+#endif /* Tournament_hpp */
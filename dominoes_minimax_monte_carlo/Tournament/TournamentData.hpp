@@ -0,0 +1,80 @@
+//
+//  TournamentData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TournamentData_hpp
+#define TournamentData_hpp
+
+#include <string>
+#include <vector>
+
+#include "RunningStatistics.hpp"
+
+static const double kTournamentConfidenceZ = 1.96; // 95% normal interval
+
+// one strategy against another over duplicate deals. each deal is played twice with the seats swapped,
+// so the luck of the deal cancels and the pair's average is one independent observation.
+struct TournamentPairingData {
+    TournamentPairingData(int firstStrategyIndex = 0, int secondStrategyIndex = 0) : firstStrategyIndex(firstStrategyIndex), secondStrategyIndex(secondStrategyIndex) {}
+
+    int firstStrategyIndex;
+    int secondStrategyIndex;
+    RunningStatistics pointDifferential; // first strategy's points per game, averaged over the two seatings of a deal
+
+    inline double getConfidenceRadius() const {
+        return pointDifferential.count > 1 ? kTournamentConfidenceZ * pointDifferential.getStandardDeviation() / std::sqrt((double)pointDifferential.count) : 0.0;
+    }
+};
+
+struct TournamentStrategyData {
+    TournamentStrategyData(const std::string& name = "") : name(name), games(0), decisions(0), cpuSeconds(0.0) {}
+
+    std::string name;
+    long long games;
+    long long decisions; // moves with more than one choice
+    double cpuSeconds; // thread cpu time spent choosing those moves
+    RunningStatistics points; // per game, from the strategy's seat
+
+    inline double getCpuSecondsPerDecision() const {
+        return decisions > 0 ? cpuSeconds / (double)decisions : 0.0;
+    }
+
+    inline void merge(const TournamentStrategyData& other) {
+        games += other.games;
+        decisions += other.decisions;
+        cpuSeconds += other.cpuSeconds;
+        points.merge(other.points);
+    }
+};
+
+struct TournamentData {
+    TournamentData() : deals(0), numberOfThreads(0), elapsed(0.0) {}
+
+    int deals; // per pairing
+    int numberOfThreads;
+    double elapsed;
+    std::vector<TournamentStrategyData> strategies;
+    std::vector<TournamentPairingData> pairings;
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Deals Per Pairing: " + std::to_string(deals) + " (each played in both seats)\n";
+        result += "Threads: " + std::to_string(numberOfThreads) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        for (int i = 0; i < pairings.size(); i++) {
+            const TournamentPairingData& pairing = pairings[i];
+            result += strategies[pairing.firstStrategyIndex].name + " vs " + strategies[pairing.secondStrategyIndex].name + ": ";
+            result += std::to_string(pairing.pointDifferential.mean) + " +/- " + std::to_string(pairing.getConfidenceRadius()) + " points per game\n";
+        }
+        for (int i = 0; i < strategies.size(); i++) {
+            const TournamentStrategyData& strategy = strategies[i];
+            result += strategy.name + ": " + std::to_string(strategy.points.mean) + " points per game, " + std::to_string(strategy.decisions) + " decisions, ";
+            result += std::to_string(1000.0 * strategy.getCpuSecondsPerDecision()) + " cpu ms per decision\n";
+        }
+        return result;
+    }
+};
+
+#endif /* TournamentData_hpp */
@@ -0,0 +1,33 @@
+//
+//  TournamentStrategy.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TournamentStrategy_hpp
+#define TournamentStrategy_hpp
+
+#include <string>
+
+#include "MonteCarloSettings.hpp"
+
+enum TournamentStrategyType {
+    kTournamentStrategyMonteCarlo, // perfect information Monte Carlo with the strategy's settings
+    kTournamentStrategyGreedy, // plays its heaviest tile
+    kTournamentStrategyRandom // plays a random legal move
+};
+
+struct TournamentStrategy {
+    TournamentStrategy(TournamentStrategyType type = kTournamentStrategyGreedy, const std::string& name = "Greedy", const MonteCarloSettings& settings = MonteCarloSettings()) : type(type), name(name), settings(settings) {}
+
+    TournamentStrategyType type;
+    std::string name;
+    MonteCarloSettings settings; // only used by kTournamentStrategyMonteCarlo. the seed is replaced per game
+
+    // settings come from the caller, so the tournament plays with the same reuse and search options as main
+    static inline TournamentStrategy monteCarlo(const MonteCarloSettings& settings) {
+        return TournamentStrategy(kTournamentStrategyMonteCarlo, "Monte Carlo " + std::to_string(settings.numberOfSamples), settings);
+    }
+};
+
+#endif /* TournamentStrategy_hpp */
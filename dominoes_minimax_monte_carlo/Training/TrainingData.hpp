@@ -0,0 +1,42 @@
+//
+//  TrainingData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingData_hpp
+#define TrainingData_hpp
+
+#include <string>
+#include <vector>
+
+struct TrainingData {
+    TrainingData() : gamesPlayed(0), positionsWritten(0), nodesVisited(0), numberOfThreads(0), elapsed(0.0) {}
+
+    int gamesPlayed;
+    long long positionsWritten;
+    long long nodesVisited;
+    int numberOfThreads;
+    double elapsed;
+    std::vector<std::string> shardPaths;
+
+    inline double getPositionsPerHour() const {
+        return elapsed > 0.0 ? (3600.0 * (double)positionsWritten) / elapsed : 0.0;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        result += "Games Played: " + std::to_string(gamesPlayed) + "\n";
+        result += "Positions Written: " + std::to_string(positionsWritten) + "\n";
+        result += "Nodes Visited: " + std::to_string(nodesVisited) + "\n";
+        result += "Threads: " + std::to_string(numberOfThreads) + "\n";
+        result += "Elapsed Time: " + std::to_string(elapsed) + " s\n";
+        result += "Positions Per Hour: " + std::to_string(getPositionsPerHour()) + "\n";
+        for (int i = 0; i < shardPaths.size(); i++) {
+            result += "Shard: " + shardPaths[i] + "\n";
+        }
+        return result;
+    }
+};
+
+#endif /* TrainingData_hpp */
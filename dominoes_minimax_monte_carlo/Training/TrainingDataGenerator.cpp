@@ -0,0 +1,109 @@
+//
+//  TrainingDataGenerator.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <string.h>
+#include <thread>
+
+#include "TrainingDataGenerator.hpp"
+#include "Game.hpp"
+#include "GameRecord.hpp"
+#include "MinimaxSearch.hpp"
+
+std::string TrainingDataGenerator::pathForShard(const std::string& pathPrefix, const int shardIndex) {
+    return pathPrefix + "." + std::to_string(shardIndex);
+}
+
+TrainingRecord TrainingDataGenerator::_recordForState(const GameState& state, const int minimaxValue, const uint8_t bestMove) {
+    const GameFoundation& gameFoundation = state.game.gameFoundation;
+    const PositionKey positionKey = state.positionKey();
+    TrainingRecord record;
+    memset(&record, 0, sizeof(record));
+    record.maxPlayerTiles = positionKey.maxPlayerTiles;
+    record.minPlayerTiles = positionKey.minPlayerTiles;
+    for (int i = 0; i < state.playedTiles.size(); i++) {
+        record.playedTiles |= gameFoundation.tileMaskForDomino(state.playedTiles[i]);
+    }
+    record.minimaxValue = (int16_t)minimaxValue;
+    record.layoutFirst = positionKey.layoutFirst;
+    record.layoutSecond = positionKey.layoutSecond;
+    record.flags = (state.isMaxPlayer() ? 0 : kTrainingRecordMinPlayerTurn) | (state.previousPlayerPassed ? kTrainingRecordPreviousPlayerPassed : 0);
+    record.bestMove = bestMove;
+    record.movesPlayed = (uint8_t)state.depth;
+    return record;
+}
+
+void TrainingDataGenerator::_playGame(const GameFoundation& gameFoundation, const unsigned int seed, const double randomMoveRate, SolutionStore& solutionStore, TrainingRecordWriter& writer, long long& nodesVisited) {
+    const Game game = Game::gameForSeed(gameFoundation, seed);
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> moveDistribution(0.0, 1.0);
+
+    GameStateVector states; // holds the current state, since states cannot be assigned
+    states.push_back(GameState(game));
+    while (!states.back().isLeafNode()) {
+        GameState& state = states.back();
+        const MinimaxData data = AlphaBetaMinimaxSearch::runOnState(state, false, &solutionStore);
+        nodesVisited += data.nodesVisited;
+
+        // fail-hard children after the best can tie it with a bound, so the best is the first child with the value
+        int bestChildIndex = 0;
+        while (state.children[bestChildIndex].minimaxValue != data.minimaxValue) {
+            bestChildIndex++;
+        }
+        writer.write(_recordForState(state, data.minimaxValue, GameRecord::moveForStates(state, state.children[bestChildIndex])));
+
+        int childIndex = bestChildIndex;
+        if (moveDistribution(engine) < randomMoveRate) {
+            childIndex = (int)(engine() % (uint32_t)state.children.size());
+        }
+        GameState nextState = GameState::stateRemovingChildren(state.children[childIndex]);
+        nextState.parent = NULL;
+        states.clear();
+        states.push_back(nextState);
+    }
+}
+
+TrainingData TrainingDataGenerator::run(const GameFoundation& gameFoundation, const TrainingSettings& settings) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    TrainingData result;
+    result.numberOfThreads = settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency());
+
+    std::vector<TrainingRecordWriter> writers(result.numberOfThreads);
+    for (int i = 0; i < result.numberOfThreads; i++) {
+        const std::string path = pathForShard(settings.pathPrefix, i);
+        if (!writers[i].open(path, gameFoundation)) {
+            result.shardPaths.clear();
+            return result;
+        }
+        result.shardPaths.push_back(path);
+    }
+
+    std::atomic<int> nextGame(0);
+    std::vector<long long> nodesVisitedByThread(result.numberOfThreads, 0);
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < result.numberOfThreads; threadIndex++) {
+        threads.push_back(std::thread([&, threadIndex]() {
+            SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, settings.persistentSolutionCache);
+            long long nodesVisited = 0;
+            for (int gameIndex = nextGame++; gameIndex < settings.numberOfGames; gameIndex = nextGame++) {
+                _playGame(gameFoundation, settings.seed + (unsigned int)gameIndex, settings.randomMoveRate, solutionStore, writers[threadIndex], nodesVisited);
+            }
+            nodesVisitedByThread[threadIndex] = nodesVisited;
+        }));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    for (int i = 0; i < result.numberOfThreads; i++) {
+        writers[i].close();
+        result.positionsWritten += writers[i].getRecordsWritten();
+        result.nodesVisited += nodesVisitedByThread[i];
+    }
+    result.gamesPlayed = settings.numberOfGames;
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    result.elapsed = elapsed.count();
+    return result;
+}
@@ -0,0 +1,35 @@
+//
+//  TrainingDataGenerator.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingDataGenerator_hpp
+#define TrainingDataGenerator_hpp
+
+#include <atomic>
+#include <random>
+
+#include "GameFoundation.hpp"
+#include "GameState.hpp"
+#include "SolutionStore.hpp"
+#include "TrainingData.hpp"
+#include "TrainingRecord.hpp"
+#include "TrainingRecordWriter.hpp"
+#include "TrainingSettings.hpp"
+
+// labels positions with exact values for training. every position of each game is solved with
+// alpha-beta and written with its best move, and the game goes on with that move or, at
+// settings.randomMoveRate, a random one. each thread plays whole games into its own shard and
+// keeps its own solution store, since later positions of a game are subtrees of earlier ones.
+class TrainingDataGenerator {
+private:
+    static TrainingRecord _recordForState(const GameState& state, const int minimaxValue, const uint8_t bestMove);
+    static void _playGame(const GameFoundation& gameFoundation, const unsigned int seed, const double randomMoveRate, SolutionStore& solutionStore, TrainingRecordWriter& writer, long long& nodesVisited);
+public:
+    static std::string pathForShard(const std::string& pathPrefix, const int shardIndex);
+    // returns data with no shard paths if a shard could not be created
+    static TrainingData run(const GameFoundation& gameFoundation, const TrainingSettings& settings);
+};
+
+#endif /* TrainingDataGenerator_hpp */
@@ -0,0 +1,44 @@
+//
+//  TrainingRecord.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingRecord_hpp
+#define TrainingRecord_hpp
+
+#include <stdint.h>
+
+static const char kTrainingRecordMagic[8] = { 'D', 'O', 'M', 'T', 'R', 'A', 'I', 'N' };
+static const uint32_t kTrainingRecordVersion = 1;
+static const uint8_t kTrainingRecordMinPlayerTurn = 0x01; // flags
+static const uint8_t kTrainingRecordPreviousPlayerPassed = 0x02;
+
+// file layout: header, then fixed-size records back to back, so a shard can be mapped and indexed
+// directly as an array of TrainingRecord. both structs are 32 bytes with no padding.
+struct TrainingRecordFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t handSize;
+    uint32_t maxDominoSuit;
+    uint32_t recordSize;
+    uint64_t numberOfRecords; // written when the shard is closed
+};
+
+struct TrainingRecord {
+    uint64_t maxPlayerTiles; // bit per dominoSet index
+    uint64_t minPlayerTiles;
+    uint64_t playedTiles;
+    int16_t minimaxValue; // exact, positive when max wins
+    int8_t layoutFirst; // -1 before the first tile
+    int8_t layoutSecond;
+    uint8_t flags;
+    uint8_t bestMove; // GameRecord move byte: tile index (| kGameRecordSecondEnd), or kGameRecordPass
+    uint8_t movesPlayed; // plies since the deal, passes included
+    uint8_t reserved;
+};
+
+static_assert(sizeof(TrainingRecordFileHeader) == 32, "training record header must stay 32 bytes");
+static_assert(sizeof(TrainingRecord) == 32, "training records must stay 32 bytes");
+
+#endif /* TrainingRecord_hpp */
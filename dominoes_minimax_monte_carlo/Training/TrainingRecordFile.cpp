@@ -0,0 +1,62 @@
+//
+//  TrainingRecordFile.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TrainingRecordFile.hpp"
+
+TrainingRecordFile::~TrainingRecordFile() {
+    close();
+}
+
+bool TrainingRecordFile::open(const std::string& path, const GameFoundation& gameFoundation) {
+    close();
+
+    const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < (off_t)sizeof(TrainingRecordFileHeader)) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    void* mapping = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor); // the mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const TrainingRecordFileHeader* header = (const TrainingRecordFileHeader*)mapping;
+    if (memcmp(header->magic, kTrainingRecordMagic, sizeof(kTrainingRecordMagic)) != 0 ||
+        header->version != kTrainingRecordVersion ||
+        header->handSize != (uint32_t)gameFoundation.handSize ||
+        header->maxDominoSuit != (uint32_t)gameFoundation.maxDominoSuit ||
+        header->recordSize != sizeof(TrainingRecord)) {
+        munmap(mapping, (size_t)fileStatus.st_size);
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappingSize = (size_t)fileStatus.st_size;
+    _records = (const TrainingRecord*)((const uint8_t*)mapping + sizeof(TrainingRecordFileHeader));
+    _numberOfRecords = (long long)((_mappingSize - sizeof(TrainingRecordFileHeader)) / sizeof(TrainingRecord));
+    return true;
+}
+
+void TrainingRecordFile::close() {
+    if (_mapping != NULL) {
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = NULL;
+    _mappingSize = 0;
+    _records = NULL;
+    _numberOfRecords = 0;
+}
@@ -0,0 +1,44 @@
+//
+//  TrainingRecordFile.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingRecordFile_hpp
+#define TrainingRecordFile_hpp
+
+#include <string>
+
+#include "GameFoundation.hpp"
+#include "TrainingRecord.hpp"
+
+// read-only memory-mapped view of a training record shard. the record count follows from the file
+// size, so a shard whose writer never closed is readable up to its last whole record.
+class TrainingRecordFile {
+private:
+    void* _mapping;
+    size_t _mappingSize;
+    const TrainingRecord* _records;
+    long long _numberOfRecords;
+
+    TrainingRecordFile(const TrainingRecordFile&);
+    TrainingRecordFile& operator=(const TrainingRecordFile&);
+public:
+    TrainingRecordFile() : _mapping(NULL), _mappingSize(0), _records(NULL), _numberOfRecords(0) {}
+    ~TrainingRecordFile();
+
+    bool open(const std::string& path, const GameFoundation& gameFoundation);
+    void close();
+
+    inline bool isOpen() const {
+        return _mapping != NULL;
+    }
+    inline long long numberOfRecords() const {
+        return _numberOfRecords;
+    }
+    inline const TrainingRecord& record(const long long index) const {
+        return _records[index];
+    }
+};
+
+#endif /* TrainingRecordFile_hpp */
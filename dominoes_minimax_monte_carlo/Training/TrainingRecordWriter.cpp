@@ -0,0 +1,64 @@
+//
+//  TrainingRecordWriter.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <stddef.h>
+#include <string.h>
+
+#include "TrainingRecordWriter.hpp"
+
+TrainingRecordWriter::~TrainingRecordWriter() {
+    close();
+}
+
+bool TrainingRecordWriter::open(const std::string& path, const GameFoundation& gameFoundation) {
+    close();
+
+    _file = fopen(path.c_str(), "wb");
+    if (_file == NULL) {
+        return false;
+    }
+
+    TrainingRecordFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kTrainingRecordMagic, sizeof(kTrainingRecordMagic));
+    header.version = kTrainingRecordVersion;
+    header.handSize = (uint32_t)gameFoundation.handSize;
+    header.maxDominoSuit = (uint32_t)gameFoundation.maxDominoSuit;
+    header.recordSize = sizeof(TrainingRecord);
+    fwrite(&header, sizeof(header), 1, _file);
+    _batch.reserve(kTrainingWriterBatchRecords);
+    _recordsWritten = 0;
+    return true;
+}
+
+void TrainingRecordWriter::_flushBatch() {
+    if (!_batch.empty()) {
+        fwrite(_batch.data(), sizeof(TrainingRecord), _batch.size(), _file);
+        _batch.clear();
+    }
+}
+
+void TrainingRecordWriter::write(const TrainingRecord& record) {
+    assert(isOpen());
+
+    _batch.push_back(record);
+    _recordsWritten++;
+
+    if (_batch.size() >= kTrainingWriterBatchRecords) {
+        _flushBatch();
+    }
+}
+
+void TrainingRecordWriter::close() {
+    if (_file != NULL) {
+        _flushBatch();
+        const uint64_t numberOfRecords = (uint64_t)_recordsWritten;
+        fseek(_file, offsetof(TrainingRecordFileHeader, numberOfRecords), SEEK_SET);
+        fwrite(&numberOfRecords, sizeof(numberOfRecords), 1, _file);
+        fclose(_file);
+        _file = NULL;
+    }
+}
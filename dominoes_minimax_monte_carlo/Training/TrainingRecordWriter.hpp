@@ -0,0 +1,47 @@
+//
+//  TrainingRecordWriter.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingRecordWriter_hpp
+#define TrainingRecordWriter_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "GameFoundation.hpp"
+#include "TrainingRecord.hpp"
+#include "TrainingSettings.hpp"
+
+// writes one shard of training records. records are collected in a batch that is written with a
+// single fwrite, and the header's record count is filled in on close.
+class TrainingRecordWriter {
+private:
+    FILE* _file;
+    std::vector<TrainingRecord> _batch;
+    long long _recordsWritten;
+
+    void _flushBatch();
+
+    TrainingRecordWriter(const TrainingRecordWriter&);
+    TrainingRecordWriter& operator=(const TrainingRecordWriter&);
+public:
+    TrainingRecordWriter() : _file(NULL), _recordsWritten(0) {}
+    ~TrainingRecordWriter();
+
+    // creates or truncates path and writes the file header
+    bool open(const std::string& path, const GameFoundation& gameFoundation);
+    void write(const TrainingRecord& record);
+    void close();
+
+    inline bool isOpen() const {
+        return _file != NULL;
+    }
+    inline long long getRecordsWritten() const {
+        return _recordsWritten;
+    }
+};
+
+#endif /* TrainingRecordWriter_hpp */
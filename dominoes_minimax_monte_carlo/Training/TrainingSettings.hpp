@@ -0,0 +1,32 @@
+//
+//  TrainingSettings.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef TrainingSettings_hpp
+#define TrainingSettings_hpp
+
+#include <string>
+
+class PersistentSolutionCache;
+
+static const int kDefaultTrainingGames = 1000;
+static const double kDefaultTrainingRandomMoveRate = 0.25;
+static const int kTrainingWriterBatchRecords = 1 << 15; // records buffered per shard before one write
+
+struct TrainingSettings {
+    TrainingSettings(int numberOfGames = kDefaultTrainingGames, unsigned int seed = 1, double randomMoveRate = kDefaultTrainingRandomMoveRate) : numberOfGames(numberOfGames), seed(seed), randomMoveRate(randomMoveRate) {
+        numberOfThreads = 0;
+        persistentSolutionCache = NULL;
+    }
+
+    int numberOfGames; // deals Game::gameForSeed makes from seed, seed + 1, ...
+    unsigned int seed;
+    double randomMoveRate; // chance each move is random instead of the solved best move. 1 plays random games
+    int numberOfThreads; // one output shard per thread. 0 uses every hardware core
+    std::string pathPrefix; // shard i is written to pathPrefix + "." + i
+    PersistentSolutionCache* persistentSolutionCache; // behind every thread's solution store. NULL disables
+};
+
+#endif /* TrainingSettings_hpp */
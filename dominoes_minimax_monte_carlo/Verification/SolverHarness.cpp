@@ -0,0 +1,242 @@
+//
+//  SolverHarness.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include "SolverHarness.hpp"
+#include "MinimaxSearch.hpp"
+#include "MultiPVSearch.hpp"
+#include "MultiWorldSearch.hpp"
+#include "PartitionSearch.hpp"
+#include "ProofNumberSearch.hpp"
+#include "ResumableAlphaBetaSearch.hpp"
+
+static const int kSolverHarnessResumeSlice = 64; // small, so the resumable search suspends often
+
+std::string SolverHarness::_engineName(const SolverEngine engine) {
+    switch (engine) {
+        case kSolverEngineAlphaBeta: return "Alpha-Beta";
+        case kSolverEngineAlphaBetaWithStore: return "Alpha-Beta With Solution Store";
+        case kSolverEngineResumableAlphaBeta: return "Resumable Alpha-Beta";
+        case kSolverEngineMultiPV: return "Multi-PV";
+        case kSolverEngineProofNumber: return "Proof-Number";
+        case kSolverEnginePartition: return "Partition";
+        case kSolverEngineMultiWorld: return "Multi-World";
+        default: return "";
+    }
+}
+
+uint64_t SolverHarness::_tileMask(const GameFoundation& gameFoundation, const DominoPointerVector& tiles) {
+    uint64_t result = 0;
+    for (int i = 0; i < tiles.size(); i++) {
+        result |= gameFoundation.tileMaskForDomino(tiles[i]);
+    }
+    return result;
+}
+
+void SolverHarness::_hiddenHandsForState(const GameState& gameState, std::vector<DominoPointerVector>& hiddenHands) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    const DominoPointerVector& hiddenHand = gameState.isMaxPlayer() ? gameState.minPlayerHand : gameState.maxPlayerHand;
+    const uint64_t seenTiles = _tileMask(gameFoundation, gameState.isMaxPlayer() ? gameState.maxPlayerHand : gameState.minPlayerHand) | _tileMask(gameFoundation, gameState.playedTiles);
+    DominoPointerVector unseenTiles = gameFoundation.tilesForMask(~seenTiles & (gameFoundation.numberOfDominoes == 64 ? ~0ULL : (1ULL << gameFoundation.numberOfDominoes) - 1));
+
+    // seeded from the position, so a reproduction below it searches worlds drawn the same way
+    std::mt19937 engine((uint32_t)gameState.positionKey().hashValue());
+    hiddenHands.assign(1, hiddenHand);
+    while (hiddenHands.size() < kMultiWorldWidth) {
+        for (int i = 0; i < hiddenHand.size(); i++) {
+            std::swap(unseenTiles[i], unseenTiles[i + engine() % (uint32_t)(unseenTiles.size() - i)]);
+        }
+        hiddenHands.push_back(DominoPointerVector(unseenTiles.begin(), unseenTiles.begin() + hiddenHand.size()));
+    }
+}
+
+int SolverHarness::_worldValue(const GameState& gameState, const DominoPointerVector& hiddenHand) {
+    const GameFoundation& gameFoundation = gameState.game.gameFoundation;
+    const uint64_t knownTiles = _tileMask(gameFoundation, gameState.isMaxPlayer() ? gameState.maxPlayerHand : gameState.minPlayerHand);
+    const uint64_t hiddenTiles = _tileMask(gameFoundation, hiddenHand);
+    const uint64_t playedTiles = _tileMask(gameFoundation, gameState.playedTiles);
+    const Game game = gameState.isMaxPlayer() ? Game::gameForPosition(gameFoundation, knownTiles, hiddenTiles, playedTiles) : Game::gameForPosition(gameFoundation, hiddenTiles, knownTiles, playedTiles);
+    GameState worldState = GameState::stateForPosition(game, gameState.playedTiles, gameState.playerTurnIndex, gameState.layoutEnds, gameState.previousPlayerPassed);
+    return MinimaxSearch::runOnState(worldState).minimaxValue;
+}
+
+void SolverHarness::_engineValues(const SolverEngine engine, GameState& gameState, long long& nodesVisited, IntVector& values) {
+    values.clear();
+    switch (engine) {
+        case kSolverEngineAlphaBeta: {
+            const MinimaxData data = AlphaBetaMinimaxSearch::runOnState(gameState, false);
+            nodesVisited += data.nodesVisited;
+            values.push_back(data.minimaxValue);
+            break;
+        }
+        case kSolverEngineAlphaBetaWithStore: {
+            SolutionStore solutionStore;
+            const MinimaxData data = AlphaBetaMinimaxSearch::runOnState(gameState, false, &solutionStore);
+            nodesVisited += data.nodesVisited;
+            values.push_back(data.minimaxValue);
+            break;
+        }
+        case kSolverEngineResumableAlphaBeta: {
+            ResumableAlphaBetaSearch search(gameState, false);
+            while (!search.resume(kSolverHarnessResumeSlice)) {}
+            nodesVisited += search.getData().nodesVisited;
+            values.push_back(search.getData().minimaxValue);
+            break;
+        }
+        case kSolverEngineMultiPV: {
+            const MultiPVData data = MultiPVSearch::runOnState(gameState);
+            nodesVisited += data.nodesVisited;
+            values.push_back(data.childValues[data.bestChildIndex]);
+            break;
+        }
+        case kSolverEngineProofNumber: {
+            const ProofNumberData data = ProofNumberSearch::runOnState(gameState);
+            nodesVisited += data.nodesVisited;
+            values.push_back(data.proven ? 1 : 0);
+            break;
+        }
+        case kSolverEnginePartition: {
+            // the player not to move is the hidden one, as when Monte Carlo samples its hand
+            PartitionTable partitionTable;
+            const MinimaxData data = PartitionSearch::runOnState(gameState, 1 - gameState.playerTurnIndex, partitionTable);
+            nodesVisited += data.nodesVisited;
+            values.push_back(data.minimaxValue);
+            break;
+        }
+        case kSolverEngineMultiWorld: {
+            std::vector<DominoPointerVector> hiddenHands;
+            _hiddenHandsForState(gameState, hiddenHands);
+            const MultiWorldData data = MultiWorldSearch::runOnWorlds(gameState, hiddenHands);
+            nodesVisited += data.nodesVisited;
+            for (int world = 0; world < data.childValues.size(); world++) {
+                const IntVector& childValues = data.childValues[world];
+                values.push_back(gameState.isMaxPlayer() ? *std::max_element(childValues.begin(), childValues.end()) : *std::min_element(childValues.begin(), childValues.end()));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void SolverHarness::_expectedValues(const SolverEngine engine, const GameState& gameState, const int minimaxValue, IntVector& values) {
+    values.assign(1, engine == kSolverEngineProofNumber ? (minimaxValue > 0 ? 1 : 0) : minimaxValue);
+    if (engine == kSolverEngineMultiWorld) {
+        std::vector<DominoPointerVector> hiddenHands;
+        _hiddenHandsForState(gameState, hiddenHands);
+        for (int world = 1; world < hiddenHands.size(); world++) {
+            values.push_back(_worldValue(gameState, hiddenHands[world]));
+        }
+    }
+}
+
+bool SolverHarness::_agrees(const SolverEngine engine, const GameState& gameState, int& world, int& expected, int& actual) {
+    GameState oracleState = GameState::stateRemovingChildren(gameState);
+    IntVector expectedValues;
+    _expectedValues(engine, gameState, MinimaxSearch::runOnState(oracleState).minimaxValue, expectedValues);
+    GameState engineState = GameState::stateRemovingChildren(gameState);
+    long long nodesVisited = 0;
+    IntVector actualValues;
+    _engineValues(engine, engineState, nodesVisited, actualValues);
+    actualValues.resize(expectedValues.size(), 0);
+    // the first world that disagrees, or the state itself when all agree
+    world = 0;
+    for (int i = (int)expectedValues.size() - 1; i >= 0; i--) {
+        world = expectedValues[i] != actualValues[i] ? i : world;
+    }
+    expected = expectedValues[world];
+    actual = actualValues[world];
+    return expectedValues == actualValues;
+}
+
+std::string SolverHarness::_reproduction(const SolverEngine engine, const GameState& gameState, const unsigned int dealSeed) {
+    // descend while some child still disagrees, so the position reported has as few tiles left as possible
+    // GameState is not assignable, so the states descended through are kept in a vector
+    GameStateVector line;
+    line.push_back(GameState::stateRemovingChildren(gameState));
+    int world = 0;
+    int expected = 0;
+    int actual = 0;
+    _agrees(engine, line.back(), world, expected, actual);
+    while (true) {
+        GameState expanded = GameState::stateRemovingChildren(line.back());
+        expanded.expandAndGenerateChildren();
+        bool descended = false;
+        for (int i = 0; i < expanded.children.size() && !descended; i++) {
+            if (expanded.children[i].isLeafNode()) {
+                continue;
+            }
+            int childWorld = 0;
+            int childExpected = 0;
+            int childActual = 0;
+            if (!_agrees(engine, expanded.children[i], childWorld, childExpected, childActual)) {
+                line.push_back(GameState::stateRemovingChildren(expanded.children[i]));
+                line.back().parent = NULL;
+                world = childWorld;
+                expected = childExpected;
+                actual = childActual;
+                descended = true;
+            }
+        }
+        if (!descended) {
+            break;
+        }
+    }
+    std::string result = "    deal seed " + std::to_string(dealSeed) + ", " + std::to_string(line.size() - 1) + " plies in";
+    if (world > 0) {
+        result += ", sampled world " + std::to_string(world);
+    }
+    result += ": expected " + std::to_string(expected) + ", got " + std::to_string(actual) + "\n";
+    result += line.back().prettyString();
+    return result;
+}
+
+SolverHarnessConfigData SolverHarness::runOnFoundation(const GameFoundation& gameFoundation, const int numberOfDeals, const unsigned int seed) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    SolverHarnessConfigData result(gameFoundation.handSize, gameFoundation.maxDominoSuit);
+    for (int engine = 0; engine < kNumberOfSolverEngines; engine++) {
+        result.engines.push_back(SolverEngineData(_engineName((SolverEngine)engine)));
+    }
+
+    for (int dealIndex = 0; dealIndex < numberOfDeals; dealIndex++) {
+        const unsigned int dealSeed = seed + (unsigned int)dealIndex;
+        const Game game = Game::gameForSeed(gameFoundation, dealSeed);
+        const GameState initialState(game);
+        result.deals++;
+
+        GameState oracleState(initialState);
+        const auto oracleStart = Clock::now();
+        const MinimaxData oracleData = MinimaxSearch::runOnState(oracleState);
+        const std::chrono::duration<double> oracleElapsed = Clock::now() - oracleStart;
+        result.oracleNodesVisited += oracleData.nodesVisited;
+        result.oracleSeconds += oracleElapsed.count();
+
+        for (int engine = 0; engine < kNumberOfSolverEngines; engine++) {
+            SolverEngineData& engineData = result.engines[engine];
+            // sampled worlds are solved before the engine is timed
+            IntVector expectedValues;
+            _expectedValues((SolverEngine)engine, initialState, oracleData.minimaxValue, expectedValues);
+            GameState engineState(initialState);
+            IntVector values;
+            const auto engineStart = Clock::now();
+            _engineValues((SolverEngine)engine, engineState, engineData.nodesVisited, values);
+            const std::chrono::duration<double> engineElapsed = Clock::now() - engineStart;
+            engineData.seconds += engineElapsed.count();
+            engineData.positions++;
+            if (values != expectedValues) {
+                engineData.mismatches++;
+                if (engineData.reproductions.size() < kSolverHarnessMismatchesKept) {
+                    engineData.reproductions.push_back(_reproduction((SolverEngine)engine, initialState, dealSeed));
+                }
+            }
+        }
+    }
+    return result;
+}
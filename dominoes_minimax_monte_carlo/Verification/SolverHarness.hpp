@@ -0,0 +1,49 @@
+//
+//  SolverHarness.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SolverHarness_hpp
+#define SolverHarness_hpp
+
+#include "Game.hpp"
+#include "GameFoundation.hpp"
+#include "GameState.hpp"
+#include "SolverHarnessData.hpp"
+
+enum SolverEngine {
+    kSolverEngineAlphaBeta,
+    kSolverEngineAlphaBetaWithStore,
+    kSolverEngineResumableAlphaBeta,
+    kSolverEngineMultiPV,
+    kSolverEngineProofNumber, // only proves win/loss, so only that is compared
+    kSolverEnginePartition,
+    kSolverEngineMultiWorld, // every lane's world is checked, not just the real one
+    kNumberOfSolverEngines
+};
+
+// differential check of every solver against MinimaxSearch on seeded deals. a mismatch is reported with the
+// smallest position below the deal's root that still reproduces it, found by descending into mismatching children.
+class SolverHarness {
+private:
+    static std::string _engineName(const SolverEngine engine);
+    static uint64_t _tileMask(const GameFoundation& gameFoundation, const DominoPointerVector& tiles);
+    // kMultiWorldWidth hidden hands for the multi-world engine: the real one first, then hands of the same size
+    // drawn from the tiles the player to move cannot see, so the lanes split where those hands differ
+    static void _hiddenHandsForState(const GameState& gameState, std::vector<DominoPointerVector>& hiddenHands);
+    // MinimaxSearch on the state with hiddenHand as the hidden player's hand
+    static int _worldValue(const GameState& gameState, const DominoPointerVector& hiddenHand);
+    // the values the engine reports for the state, or for win/loss engines 1 for a max player win and 0 otherwise.
+    // one value, except for multi-world, which reports one for each of its worlds
+    static void _engineValues(const SolverEngine engine, GameState& gameState, long long& nodesVisited, IntVector& values);
+    // the oracle's values for the same worlds, given the state's own MinimaxSearch value
+    static void _expectedValues(const SolverEngine engine, const GameState& gameState, const int minimaxValue, IntVector& values);
+    // world is the first world that disagrees, 0 when every world agrees
+    static bool _agrees(const SolverEngine engine, const GameState& gameState, int& world, int& expected, int& actual);
+    static std::string _reproduction(const SolverEngine engine, const GameState& gameState, const unsigned int dealSeed);
+public:
+    static SolverHarnessConfigData runOnFoundation(const GameFoundation& gameFoundation, const int numberOfDeals, const unsigned int seed);
+};
+
+#endif /* SolverHarness_hpp */
@@ -0,0 +1,93 @@
+//
+//  SolverHarnessData.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SolverHarnessData_hpp
+#define SolverHarnessData_hpp
+
+#include <string>
+#include <vector>
+
+typedef std::vector<std::string> StringVector;
+
+static const int kSolverHarnessMismatchesKept = 3; // reproductions kept per engine and configuration
+
+struct SolverEngineData {
+    SolverEngineData(const std::string& name = "") : name(name), positions(0), mismatches(0), nodesVisited(0), seconds(0.0) {}
+
+    std::string name;
+    long long positions;
+    long long mismatches;
+    long long nodesVisited;
+    double seconds;
+    StringVector reproductions; // the smallest position reproducing each of the first mismatches
+
+    inline void merge(const SolverEngineData& other) {
+        positions += other.positions;
+        mismatches += other.mismatches;
+        nodesVisited += other.nodesVisited;
+        seconds += other.seconds;
+        for (int i = 0; i < other.reproductions.size() && reproductions.size() < kSolverHarnessMismatchesKept; i++) {
+            reproductions.push_back(other.reproductions[i]);
+        }
+    }
+};
+
+struct SolverHarnessConfigData {
+    SolverHarnessConfigData(int handSize = 0, int maxDominoSuit = 0) : handSize(handSize), maxDominoSuit(maxDominoSuit), deals(0), oracleNodesVisited(0), oracleSeconds(0.0) {}
+
+    int handSize;
+    int maxDominoSuit;
+    long long deals;
+    long long oracleNodesVisited; // MinimaxSearch, the oracle
+    double oracleSeconds;
+    std::vector<SolverEngineData> engines;
+
+    inline long long getMismatches() const {
+        long long result = 0;
+        for (int i = 0; i < engines.size(); i++) {
+            result += engines[i].mismatches;
+        }
+        return result;
+    }
+
+    std::string prettyString() const {
+        std::string result = "Hand Size " + std::to_string(handSize) + ", Max Suit " + std::to_string(maxDominoSuit) + ": " + std::to_string(deals) + " deals, oracle " + std::to_string(oracleNodesVisited) + " nodes in " + std::to_string(oracleSeconds) + " s\n";
+        for (int i = 0; i < engines.size(); i++) {
+            const SolverEngineData& engine = engines[i];
+            // both relative to the oracle, so above 1 is faster or smaller
+            const double speedup = engine.seconds > 0.0 ? oracleSeconds / engine.seconds : 0.0;
+            const double nodeRatio = engine.nodesVisited > 0 ? (double)oracleNodesVisited / engine.nodesVisited : 0.0;
+            result += "  " + engine.name + ": " + std::to_string(engine.mismatches) + " mismatches, speedup " + std::to_string(speedup) + ", node ratio " + std::to_string(nodeRatio) + "\n";
+            for (int j = 0; j < engine.reproductions.size(); j++) {
+                result += engine.reproductions[j];
+            }
+        }
+        return result;
+    }
+};
+
+struct SolverHarnessData {
+    std::vector<SolverHarnessConfigData> configs;
+
+    inline long long getMismatches() const {
+        long long result = 0;
+        for (int i = 0; i < configs.size(); i++) {
+            result += configs[i].getMismatches();
+        }
+        return result;
+    }
+
+    std::string prettyString() const {
+        std::string result = "";
+        for (int i = 0; i < configs.size(); i++) {
+            result += configs[i].prettyString();
+        }
+        result += "Total Mismatches: " + std::to_string(getMismatches()) + "\n";
+        return result;
+    }
+};
+
+#endif /* SolverHarnessData_hpp */
@@ -0,0 +1,163 @@
+//
+//  SweepSmokeTest.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "SweepSmokeTest.hpp"
+#include "GameRecordReader.hpp"
+#include "GameRecordWriter.hpp"
+#include "SweepCoordinator.hpp"
+
+bool SweepSmokeTest::_sendFaultyResults(const int port, const GameFoundation& gameFoundation, std::string& failure) {
+    const int socket = SweepProtocol::connectToHost("127.0.0.1", port);
+    if (socket < 0) {
+        failure = "could not connect to the coordinator";
+        return false;
+    }
+    ByteVector request;
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.handSize);
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.maxDominoSuit);
+    uint8_t type;
+    ByteVector payload;
+    if (!SweepProtocol::sendMessage(socket, kSweepMessageRequest, request) || !SweepProtocol::receiveMessage(socket, type, payload) || type != kSweepMessageLease || payload.size() != 3 * sizeof(uint32_t)) {
+        SweepProtocol::closeSocket(socket);
+        failure = "no lease for the faulty client";
+        return false;
+    }
+    const uint32_t leaseIndex = SweepProtocol::readUInt32(payload.data());
+    const uint32_t firstRank = SweepProtocol::readUInt32(payload.data() + sizeof(uint32_t));
+    const uint32_t endRank = SweepProtocol::readUInt32(payload.data() + (2 * sizeof(uint32_t)));
+
+    // the right number of records, but the first rank sent in place of the last
+    ByteVector message;
+    SweepProtocol::appendUInt32(message, leaseIndex);
+    SweepProtocol::appendUInt32(message, endRank - firstRank);
+    for (uint32_t rank = firstRank; rank < endRank; rank++) {
+        SweepProtocol::appendRecord(message, GameRecord(rank + 1 == endRank ? firstRank : rank));
+    }
+    // results get no reply, so ask for another lease. refused results close the connection instead of answering.
+    const bool refused = !SweepProtocol::sendMessage(socket, kSweepMessageResults, message) || !SweepProtocol::sendMessage(socket, kSweepMessageRequest, request) || !SweepProtocol::receiveMessage(socket, type, payload);
+    SweepProtocol::closeSocket(socket);
+    if (!refused) {
+        failure = "the coordinator accepted results with a repeated hand";
+    }
+    return refused;
+}
+
+int SweepSmokeTest::_holdLease(const int port, const GameFoundation& gameFoundation, std::string& failure) {
+    const int socket = SweepProtocol::connectToHost("127.0.0.1", port);
+    if (socket < 0) {
+        failure = "could not connect to the coordinator";
+        return -1;
+    }
+    ByteVector request;
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.handSize);
+    SweepProtocol::appendUInt32(request, (uint32_t)gameFoundation.maxDominoSuit);
+    uint8_t type;
+    ByteVector payload;
+    if (!SweepProtocol::sendMessage(socket, kSweepMessageRequest, request) || !SweepProtocol::receiveMessage(socket, type, payload) || type != kSweepMessageLease) {
+        SweepProtocol::closeSocket(socket);
+        failure = "no lease for the stalled client";
+        return -1;
+    }
+    return socket;
+}
+
+int SweepSmokeTest::_startWorker(const std::string& executablePath, const int port, const int samples) {
+    // built before the fork, as the child may only make async-signal-safe calls until it execs
+    const std::string portString = std::to_string(port);
+    const std::string samplesString = std::to_string(samples);
+    const char* arguments[] = { executablePath.c_str(), "worker", "127.0.0.1", portString.c_str(), samplesString.c_str(), NULL };
+    const pid_t pid = fork();
+    if (pid == 0) {
+        // keep the smoke test's own output to its verdict
+        const int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+        }
+        execvp(executablePath.c_str(), (char* const*)arguments);
+        _exit(127);
+    }
+    return pid;
+}
+
+bool SweepSmokeTest::run(const std::string& executablePath, const GameFoundation& gameFoundation, const int samples, const std::string& recordPath, std::string& failure) {
+    SweepCoordinator coordinator(gameFoundation, 0, kSweepSmokeTestHands, kSweepSmokeTestLeaseSize, kSweepSmokeTestLeaseTimeoutSeconds);
+    GameRecordWriter writer;
+    if (!writer.open(recordPath, gameFoundation) || !coordinator.listen(0)) {
+        failure = "could not start the coordinator";
+        return false;
+    }
+    const int port = coordinator.getPort();
+    SweepData sweepData;
+    std::thread coordinatorThread([&coordinator, &writer, &sweepData]() {
+        sweepData = coordinator.run(writer);
+    });
+
+    const bool refused = _sendFaultyResults(port, gameFoundation, failure);
+    // never sends results and stays connected until the coordinator is done
+    const int stalledSocket = refused ? _holdLease(port, gameFoundation, failure) : -1;
+
+    // without the workers the coordinator never finishes, so they run even after a failure
+    std::vector<pid_t> workers;
+    for (int i = 0; i < kSweepSmokeTestWorkers; i++) {
+        workers.push_back(_startWorker(executablePath, port, samples));
+    }
+    bool workersSucceeded = true;
+    for (int i = 0; i < workers.size(); i++) {
+        int status = 0;
+        if (workers[i] < 0 || waitpid(workers[i], &status, 0) != workers[i] || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            workersSucceeded = false;
+        }
+    }
+    coordinatorThread.join();
+    writer.close();
+    if (stalledSocket >= 0) {
+        SweepProtocol::closeSocket(stalledSocket);
+    }
+    if (!refused || stalledSocket < 0) {
+        return false;
+    }
+    if (!workersSucceeded) {
+        failure = "a worker process failed";
+        return false;
+    }
+
+    GameRecordReader reader;
+    if (!reader.open(recordPath, gameFoundation)) {
+        failure = "could not read the sweep records back";
+        return false;
+    }
+    std::vector<int> timesSeen(kSweepSmokeTestHands, 0);
+    GameRecord record;
+    while (reader.next(record)) {
+        if (record.maxPlayerHandRank >= (uint32_t)kSweepSmokeTestHands) {
+            failure = "hand " + std::to_string(record.maxPlayerHandRank) + " was never leased";
+            return false;
+        }
+        if (timesSeen[record.maxPlayerHandRank]++ > 0) {
+            failure = "hand " + std::to_string(record.maxPlayerHandRank) + " was recorded twice";
+            return false;
+        }
+    }
+    for (int rank = 0; rank < kSweepSmokeTestHands; rank++) {
+        if (timesSeen[rank] == 0) {
+            failure = "hand " + std::to_string(rank) + " is missing";
+            return false;
+        }
+    }
+    // the stalled client never sent results, so its ranks being in the file means a worker finished them.
+    // one reissue hands the refused lease to the stalled client, the next hands it on past its deadline.
+    if (sweepData.leasesReissued < 2) {
+        failure = "the refused or stalled lease was never handed out again";
+        return false;
+    }
+    return true;
+}
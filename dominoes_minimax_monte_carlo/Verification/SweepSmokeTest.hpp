@@ -0,0 +1,38 @@
+//
+//  SweepSmokeTest.hpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+#ifndef SweepSmokeTest_hpp
+#define SweepSmokeTest_hpp
+
+#include <string>
+
+#include "GameFoundation.hpp"
+
+static const int kSweepSmokeTestHands = 12;
+static const int kSweepSmokeTestLeaseSize = 3;
+static const int kSweepSmokeTestWorkers = 2;
+static const int kSweepSmokeTestLeaseTimeoutSeconds = 2;
+
+// runs a coordinator in this process and kSweepSmokeTestWorkers worker processes, started as executablePath
+// worker 127.0.0.1 port samples, over localhost. before the workers start, a faulty client takes the first lease
+// and returns it with one hand twice and another missing, which the coordinator must refuse and hand out again,
+// then a stalled client takes a lease and holds it with its connection open until the sweep ends, so the
+// coordinator must hand that lease to a worker once its deadline passes. passes when the record file holds
+// every hand exactly once.
+class SweepSmokeTest {
+private:
+    // false if the coordinator accepted the faulty results
+    static bool _sendFaultyResults(const int port, const GameFoundation& gameFoundation, std::string& failure);
+    // the stalled client's socket, or -1 if it got no lease
+    static int _holdLease(const int port, const GameFoundation& gameFoundation, std::string& failure);
+    // the worker's process id, or -1
+    static int _startWorker(const std::string& executablePath, const int port, const int samples);
+public:
+    // recordPath is overwritten. failure says what went wrong when this returns false
+    static bool run(const std::string& executablePath, const GameFoundation& gameFoundation, const int samples, const std::string& recordPath, std::string& failure);
+};
+
+#endif /* SweepSmokeTest_hpp */
@@ -6,29 +6,306 @@
 
 #include <iostream>
 #include <chrono>
+#include <string.h>
 
+#include "BatchPipeline.hpp"
 #include "CombinationListCreator.hpp"
+#include "CpuTopology.hpp"
 #include "Game.hpp"
 #include "GameFoundation.hpp"
+#include "GameRecordWriter.hpp"
+#include "GameReview.hpp"
 #include "GameState.hpp"
 #include "GameTreeData.hpp"
 #include "GameTreeDataGenerator.hpp"
+#include "HandEquityEstimator.hpp"
 #include "MinimaxData.hpp"
+#include "MemoryTracker.hpp"
 #include "MinimaxSearch.hpp"
 #include "MonteCarloDataGenerator.hpp"
+#include "MultiPVSearch.hpp"
+#include "OpeningBook.hpp"
+#include "OpeningBookBuilder.hpp"
+#include "PersistentSolutionCache.hpp"
+#include "ProofNumberSearch.hpp"
+#include "ResultsSink.hpp"
+#include "ResumableAlphaBetaSearch.hpp"
+#include "SolverHarness.hpp"
+#include "SweepCoordinator.hpp"
+#include "SweepSmokeTest.hpp"
+#include "SweepWorker.hpp"
+#include "Tournament.hpp"
+#include "Tracer.hpp"
+#include "TrainingDataGenerator.hpp"
 
 static const int kNumberOfGames = 1; // to handle all initial max player hands with default game settings, use (28 choose 7) = 1184040
 static const int kNumberOfSamples = 100; // max with default game settings is (21 choose 7) = 116280
 static const bool kRunFullMinimax = true;
 static const bool kRecordMinimaxPath = true;
+static const bool kRunProofNumberSearch = false; // prove win/loss, then seed an exact alpha-beta search with the resulting bound
+static const int kResumableSearchSliceNodes = 0; // > 0 reruns alpha-beta suspended every this many nodes and checks it matches
+static const bool kRunMultiPV = false; // print the exact value of every first move
+static const MonteCarloVoteCriterion kMonteCarloVoteCriterion = kVoteForBestMinimaxValue;
+static const bool kUsePartitionSearch = false; // share sample solutions across hidden hands that only differ in tiles never played
+static const bool kUseMultiWorldSearch = false; // solve samples several worlds at a time in lockstep
+static const int kDepthLimitedSearchDepth = 0; // > 0 searches early Monte Carlo samples this many plies deep with a static evaluator
+static const int kExactSearchMaximumTiles = kDefaultExactSearchMaximumTiles; // tiles left in both hands at which samples are solved exactly again
+static const ThreadPlacement kThreadPlacement = kThreadPlacementNone; // pin Monte Carlo sampling threads to cores or NUMA nodes
+static const bool kCompareThreadPlacement = false; // replay each Monte Carlo game with placement toggled on (kThreadPlacementCore when kThreadPlacement is none) or off and print both move timings
+static const bool kReuseMonteCarloSolutions = true; // keep solved positions across the moves of a game
+static const bool kCompareMonteCarloSolutionReuse = false; // replay each Monte Carlo game with reuse toggled and print both move timings
+static const bool kRunPipelinedBatch = false; // overlap the analysis stages of several games instead of running games one at a time
+static const bool kRunMonteCarloGamePool = false; // play only the Monte Carlo games, sampling moves of several games at once on one shared pool
+static const bool kReviewMonteCarloGames = false; // print every Monte Carlo move's regret against the best move with both hands known
+static const ResultsFormat kResultsFormat = kResultsFormatPrettyString; // csv and json lines replace the prettyString output
+static const char* kResultsPath = ""; // csv or json lines destination. empty writes to stdout
+static const bool kResultsPerPlyDetail = false; // add every Monte Carlo move with its nodes and time
+static const bool kReportMemory = false; // allocation counts per phase need a build with TRACK_ALLOCATIONS=1, resident sizes do not
+static const char* kTracePath = ""; // chrome trace-event timeline of the analysis threads, viewable in chrome://tracing or Perfetto. empty disables
+static const char* kGameRecordPath = ""; // binary record of every Monte Carlo game. empty disables
+static const char* kOpeningBookPath = ""; // empty disables the opening book
+static const char* kSolutionCachePath = ""; // solved positions kept across runs and shared by every process using the file, for Monte Carlo, hand equity, training data and game review. empty disables
+static const int kSolutionCacheSizeLog2 = kDefaultPersistentSolutionCacheSizeLog2; // slots in a newly created cache file
+static const bool kBuildOpeningBook = false; // fill the opening book for hand numbers [kOpeningBookFirstHand, kOpeningBookEndHand) and exit
+static const int kOpeningBookFirstHand = 0;
+static const int kOpeningBookEndHand = 1184040;
+static const bool kRunSolverHarness = false; // check every solver against full minimax on seeded deals of each kSolverHarnessFoundations and exit
+static const int kSolverHarnessDeals = 1000; // per foundation
+static const unsigned int kSolverHarnessSeed = 1;
+static const int kSolverHarnessFoundations[][2] = { { 3, 3 }, { 4, 4 }, { 5, 5 }, { 6, 6 }, { kDefaultHandSize, kDefaultMaxDominoSuit } }; // hand size, max suit
+static const bool kRunTournament = false; // play Monte Carlo at each of kTournamentSampleCounts, greedy and random against each other and exit
+static const int kTournamentSampleCounts[] = { 10, 30, 100 };
+static const int kTournamentDeals = 200; // per pairing, each played in both seats
+static const unsigned int kTournamentSeed = 1;
+static const bool kEstimateHandEquity = false; // estimate the expected value of the max hand with rank kHandEquityRank and exit
+static const int kHandEquityRank = 0;
+static const double kHandEquityTargetStandardError = kDefaultHandEquityTargetStandardError;
+static const bool kCompareHandEquityWithNaiveSampling = true; // also sample uniformly to the same standard error
+static const bool kExportTrainingData = false; // solve every position of kTrainingGames seeded games, write them to one shard per thread and exit
+static const int kTrainingGames = kDefaultTrainingGames;
+static const unsigned int kTrainingSeed = 1;
+static const double kTrainingRandomMoveRate = kDefaultTrainingRandomMoveRate; // the rest of the moves are the solved best move
+static const char* kTrainingPathPrefix = "training_positions"; // shards are kTrainingPathPrefix.0, .1, ...
+static const SweepRole kSweepRole = kSweepRoleNone; // a first argument of coordinator [port], worker [host] [port] [samples] or smoke-test overrides this
+static const char* kSweepHost = "127.0.0.1"; // the coordinator, for workers
+static const int kSweepPort = kDefaultSweepPort;
+static const int kSweepFirstHand = 0;
+static const int kSweepEndHand = 1184040;
+static const int kSweepLeaseSize = kDefaultSweepLeaseSize; // hands per lease
+static const int kSweepLeaseTimeoutSeconds = kDefaultSweepLeaseTimeoutSeconds; // a lease not returned by then goes to another worker
+static const char* kSweepRecordPath = "sweep_games.bin"; // where the coordinator writes every game record
+static const int kSweepSmokeTestSamples = 10; // per move. the smoke test checks the plumbing, not the play
+static const char* kSweepSmokeTestRecordPath = "sweep_smoke_test.bin";
+
+// the Monte Carlo settings every mode plays with. a book or cache that is not open is left out
+static MonteCarloSettings _monteCarloSettings(const int numberOfSamples, const unsigned int seed, const OpeningBook* openingBook, PersistentSolutionCache* solutionCache) {
+    MonteCarloSettings settings(numberOfSamples, kReuseMonteCarloSolutions, seed);
+    settings.openingBook = openingBook != NULL && openingBook->isOpen() ? openingBook : NULL;
+    settings.persistentSolutionCache = solutionCache != NULL && solutionCache->isOpen() ? solutionCache : NULL;
+    settings.voteCriterion = kMonteCarloVoteCriterion;
+    settings.usePartitionSearch = kUsePartitionSearch;
+    settings.useMultiWorldSearch = kUseMultiWorldSearch;
+    settings.depthLimitedSearchDepth = kDepthLimitedSearchDepth;
+    settings.exactSearchMaximumTiles = kExactSearchMaximumTiles;
+    settings.threadPlacement = kThreadPlacement;
+    return settings;
+}
 
 int main(int argc, const char * argv[]) {
     const GameFoundation gameFoundation;
 
+    if (kBuildOpeningBook) {
+        const auto buildStart = std::chrono::high_resolution_clock::now();
+        const int handsBuilt = OpeningBookBuilder::buildHands(kOpeningBookPath, gameFoundation, MonteCarloSettings(kNumberOfSamples), kOpeningBookFirstHand, kOpeningBookEndHand);
+        const std::chrono::duration<double> buildElapsed = std::chrono::high_resolution_clock::now() - buildStart;
+        std::cout << "Opening Book Hands Built: " << handsBuilt << " in " << buildElapsed.count() << " s\n";
+        return handsBuilt < 0 ? 1 : 0;
+    }
+
+    if (kRunSolverHarness) {
+        SolverHarnessData harnessData;
+        for (int i = 0; i < sizeof(kSolverHarnessFoundations) / sizeof(kSolverHarnessFoundations[0]); i++) {
+            // smallest first, so the first mismatch reported is in the smallest game that has one
+            const GameFoundation harnessFoundation(kSolverHarnessFoundations[i][0], kSolverHarnessFoundations[i][1]);
+            harnessData.configs.push_back(SolverHarness::runOnFoundation(harnessFoundation, kSolverHarnessDeals, kSolverHarnessSeed));
+            std::cout << harnessData.configs.back().prettyString();
+        }
+        std::cout << "Total Mismatches: " << harnessData.getMismatches() << "\n";
+        return harnessData.getMismatches() > 0 ? 1 : 0;
+    }
+
+    if (kRunTournament) {
+        TournamentStrategyVector strategies;
+        for (int i = 0; i < sizeof(kTournamentSampleCounts) / sizeof(kTournamentSampleCounts[0]); i++) {
+            strategies.push_back(TournamentStrategy::monteCarlo(_monteCarloSettings(kTournamentSampleCounts[i], 0, NULL, NULL)));
+        }
+        strategies.push_back(TournamentStrategy(kTournamentStrategyGreedy, "Greedy"));
+        strategies.push_back(TournamentStrategy(kTournamentStrategyRandom, "Random"));
+        const TournamentData tournamentData = Tournament::run(gameFoundation, strategies, kTournamentDeals, kTournamentSeed);
+        std::cout << "*Tournament Data*\n" << tournamentData.prettyString() << "\n";
+        return 0;
+    }
+
+    PersistentSolutionCache solutionCache;
+    if (strlen(kSolutionCachePath) > 0 && !solutionCache.open(kSolutionCachePath, gameFoundation, kSolutionCacheSizeLog2)) {
+        std::cout << "Could not open the solution cache " << kSolutionCachePath << "\n";
+    }
+
+    if (kEstimateHandEquity) {
+        HandEquitySettings handEquitySettings(kHandEquityTargetStandardError);
+        handEquitySettings.compareWithNaiveSampling = kCompareHandEquityWithNaiveSampling;
+        handEquitySettings.persistentSolutionCache = solutionCache.isOpen() ? &solutionCache : NULL;
+        const HandEquityData handEquityData = HandEquityEstimator::estimate(gameFoundation, kHandEquityRank, handEquitySettings);
+        std::cout << "*Hand Equity Data*\n" << handEquityData.prettyString() << "\n";
+        return 0;
+    }
+
+    if (kExportTrainingData) {
+        TrainingSettings trainingSettings(kTrainingGames, kTrainingSeed, kTrainingRandomMoveRate);
+        trainingSettings.pathPrefix = kTrainingPathPrefix;
+        trainingSettings.persistentSolutionCache = solutionCache.isOpen() ? &solutionCache : NULL;
+        const TrainingData trainingData = TrainingDataGenerator::run(gameFoundation, trainingSettings);
+        std::cout << "*Training Data*\n" << trainingData.prettyString() << "\n";
+        return trainingData.shardPaths.empty() ? 1 : 0;
+    }
+
+    if (strlen(kTracePath) > 0) {
+        Tracer::enable();
+    }
+    if (kThreadPlacement != kThreadPlacementNone) {
+        std::cout << "*CPU Topology*\n" << CpuTopology::current().prettyString() << "\n";
+    }
+
+    OpeningBook openingBook;
+    if (strlen(kOpeningBookPath) > 0 && openingBook.open(kOpeningBookPath, gameFoundation)) {
+        std::cout << "Opening Book Hands: " << openingBook.numberOfBuiltRecords() << "\n";
+    }
+
+    SweepRole sweepRole = kSweepRole;
+    if (argc > 1) {
+        sweepRole = strcmp(argv[1], "coordinator") == 0 ? kSweepRoleCoordinator : (strcmp(argv[1], "worker") == 0 ? kSweepRoleWorker : (strcmp(argv[1], "smoke-test") == 0 ? kSweepRoleSmokeTest : kSweepRoleNone));
+    }
+    if (sweepRole == kSweepRoleSmokeTest) {
+        std::string failure;
+        const bool passed = SweepSmokeTest::run(argv[0], gameFoundation, kSweepSmokeTestSamples, kSweepSmokeTestRecordPath, failure);
+        std::cout << "Sweep Smoke Test: " << (passed ? "passed" : "failed, " + failure) << "\n";
+        return passed ? 0 : 1;
+    }
+    if (sweepRole == kSweepRoleCoordinator) {
+        const int port = argc > 2 ? atoi(argv[2]) : kSweepPort;
+        SweepCoordinator coordinator(gameFoundation, kSweepFirstHand, kSweepEndHand, kSweepLeaseSize, kSweepLeaseTimeoutSeconds);
+        GameRecordWriter sweepRecordWriter;
+        if (!sweepRecordWriter.open(kSweepRecordPath, gameFoundation) || !coordinator.listen(port)) {
+            std::cout << "Could not start the sweep coordinator on port " << port << "\n";
+            return 1;
+        }
+        std::cout << "Sweep Coordinator Listening On Port " << coordinator.getPort() << "\n";
+        const SweepData sweepData = coordinator.run(sweepRecordWriter);
+        std::cout << "*Sweep Data*\n" << sweepData.prettyString() << "\n";
+        return 0;
+    }
+    if (sweepRole == kSweepRoleWorker) {
+        const std::string host = argc > 2 ? argv[2] : kSweepHost;
+        const int port = argc > 3 ? atoi(argv[3]) : kSweepPort;
+        const int samples = argc > 4 ? atoi(argv[4]) : kNumberOfSamples;
+        const MonteCarloSettings sweepSettings = _monteCarloSettings(samples, (unsigned int)std::chrono::system_clock::now().time_since_epoch().count(), &openingBook, &solutionCache);
+        const long long gamesPlayed = SweepWorker::run(host, port, gameFoundation, sweepSettings);
+        if (gamesPlayed < 0) {
+            std::cout << "Could not reach the sweep coordinator at " << host << ":" << port << "\n";
+            return 1;
+        }
+        std::cout << "Sweep Games Played: " << gamesPlayed << "\n";
+        return 0;
+    }
+
+    ResultsFile resultsFile(stdout);
+    if (strlen(kResultsPath) > 0 && !resultsFile.open(kResultsPath)) {
+        std::cout << "Could not open results file " << kResultsPath << "\n";
+        return 1;
+    }
+    const std::unique_ptr<ResultsSink> resultsSink = ResultsSink::sinkForFormat(kResultsFormat, kResultsPerPlyDetail, kReportMemory);
+    const bool printPrettyStrings = !resultsSink;
+    // summaries go to stderr when stdout may carry csv or json lines
+    std::ostream& summaryOutput = printPrettyStrings ? std::cout : std::cerr;
+
+    GameRecordWriter gameRecordWriter;
+    if (strlen(kGameRecordPath) > 0 && !kRunPipelinedBatch && !gameRecordWriter.open(kGameRecordPath, gameFoundation)) {
+        std::cout << "Could not open game record file " << kGameRecordPath << "\n";
+    }
+
     IntVector maxHandIndexList = CombinationListCreator::indexList(gameFoundation.numberOfDominoes, gameFoundation.handSize, true);
 
+    if (kRunPipelinedBatch) {
+        const IntVector batchHandNumbers(maxHandIndexList.begin(), maxHandIndexList.begin() + std::min(kNumberOfGames, (int)maxHandIndexList.size()));
+        BatchSettings batchSettings(_monteCarloSettings(kNumberOfSamples, 0, &openingBook, &solutionCache), kRunFullMinimax, kRecordMinimaxPath);
+        batchSettings.gameRecordPath = kGameRecordPath;
+        batchSettings.measureMemory = kReportMemory;
+        const BatchData batchData = resultsSink ? BatchPipeline::runOnHands(gameFoundation, batchHandNumbers, batchSettings, resultsFile, *resultsSink) : BatchPipeline::runOnHands(gameFoundation, batchHandNumbers, batchSettings, std::cout);
+        summaryOutput << "*Batch Data*\n" << batchData.prettyString() << "\n";
+        if (strlen(kTracePath) > 0 && !Tracer::writeChromeTrace(kTracePath)) {
+            std::cout << "Could not write the trace to " << kTracePath << "\n";
+        }
+        return 0;
+    }
+
+    if (kRunMonteCarloGamePool) {
+        GameVector games;
+        games.reserve(kNumberOfGames);
+        for (int currentGameNumber = 0; currentGameNumber < kNumberOfGames; currentGameNumber++) {
+            games.push_back(Game::gameWithStartingMaxPayerHandNumber(gameFoundation, maxHandIndexList[currentGameNumber]));
+        }
+        const MonteCarloSettings poolSettings = _monteCarloSettings(kNumberOfSamples, (unsigned int)std::chrono::system_clock::now().time_since_epoch().count(), &openingBook, &solutionCache);
+        MonteCarloPoolData poolData;
+        const MemoryPhase poolMemoryPhase(kMemoryPhaseMonteCarlo);
+        const MonteCarloDataVector poolResults = MonteCarloDataGenerator::generateDataForGames(games, poolSettings, poolData);
+        long long poolNodesVisited = 0;
+        for (int i = 0; i < poolResults.size(); i++) {
+            poolNodesVisited += poolResults[i].getTotalNodesVisited();
+        }
+        // the games share the workers, so every game's row carries the phase measured over the whole pool
+        MemoryData poolMemoryData;
+        poolMemoryData.phases.push_back(poolMemoryPhase.finish(poolNodesVisited));
+        ResultsBuffer resultsBuffer(resultsFile);
+        if (resultsSink) {
+            resultsSink->writeHeader(resultsBuffer);
+        }
+        BatchStatistics poolStatistics;
+        for (int i = 0; i < poolResults.size(); i++) {
+            poolStatistics.addMonteCarloData(poolResults[i]);
+            if (gameRecordWriter.isOpen()) {
+                gameRecordWriter.write(GameRecord::recordForPath(poolResults[i].path, poolSettings.seed));
+            }
+            if (resultsSink) {
+                // only Monte Carlo ran, so the perfect information columns are left empty
+                GameAnalysis analysis(i, maxHandIndexList[i], games[i]);
+                analysis.monteCarloData = MonteCarloData(poolResults[i]);
+                analysis.analysisDuration = poolResults[i].getTotalMoveDuration();
+                analysis.memoryData = poolMemoryData;
+                resultsSink->writeGame(resultsBuffer, analysis);
+            } else {
+                std::cout << "Game " << (i + 1) << " Final Score: " << poolResults[i].path.back().getScore() << ", Move Time: " << poolResults[i].getTotalMoveDuration() << " s\n";
+            }
+        }
+        resultsBuffer.flush();
+        summaryOutput << "*Monte Carlo Pool Data*\n" << poolData.prettyString() << "\n";
+        summaryOutput << "*Batch Statistics*\n" << poolStatistics.prettyString() << "\n";
+        if (kReportMemory) {
+            summaryOutput << "*Memory Data*\n" << poolMemoryData.prettyString() << "\n";
+        }
+        if (strlen(kTracePath) > 0 && !Tracer::writeChromeTrace(kTracePath)) {
+            std::cout << "Could not write the trace to " << kTracePath << "\n";
+        }
+        return 0;
+    }
+
     std::vector<std::chrono::duration<double>> gameDurations;
 
+    ResultsBuffer resultsBuffer(resultsFile);
+    if (resultsSink) {
+        resultsSink->writeHeader(resultsBuffer);
+    }
+    BatchStatistics batchStatistics;
+
     const auto totalStart = std::chrono::high_resolution_clock::now();
 
     for (int currentGameNumber = 0; currentGameNumber < kNumberOfGames; currentGameNumber++) {
@@ -37,38 +314,160 @@ int main(int argc, const char * argv[]) {
         const Game game = Game::gameWithStartingMaxPayerHandNumber(gameFoundation, maxHandIndexList[currentGameNumber]);
         const GameState initialState(game);
 
+        MemoryData memoryData;
+
         // *** Game Tree Data
+        const MemoryPhase gameTreeMemoryPhase(kMemoryPhaseGameTree);
         const GameTreeData gameTreeData = GameTreeDataGenerator::generateDataFromState(initialState);
-        std::cout << "*Game Tree Data*\n" << gameTreeData.prettyString() << "\n";
+        if (printPrettyStrings) {
+            std::cout << "*Game Tree Data*\n" << gameTreeData.prettyString() << "\n";
+        }
+        memoryData.phases.push_back(gameTreeMemoryPhase.finish(gameTreeData.getTotalNodes()));
 
         // *** Full Minimax Data
         MinimaxData fullMinimaxData;
         if (kRunFullMinimax) {
+            const MemoryPhase fullMinimaxMemoryPhase(kMemoryPhaseFullMinimax);
             GameState minimaxGameState(initialState);
             fullMinimaxData = MinimaxSearch::runOnState(minimaxGameState);
-            std::cout << "*Full Minimax Data*\n" << fullMinimaxData.prettyString(false) << "\n";
+            if (printPrettyStrings) {
+                std::cout << "*Full Minimax Data*\n" << fullMinimaxData.prettyString(false) << "\n";
+            }
             assert(gameTreeData.getTotalNodes() == fullMinimaxData.nodesVisited);
+            memoryData.phases.push_back(fullMinimaxMemoryPhase.finish(fullMinimaxData.nodesVisited));
         }
 
         // *** Alpha-Beta Minimax Data
+        // no solution store or persistent cache: this is the reference for node counts, and a stored
+        // value would end the recorded path at an interior node
+        const MemoryPhase alphaBetaMemoryPhase(kMemoryPhaseAlphaBetaMinimax);
         GameState alphaBetaGameState(initialState);
         const MinimaxData alphaBetaMinimaxData = AlphaBetaMinimaxSearch::runOnState(alphaBetaGameState, kRecordMinimaxPath);
-        std::cout << "*Alpha-Beta Minimax Data*\n" << alphaBetaMinimaxData.prettyString(kRecordMinimaxPath) << "\n";
+        if (printPrettyStrings) {
+            std::cout << "*Alpha-Beta Minimax Data*\n" << alphaBetaMinimaxData.prettyString(kRecordMinimaxPath) << "\n";
+        }
         assert(!kRunFullMinimax || fullMinimaxData.minimaxValue == alphaBetaMinimaxData.minimaxValue);
+        memoryData.phases.push_back(alphaBetaMemoryPhase.finish(alphaBetaMinimaxData.nodesVisited));
+
+        // *** Multi-PV Data
+        if (kRunMultiPV) {
+            GameState multiPVGameState(initialState);
+            const MultiPVData multiPVData = MultiPVSearch::runOnState(multiPVGameState);
+            if (printPrettyStrings) {
+                std::cout << "*Multi-PV Data*\n" << multiPVData.prettyString() << "\n";
+            }
+            assert(multiPVGameState.minimaxValue == alphaBetaMinimaxData.minimaxValue);
+        }
+
+        // *** Resumable Alpha-Beta Data
+        if (kResumableSearchSliceNodes > 0) {
+            GameState resumableGameState(initialState);
+            ResumableAlphaBetaSearch resumableSearch(resumableGameState, false);
+            int slices = 1;
+            while (!resumableSearch.resume(kResumableSearchSliceNodes)) {
+                slices++;
+            }
+            if (printPrettyStrings) {
+                std::cout << "*Resumable Alpha-Beta Data*\n" << resumableSearch.getData().prettyString(false) << "Slices: " << slices << "\n\n";
+            }
+            assert(resumableSearch.getData().minimaxValue == alphaBetaMinimaxData.minimaxValue);
+            assert(resumableSearch.getData().nodesVisited == alphaBetaMinimaxData.nodesVisited);
+        }
+
+        // *** Proof-Number Data
+        if (kRunProofNumberSearch) {
+            GameState proofNumberGameState(initialState);
+            const ProofNumberData proofNumberData = ProofNumberSearch::runOnState(proofNumberGameState);
+            if (printPrettyStrings) {
+                std::cout << "*Proof-Number Data*\n" << proofNumberData.prettyString() << "\n";
+            }
+            assert(proofNumberData.proven == (alphaBetaMinimaxData.minimaxValue > proofNumberData.threshold));
+
+            GameState seededGameState(initialState);
+            const MinimaxData seededMinimaxData = AlphaBetaMinimaxSearch::runOnStateWithWindow(seededGameState, false, proofNumberData.getLowerBound(), proofNumberData.getUpperBound());
+            if (printPrettyStrings) {
+                std::cout << "*Proof-Number Seeded Alpha-Beta Data*\n" << seededMinimaxData.prettyString(false) << "\n";
+            }
+            assert(seededMinimaxData.minimaxValue == alphaBetaMinimaxData.minimaxValue);
+        }
 
         // *** Monte Carlo
-        const MonteCarloData monteCarloData = MonteCarloDataGenerator::generateData(game, initialState, kNumberOfSamples);
-        std::cout << "*Monte Carlo Data*\n" << monteCarloData.prettyString() << "\n";
+        const unsigned int monteCarloSeed = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
+        const MonteCarloSettings monteCarloSettings = _monteCarloSettings(kNumberOfSamples, monteCarloSeed, &openingBook, &solutionCache);
+        const MemoryPhase monteCarloMemoryPhase(kMemoryPhaseMonteCarlo);
+        const MonteCarloData monteCarloData = MonteCarloDataGenerator::generateData(game, initialState, monteCarloSettings);
+        memoryData.phases.push_back(monteCarloMemoryPhase.finish(monteCarloData.getTotalNodesVisited()));
+        if (printPrettyStrings) {
+            std::cout << "*Monte Carlo Data*\n" << monteCarloData.prettyString() << "\n";
+            std::cout << "*Monte Carlo Move Times*\n" << monteCarloData.timingString() << "\n";
+        }
+        if (kReviewMonteCarloGames && printPrettyStrings) {
+            std::cout << "*Game Review*\n" << GameReview::reviewGame(monteCarloData, true, solutionCache.isOpen() ? &solutionCache : NULL).prettyString() << "\n";
+        }
+        if (kReportMemory && printPrettyStrings) {
+            std::cout << "*Memory Data*\n" << memoryData.prettyString() << "\n";
+        }
+        if (gameRecordWriter.isOpen()) {
+            gameRecordWriter.write(GameRecord::recordForPath(monteCarloData.path, monteCarloSeed));
+        }
+
+        if (kCompareMonteCarloSolutionReuse) {
+            // same seed, so the same samples are drawn and the same moves are chosen
+            MonteCarloSettings comparisonSettings = monteCarloSettings;
+            comparisonSettings.reuseSolutions = !kReuseMonteCarloSolutions;
+            const MonteCarloData comparisonData = MonteCarloDataGenerator::generateData(game, initialState, comparisonSettings);
+            const std::string reuseString = comparisonSettings.reuseSolutions ? "With" : "Without";
+            if (printPrettyStrings) {
+                std::cout << "*Monte Carlo Move Times " << reuseString << " Solution Reuse*\n" << comparisonData.timingString() << "\n";
+            }
+            assert(comparisonData.path.size() == monteCarloData.path.size());
+        }
+
+        if (kCompareThreadPlacement) {
+            // same seed, so only where the sampling threads run differs
+            MonteCarloSettings comparisonSettings = monteCarloSettings;
+            comparisonSettings.threadPlacement = kThreadPlacement == kThreadPlacementNone ? kThreadPlacementCore : kThreadPlacementNone;
+            const MonteCarloData comparisonData = MonteCarloDataGenerator::generateData(game, initialState, comparisonSettings);
+            const std::string placementString = comparisonSettings.threadPlacement != kThreadPlacementNone ? "With" : "Without";
+            if (printPrettyStrings) {
+                std::cout << "*Monte Carlo Move Times " << placementString << " Thread Placement*\n" << comparisonData.timingString() << "\n";
+            }
+            assert(comparisonData.path.size() == monteCarloData.path.size());
+        }
 
         const auto gameFinish = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> gameElapsed = gameFinish - gameStart;
         gameDurations.push_back(gameElapsed);
-        std::cout << "Game " << currentGameNumber + 1 << " Elapsed Time: " << gameElapsed.count() << " s\n";
+
+        GameAnalysis analysis(currentGameNumber, maxHandIndexList[currentGameNumber], game);
+        analysis.ranPerfectInformation = true;
+        analysis.gameTreeData = gameTreeData;
+        analysis.ranFullMinimax = kRunFullMinimax;
+        // GameState is not assignable, so paths are copied into temporaries and moved in
+        analysis.fullMinimaxData = MinimaxData(fullMinimaxData);
+        analysis.alphaBetaMinimaxData = MinimaxData(alphaBetaMinimaxData);
+        analysis.monteCarloData = MonteCarloData(monteCarloData);
+        analysis.analysisDuration = gameElapsed.count();
+        analysis.memoryData = memoryData;
+        batchStatistics.addGame(analysis);
+        if (resultsSink) {
+            resultsSink->writeGame(resultsBuffer, analysis);
+        }
+        if (printPrettyStrings) {
+            std::cout << "Game " << currentGameNumber + 1 << " Elapsed Time: " << gameElapsed.count() << " s\n";
+        }
     }
 
     const auto totalFinish = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = totalFinish - totalStart;
-    std::cout << "Total Elapsed Time: " << elapsed.count() << " s\n";
+    resultsBuffer.flush();
+    summaryOutput << "Total Elapsed Time: " << elapsed.count() << " s\n";
+    if (kNumberOfGames > 1) {
+        summaryOutput << "*Batch Statistics*\n" << batchStatistics.prettyString() << "\n";
+    }
+    if (strlen(kTracePath) > 0 && !Tracer::writeChromeTrace(kTracePath)) {
+        std::cout << "Could not write the trace to " << kTracePath << "\n";
+    }
 
     return 0;
 }
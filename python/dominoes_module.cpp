@@ -0,0 +1,738 @@
+//
+//  dominoes_module.cpp
+//
+//  Copyright © 2019 Kevin Broom. All rights reserved.
+//
+
+// CPython extension exposing the solver as the dominoes module. batch calls read their input through the
+// buffer protocol and return a dominoes.Int32Array that exports its native storage the same way, so
+// numpy.asarray() and memoryview() share the results without a copy per item. the GIL is released while
+// the worker threads search.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "Game.hpp"
+#include "GameFoundation.hpp"
+#include "GameState.hpp"
+#include "MinimaxSearch.hpp"
+#include "MonteCarloDataGenerator.hpp"
+#include "PersistentSolutionCache.hpp"
+#include "SolutionStore.hpp"
+
+// columns of a position row: max hand, min hand and played tiles as masks with a bit per dominoSet index,
+// the two layout ends (-1 before the first tile), then flags
+static const int kPositionColumns = 6;
+static const int kPositionFlagMinPlayerTurn = 1;
+static const int kPositionFlagPreviousPlayerPassed = 2;
+
+// columns of a move row: the tile played (-1 for a pass) and the layout end it is played on (-1 for the first tile)
+static const int kMoveColumns = 2;
+
+// *** Int32Array
+
+struct Int32ArrayObject {
+    PyObject_HEAD
+    std::vector<int32_t>* values;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+static void _int32ArrayDealloc(Int32ArrayObject* self) {
+    delete self->values;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int _int32ArrayGetBuffer(Int32ArrayObject* self, Py_buffer* view, int flags) {
+    // storage never moves, so any number of exports can be outstanding
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->buf = self->values->data();
+    view->len = (Py_ssize_t)(self->values->size() * sizeof(int32_t));
+    view->readonly = 0;
+    view->itemsize = sizeof(int32_t);
+    view->format = (flags & PyBUF_FORMAT) ? (char*)"i" : NULL;
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static Py_ssize_t _int32ArrayLength(Int32ArrayObject* self) {
+    return self->shape[0];
+}
+
+static PyObject* _int32ArrayShape(Int32ArrayObject* self, void* closure) {
+    return self->ndim == 1 ? Py_BuildValue("(n)", self->shape[0]) : Py_BuildValue("(nn)", self->shape[0], self->shape[1]);
+}
+
+static PyObject* _int32ArrayToList(Int32ArrayObject* self, PyObject* unused) {
+    PyObject* view = PyMemoryView_FromObject((PyObject*)self);
+    if (view == NULL) {
+        return NULL;
+    }
+    PyObject* result = PyObject_CallMethod(view, "tolist", NULL);
+    Py_DECREF(view);
+    return result;
+}
+
+static PyBufferProcs _int32ArrayBufferProcs = {
+    (getbufferproc)_int32ArrayGetBuffer,
+    NULL
+};
+
+static PySequenceMethods _int32ArraySequenceMethods = {
+    (lenfunc)_int32ArrayLength
+};
+
+static PyGetSetDef _int32ArrayGetSet[] = {
+    { "shape", (getter)_int32ArrayShape, NULL, "rows, and columns for a two-dimensional result", NULL },
+    { NULL }
+};
+
+static PyMethodDef _int32ArrayMethods[] = {
+    { "tolist", (PyCFunction)_int32ArrayToList, METH_NOARGS, "the values as (nested) lists" },
+    { NULL }
+};
+
+static PyTypeObject Int32ArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "dominoes.Int32Array"
+};
+
+static Int32ArrayObject* _newInt32Array(const Py_ssize_t rows, const Py_ssize_t columns) {
+    Int32ArrayObject* result = PyObject_New(Int32ArrayObject, &Int32ArrayType);
+    if (result == NULL) {
+        return NULL;
+    }
+    result->values = new std::vector<int32_t>((size_t)(rows * std::max((Py_ssize_t)1, columns)), 0);
+    result->ndim = columns > 0 ? 2 : 1;
+    result->shape[0] = rows;
+    result->shape[1] = columns;
+    result->strides[0] = (Py_ssize_t)sizeof(int32_t) * std::max((Py_ssize_t)1, columns);
+    result->strides[1] = sizeof(int32_t);
+    return result;
+}
+
+// *** Input
+
+// a C-contiguous integer buffer read in place, viewed as rows of columns values
+struct IntegerInput {
+    Py_buffer view;
+    Py_ssize_t rows;
+    Py_ssize_t columns;
+    bool isSigned;
+
+    inline long long value(const Py_ssize_t row, const Py_ssize_t column) const {
+        const char* item = (const char*)view.buf + ((row * columns) + column) * view.itemsize;
+        switch (view.itemsize) {
+            case 1: return isSigned ? (long long)*(const int8_t*)item : (long long)*(const uint8_t*)item;
+            case 2: return isSigned ? (long long)*(const int16_t*)item : (long long)*(const uint16_t*)item;
+            case 4: return isSigned ? (long long)*(const int32_t*)item : (long long)*(const uint32_t*)item;
+            default: return *(const long long*)item; // unsigned 64-bit values keep their bits
+        }
+    }
+};
+
+static bool _getIntegerInput(PyObject* object, const Py_ssize_t columns, const char* name, IntegerInput& input) {
+    if (PyObject_GetBuffer(object, &input.view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        return false;
+    }
+    std::string format = input.view.format != NULL ? input.view.format : "B";
+    if (!format.empty() && (format[0] == '@' || format[0] == '=' || (format[0] == '<' && PY_LITTLE_ENDIAN) || (format[0] == '>' && PY_BIG_ENDIAN))) {
+        format = format.substr(1);
+    }
+    const bool isInteger = format.size() == 1 && std::string("bBhHiIlLqQnN").find(format[0]) != std::string::npos;
+    const bool hasColumns = input.view.ndim == 2 ? input.view.shape[1] == columns : (input.view.len / input.view.itemsize) % columns == 0;
+    if (!isInteger || input.view.ndim > 2 || !hasColumns) {
+        PyErr_Format(PyExc_ValueError, "%s must be native integers, one row of %zd values each", name, columns);
+        PyBuffer_Release(&input.view);
+        return false;
+    }
+    input.isSigned = islower(format[0]);
+    input.columns = columns;
+    input.rows = (input.view.len / input.view.itemsize) / columns;
+    return true;
+}
+
+// *** Work
+
+// opens the cache at path for one call. NULL leaves it closed
+static bool _openSolutionCache(const char* path, const GameFoundation& gameFoundation, PersistentSolutionCache& solutionCache) {
+    if (path == NULL || solutionCache.open(path, gameFoundation)) {
+        return true;
+    }
+    PyErr_Format(PyExc_OSError, "could not open the solution cache %s for this foundation", path);
+    return false;
+}
+
+static int _numberOfThreads(const int requested, const Py_ssize_t jobs) {
+    const int threads = requested > 0 ? requested : std::max(1, (int)std::thread::hardware_concurrency());
+    return (int)std::max((Py_ssize_t)1, std::min((Py_ssize_t)threads, jobs));
+}
+
+// runs work(row) for every row on numberOfThreads threads with the GIL released
+static void _runRows(const Py_ssize_t rows, const int numberOfThreads, const std::function<void(Py_ssize_t)>& work) {
+    Py_BEGIN_ALLOW_THREADS
+    std::atomic<Py_ssize_t> nextRow(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.push_back(std::thread([&]() {
+            for (Py_ssize_t row = nextRow++; row < rows; row = nextRow++) {
+                work(row);
+            }
+        }));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    Py_END_ALLOW_THREADS
+}
+
+static int _solveState(GameState& state, SolutionStore* solutionStore) {
+    return AlphaBetaMinimaxSearch::runOnState(state, false, solutionStore).minimaxValue;
+}
+
+// the Monte Carlo choice for state as a move row
+static void _selectMove(const Game& game, const GameState& state, const MonteCarloSettings& settings, int32_t* move) {
+    move[0] = -1;
+    move[1] = -1;
+    if (state.isLeafNode()) {
+        return;
+    }
+    DominoPointerVector childTiles;
+    const IntVector votes = MonteCarloDataGenerator::voteCountsForState(game, state, settings, childTiles);
+    const int bestChildIndex = (int)(std::max_element(votes.begin(), votes.end()) - votes.begin());
+    Domino const* tile = childTiles[bestChildIndex];
+    if (tile == NULL) {
+        return;
+    }
+    move[0] = game.gameFoundation.indexForDomino(tile);
+    if (state.playedTiles.empty()) {
+        return;
+    }
+
+    // a double can only go on the end with its suit. any other tile changes the end it goes on.
+    GameState workState = GameState::stateRemovingChildren(state);
+    workState.expandAndGenerateChildren();
+    const IntPair& childEnds = workState.children[bestChildIndex].layoutEnds;
+    if (tile->ends.first == tile->ends.second) {
+        move[1] = tile->ends.first;
+    } else {
+        move[1] = childEnds.first != state.layoutEnds.first ? state.layoutEnds.first : state.layoutEnds.second;
+    }
+}
+
+// *** GameFoundation
+
+struct GameFoundationObject {
+    PyObject_HEAD
+    GameFoundation* gameFoundation;
+};
+
+static PyTypeObject GameFoundationType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "dominoes.GameFoundation"
+};
+
+static int _gameFoundationInit(GameFoundationObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "hand_size", "max_suit", NULL };
+    int handSize = kDefaultHandSize;
+    int maxDominoSuit = kDefaultMaxDominoSuit;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ii", (char**)keywords, &handSize, &maxDominoSuit)) {
+        return -1;
+    }
+    const int numberOfDominoes = ((maxDominoSuit + 1) * (maxDominoSuit + 2)) / 2;
+    if (maxDominoSuit < 1 || numberOfDominoes > 64 || handSize < 1 || 2 * handSize > numberOfDominoes) {
+        PyErr_SetString(PyExc_ValueError, "need 1 <= max_suit with at most 64 tiles, and 1 <= hand_size with two hands fitting in the set");
+        return -1;
+    }
+    delete self->gameFoundation;
+    self->gameFoundation = new GameFoundation(handSize, maxDominoSuit);
+    return 0;
+}
+
+static void _gameFoundationDealloc(GameFoundationObject* self) {
+    delete self->gameFoundation;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* _gameFoundationGet(GameFoundationObject* self, void* closure) {
+    const GameFoundation& gameFoundation = *self->gameFoundation;
+    const std::string name = (const char*)closure;
+    if (name == "hand_size") {
+        return PyLong_FromLong(gameFoundation.handSize);
+    } else if (name == "max_suit") {
+        return PyLong_FromLong(gameFoundation.maxDominoSuit);
+    } else if (name == "number_of_dominoes") {
+        return PyLong_FromLong(gameFoundation.numberOfDominoes);
+    }
+    return PyLong_FromLong(gameFoundation.totalPoints);
+}
+
+static PyObject* _gameFoundationTiles(GameFoundationObject* self, PyObject* unused) {
+    const DominoVector& dominoSet = self->gameFoundation->dominoSet;
+    PyObject* result = PyList_New((Py_ssize_t)dominoSet.size());
+    for (int i = 0; result != NULL && i < dominoSet.size(); i++) {
+        PyList_SET_ITEM(result, i, Py_BuildValue("(ii)", dominoSet[i].ends.first, dominoSet[i].ends.second));
+    }
+    return result;
+}
+
+static PyGetSetDef _gameFoundationGetSet[] = {
+    { "hand_size", (getter)_gameFoundationGet, NULL, NULL, (void*)"hand_size" },
+    { "max_suit", (getter)_gameFoundationGet, NULL, NULL, (void*)"max_suit" },
+    { "number_of_dominoes", (getter)_gameFoundationGet, NULL, NULL, (void*)"number_of_dominoes" },
+    { "total_points", (getter)_gameFoundationGet, NULL, NULL, (void*)"total_points" },
+    { NULL }
+};
+
+static PyMethodDef _gameFoundationMethods[] = {
+    { "tiles", (PyCFunction)_gameFoundationTiles, METH_NOARGS, "the set as (suit, suit) pairs. tile indices elsewhere index this list." },
+    { NULL }
+};
+
+static GameFoundation* _gameFoundationForObject(PyObject* object) {
+    if (!PyObject_TypeCheck(object, &GameFoundationType) || ((GameFoundationObject*)object)->gameFoundation == NULL) {
+        PyErr_SetString(PyExc_TypeError, "expected an initialized dominoes.GameFoundation");
+        return NULL;
+    }
+    return ((GameFoundationObject*)object)->gameFoundation;
+}
+
+// *** Game
+
+struct GameObject {
+    PyObject_HEAD
+    PyObject* foundation; // keeps the GameFoundation game refers to alive
+    Game* game;
+};
+
+static PyTypeObject GameType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "dominoes.Game"
+};
+
+static bool _readHand(PyObject* sequence, const GameFoundation& gameFoundation, IntVector& tileIndices) {
+    PyObject* items = PySequence_Fast(sequence, "hands must be sequences of tile indices");
+    if (items == NULL) {
+        return false;
+    }
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(items); i++) {
+        const long tileIndex = PyLong_AsLong(PySequence_Fast_GET_ITEM(items, i));
+        if (tileIndex == -1 && PyErr_Occurred()) {
+            Py_DECREF(items);
+            return false;
+        }
+        tileIndices.push_back((int)tileIndex);
+    }
+    Py_DECREF(items);
+    return true;
+}
+
+static bool _dealIsValid(const GameFoundation& gameFoundation, const IntVector& maxPlayerTileIndices, const IntVector& minPlayerTileIndices) {
+    if (maxPlayerTileIndices.size() != gameFoundation.handSize || minPlayerTileIndices.size() != gameFoundation.handSize) {
+        return false;
+    }
+    uint64_t tiles = 0;
+    for (int i = 0; i < 2 * gameFoundation.handSize; i++) {
+        const int tileIndex = i < gameFoundation.handSize ? maxPlayerTileIndices[i] : minPlayerTileIndices[i - gameFoundation.handSize];
+        if (tileIndex < 0 || tileIndex >= gameFoundation.numberOfDominoes || (tiles & (1ULL << tileIndex))) {
+            return false;
+        }
+        tiles |= 1ULL << tileIndex;
+    }
+    return true;
+}
+
+static PyObject* _newGameObject(PyObject* foundation, const Game& game) {
+    GameObject* result = PyObject_New(GameObject, &GameType);
+    if (result == NULL) {
+        return NULL;
+    }
+    Py_INCREF(foundation);
+    result->foundation = foundation;
+    result->game = new Game(game);
+    return (PyObject*)result;
+}
+
+static PyObject* _gameNew(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "foundation", "max_hand", "min_hand", NULL };
+    PyObject* foundation;
+    PyObject* maxHand;
+    PyObject* minHand;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO", (char**)keywords, &foundation, &maxHand, &minHand)) {
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    IntVector maxPlayerTileIndices;
+    IntVector minPlayerTileIndices;
+    if (gameFoundation == NULL || !_readHand(maxHand, *gameFoundation, maxPlayerTileIndices) || !_readHand(minHand, *gameFoundation, minPlayerTileIndices)) {
+        return NULL;
+    }
+    if (!_dealIsValid(*gameFoundation, maxPlayerTileIndices, minPlayerTileIndices)) {
+        PyErr_SetString(PyExc_ValueError, "hands must be hand_size distinct tile indices each");
+        return NULL;
+    }
+    return _newGameObject(foundation, Game::gameWithHands(*gameFoundation, maxPlayerTileIndices, minPlayerTileIndices));
+}
+
+static void _gameDealloc(GameObject* self) {
+    delete self->game;
+    Py_XDECREF(self->foundation);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* _gameForSeed(PyObject* type, PyObject* args) {
+    PyObject* foundation;
+    unsigned int seed;
+    if (!PyArg_ParseTuple(args, "OI", &foundation, &seed)) {
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    return gameFoundation != NULL ? _newGameObject(foundation, Game::gameForSeed(*gameFoundation, seed)) : NULL;
+}
+
+static PyObject* _handList(const GameFoundation& gameFoundation, const DominoPointerVector& hand) {
+    PyObject* result = PyList_New((Py_ssize_t)hand.size());
+    for (int i = 0; result != NULL && i < hand.size(); i++) {
+        PyList_SET_ITEM(result, i, PyLong_FromLong(gameFoundation.indexForDomino(hand[i])));
+    }
+    return result;
+}
+
+static PyObject* _gameMaxHand(GameObject* self, void* closure) {
+    return _handList(self->game->gameFoundation, self->game->maxPlayerHand);
+}
+
+static PyObject* _gameMinHand(GameObject* self, void* closure) {
+    return _handList(self->game->gameFoundation, self->game->minPlayerHand);
+}
+
+static uint64_t _handMask(const GameFoundation& gameFoundation, const DominoPointerVector& hand) {
+    uint64_t result = 0;
+    for (int i = 0; i < hand.size(); i++) {
+        result |= gameFoundation.tileMaskForDomino(hand[i]);
+    }
+    return result;
+}
+
+static PyObject* _gameSolve(GameObject* self, PyObject* unused) {
+    int minimaxValue;
+    Py_BEGIN_ALLOW_THREADS
+    GameState state(*self->game);
+    minimaxValue = _solveState(state, NULL);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(minimaxValue);
+}
+
+static PyObject* _gameSelectMove(GameObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "samples", "threads", "seed", NULL };
+    MonteCarloSettings settings;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iiI", (char**)keywords, &settings.numberOfSamples, &settings.numberOfThreads, &settings.seed)) {
+        return NULL;
+    }
+    if (settings.numberOfSamples < 1) {
+        PyErr_SetString(PyExc_ValueError, "samples must be positive");
+        return NULL;
+    }
+    int32_t move[kMoveColumns];
+    Py_BEGIN_ALLOW_THREADS
+    // the same game select_moves makes for this deal. hands in deal order would generate the children in
+    // another order, and the vote would break ties differently.
+    const GameFoundation& gameFoundation = self->game->gameFoundation;
+    const Game game = Game::gameForPosition(gameFoundation, _handMask(gameFoundation, self->game->maxPlayerHand), _handMask(gameFoundation, self->game->minPlayerHand), 0);
+    const GameState state(game);
+    _selectMove(game, state, settings, move);
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("(ii)", move[0], move[1]);
+}
+
+static PyGetSetDef _gameGetSet[] = {
+    { "max_hand", (getter)_gameMaxHand, NULL, "the max player's tile indices", NULL },
+    { "min_hand", (getter)_gameMinHand, NULL, "the min player's tile indices", NULL },
+    { NULL }
+};
+
+static PyMethodDef _gameMethods[] = {
+    { "for_seed", (PyCFunction)_gameForSeed, METH_VARARGS | METH_CLASS, "for_seed(foundation, seed): the same deal for a seed on every platform" },
+    { "solve", (PyCFunction)_gameSolve, METH_NOARGS, "the minimax value of the deal with both hands known, positive when max wins" },
+    { "select_move", (PyCFunction)_gameSelectMove, METH_VARARGS | METH_KEYWORDS, "select_move(samples=100, threads=0, seed=0): the Monte Carlo choice of first move for the max player\n"
+      "as (tile index, layout end it goes on), the same move row select_moves returns. the end is -1 for a first tile." },
+    { NULL }
+};
+
+// *** Batch
+
+// rows of 2 * hand_size tile indices, the max hand then the min hand
+static bool _validateDeals(const GameFoundation& gameFoundation, const IntegerInput& deals) {
+    for (Py_ssize_t row = 0; row < deals.rows; row++) {
+        uint64_t tiles = 0;
+        for (Py_ssize_t column = 0; column < deals.columns; column++) {
+            const long long tileIndex = deals.value(row, column);
+            if (tileIndex < 0 || tileIndex >= gameFoundation.numberOfDominoes || (tiles & (1ULL << tileIndex))) {
+                PyErr_Format(PyExc_ValueError, "deal %zd does not hold distinct tile indices", row);
+                return false;
+            }
+            tiles |= 1ULL << tileIndex;
+        }
+    }
+    return true;
+}
+
+static Game _gameForDeal(const GameFoundation& gameFoundation, const IntegerInput& deals, const Py_ssize_t row) {
+    IntVector maxPlayerTileIndices;
+    IntVector minPlayerTileIndices;
+    for (int i = 0; i < gameFoundation.handSize; i++) {
+        maxPlayerTileIndices.push_back((int)deals.value(row, i));
+        minPlayerTileIndices.push_back((int)deals.value(row, gameFoundation.handSize + i));
+    }
+    return Game::gameWithHands(gameFoundation, maxPlayerTileIndices, minPlayerTileIndices);
+}
+
+static bool _validatePositions(const GameFoundation& gameFoundation, const IntegerInput& positions) {
+    const uint64_t allTiles = gameFoundation.numberOfDominoes == 64 ? ~0ULL : (1ULL << gameFoundation.numberOfDominoes) - 1;
+    for (Py_ssize_t row = 0; row < positions.rows; row++) {
+        const uint64_t maxPlayerTiles = (uint64_t)positions.value(row, 0);
+        const uint64_t minPlayerTiles = (uint64_t)positions.value(row, 1);
+        const uint64_t playedTiles = (uint64_t)positions.value(row, 2);
+        const long long firstEnd = positions.value(row, 3);
+        const long long secondEnd = positions.value(row, 4);
+        const bool overlaps = (maxPlayerTiles & minPlayerTiles) != 0 || ((maxPlayerTiles | minPlayerTiles) & playedTiles) != 0;
+        const bool outsideSet = ((maxPlayerTiles | minPlayerTiles | playedTiles) & ~allTiles) != 0;
+        const bool handTooLarge = __builtin_popcountll(maxPlayerTiles) > gameFoundation.handSize || __builtin_popcountll(minPlayerTiles) > gameFoundation.handSize;
+        const bool endsValid = playedTiles == 0 ? (firstEnd == -1 && secondEnd == -1)
+                                                : (firstEnd >= 0 && firstEnd <= gameFoundation.maxDominoSuit && secondEnd >= 0 && secondEnd <= gameFoundation.maxDominoSuit);
+        if (overlaps || outsideSet || handTooLarge || !endsValid || (maxPlayerTiles == 0 && minPlayerTiles == 0)) {
+            PyErr_Format(PyExc_ValueError, "position %zd is not a valid position", row);
+            return false;
+        }
+    }
+    return true;
+}
+
+static GameState _stateForPosition(const Game& game, const IntegerInput& positions, const Py_ssize_t row) {
+    const long long flags = positions.value(row, 5);
+    return GameState::stateForPosition(game,
+                                       game.gameFoundation.tilesForMask((uint64_t)positions.value(row, 2)),
+                                       (flags & kPositionFlagMinPlayerTurn) ? 1 : 0,
+                                       std::make_pair((int)positions.value(row, 3), (int)positions.value(row, 4)),
+                                       (flags & kPositionFlagPreviousPlayerPassed) != 0);
+}
+
+static Game _gameForPosition(const GameFoundation& gameFoundation, const IntegerInput& positions, const Py_ssize_t row) {
+    return Game::gameForPosition(gameFoundation, (uint64_t)positions.value(row, 0), (uint64_t)positions.value(row, 1), (uint64_t)positions.value(row, 2));
+}
+
+static PyObject* _solveDeals(PyObject* module, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "foundation", "deals", "threads", "cache", NULL };
+    PyObject* foundation;
+    PyObject* dealsObject;
+    int threads = 0;
+    const char* cachePath = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iz", (char**)keywords, &foundation, &dealsObject, &threads, &cachePath)) {
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    PersistentSolutionCache solutionCache;
+    if (gameFoundation != NULL && !_openSolutionCache(cachePath, *gameFoundation, solutionCache)) {
+        return NULL;
+    }
+    IntegerInput deals;
+    if (gameFoundation == NULL || !_getIntegerInput(dealsObject, 2 * gameFoundation->handSize, "deals", deals)) {
+        return NULL;
+    }
+    Int32ArrayObject* result = _validateDeals(*gameFoundation, deals) ? _newInt32Array(deals.rows, 0) : NULL;
+    if (result != NULL) {
+        int32_t* values = result->values->data();
+        SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, solutionCache.isOpen() ? &solutionCache : NULL); // positions are complete, so one store serves every deal
+        _runRows(deals.rows, _numberOfThreads(threads, deals.rows), [&](Py_ssize_t row) {
+            const Game game = _gameForDeal(*gameFoundation, deals, row);
+            GameState state(game);
+            values[row] = _solveState(state, &solutionStore);
+        });
+    }
+    PyBuffer_Release(&deals.view);
+    return (PyObject*)result;
+}
+
+static PyObject* _solveSeeds(PyObject* module, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "foundation", "seeds", "threads", "cache", NULL };
+    PyObject* foundation;
+    PyObject* seedsObject;
+    int threads = 0;
+    const char* cachePath = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iz", (char**)keywords, &foundation, &seedsObject, &threads, &cachePath)) {
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    PersistentSolutionCache solutionCache;
+    if (gameFoundation != NULL && !_openSolutionCache(cachePath, *gameFoundation, solutionCache)) {
+        return NULL;
+    }
+    IntegerInput seeds;
+    if (gameFoundation == NULL || !_getIntegerInput(seedsObject, 1, "seeds", seeds)) {
+        return NULL;
+    }
+    Int32ArrayObject* result = _newInt32Array(seeds.rows, 0);
+    if (result != NULL) {
+        int32_t* values = result->values->data();
+        SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, solutionCache.isOpen() ? &solutionCache : NULL);
+        _runRows(seeds.rows, _numberOfThreads(threads, seeds.rows), [&](Py_ssize_t row) {
+            const Game game = Game::gameForSeed(*gameFoundation, (unsigned int)seeds.value(row, 0));
+            GameState state(game);
+            values[row] = _solveState(state, &solutionStore);
+        });
+    }
+    PyBuffer_Release(&seeds.view);
+    return (PyObject*)result;
+}
+
+static PyObject* _solvePositions(PyObject* module, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "foundation", "positions", "threads", "cache", NULL };
+    PyObject* foundation;
+    PyObject* positionsObject;
+    int threads = 0;
+    const char* cachePath = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iz", (char**)keywords, &foundation, &positionsObject, &threads, &cachePath)) {
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    PersistentSolutionCache solutionCache;
+    if (gameFoundation != NULL && !_openSolutionCache(cachePath, *gameFoundation, solutionCache)) {
+        return NULL;
+    }
+    IntegerInput positions;
+    if (gameFoundation == NULL || !_getIntegerInput(positionsObject, kPositionColumns, "positions", positions)) {
+        return NULL;
+    }
+    Int32ArrayObject* result = _validatePositions(*gameFoundation, positions) ? _newInt32Array(positions.rows, 0) : NULL;
+    if (result != NULL) {
+        int32_t* values = result->values->data();
+        SolutionStore solutionStore(kDefaultSolutionStoreSizeLog2, solutionCache.isOpen() ? &solutionCache : NULL);
+        _runRows(positions.rows, _numberOfThreads(threads, positions.rows), [&](Py_ssize_t row) {
+            const Game game = _gameForPosition(*gameFoundation, positions, row);
+            GameState state = _stateForPosition(game, positions, row);
+            values[row] = _solveState(state, &solutionStore);
+        });
+    }
+    PyBuffer_Release(&positions.view);
+    return (PyObject*)result;
+}
+
+static PyObject* _selectMoves(PyObject* module, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "foundation", "positions", "samples", "threads", "seed", "cache", NULL };
+    PyObject* foundation;
+    PyObject* positionsObject;
+    int threads = 0;
+    MonteCarloSettings settings;
+    const char* cachePath = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iiIz", (char**)keywords, &foundation, &positionsObject, &settings.numberOfSamples, &threads, &settings.seed, &cachePath)) {
+        return NULL;
+    }
+    if (settings.numberOfSamples < 1) {
+        PyErr_SetString(PyExc_ValueError, "samples must be positive");
+        return NULL;
+    }
+    const GameFoundation* gameFoundation = _gameFoundationForObject(foundation);
+    PersistentSolutionCache solutionCache;
+    if (gameFoundation != NULL && !_openSolutionCache(cachePath, *gameFoundation, solutionCache)) {
+        return NULL;
+    }
+    settings.persistentSolutionCache = solutionCache.isOpen() ? &solutionCache : NULL;
+    IntegerInput positions;
+    if (gameFoundation == NULL || !_getIntegerInput(positionsObject, kPositionColumns, "positions", positions)) {
+        return NULL;
+    }
+    Int32ArrayObject* result = _validatePositions(*gameFoundation, positions) ? _newInt32Array(positions.rows, kMoveColumns) : NULL;
+    if (result != NULL) {
+        int32_t* values = result->values->data();
+        // positions run in parallel, each sampling on its own thread
+        settings.numberOfThreads = 1;
+        _runRows(positions.rows, _numberOfThreads(threads, positions.rows), [&](Py_ssize_t row) {
+            MonteCarloSettings rowSettings = settings;
+            rowSettings.seed = settings.seed == 0 ? 0 : settings.seed + (unsigned int)row;
+            const Game game = _gameForPosition(*gameFoundation, positions, row);
+            const GameState state = _stateForPosition(game, positions, row);
+            _selectMove(game, state, rowSettings, values + (row * kMoveColumns));
+        });
+    }
+    PyBuffer_Release(&positions.view);
+    return (PyObject*)result;
+}
+
+static PyMethodDef _moduleMethods[] = {
+    { "solve_deals", (PyCFunction)_solveDeals, METH_VARARGS | METH_KEYWORDS,
+      "solve_deals(foundation, deals, threads=0, cache=None): minimax values for rows of 2 * hand_size tile indices, max hand first.\n"
+      "cache is the path of a solution cache file, created if missing, that keeps solved positions across calls and processes." },
+    { "solve_seeds", (PyCFunction)_solveSeeds, METH_VARARGS | METH_KEYWORDS,
+      "solve_seeds(foundation, seeds, threads=0, cache=None): minimax values for the deals Game.for_seed makes" },
+    { "solve_positions", (PyCFunction)_solvePositions, METH_VARARGS | METH_KEYWORDS,
+      "solve_positions(foundation, positions, threads=0, cache=None): minimax values for position rows of\n"
+      "(max hand mask, min hand mask, played mask, first end, second end, flags). flags bit 0 is set when the\n"
+      "min player moves, bit 1 when the previous player passed. ends are -1 before the first tile." },
+    { "select_moves", (PyCFunction)_selectMoves, METH_VARARGS | METH_KEYWORDS,
+      "select_moves(foundation, positions, samples=100, threads=0, seed=0, cache=None): the Monte Carlo move for each\n"
+      "position row as (tile index, layout end it goes on). -1 marks a pass, a finished position, or the first tile's end.\n"
+      "the player to move only knows its own hand and the played tiles." },
+    { NULL }
+};
+
+static PyModuleDef _moduleDefinition = {
+    PyModuleDef_HEAD_INIT,
+    "dominoes",
+    "dominoes minimax and Monte Carlo solver",
+    -1,
+    _moduleMethods
+};
+
+PyMODINIT_FUNC PyInit_dominoes(void) {
+    Int32ArrayType.tp_basicsize = sizeof(Int32ArrayObject);
+    Int32ArrayType.tp_dealloc = (destructor)_int32ArrayDealloc;
+    Int32ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+    Int32ArrayType.tp_doc = "native int32 results, exported through the buffer protocol";
+    Int32ArrayType.tp_as_buffer = &_int32ArrayBufferProcs;
+    Int32ArrayType.tp_as_sequence = &_int32ArraySequenceMethods;
+    Int32ArrayType.tp_getset = _int32ArrayGetSet;
+    Int32ArrayType.tp_methods = _int32ArrayMethods;
+
+    GameFoundationType.tp_basicsize = sizeof(GameFoundationObject);
+    GameFoundationType.tp_dealloc = (destructor)_gameFoundationDealloc;
+    GameFoundationType.tp_flags = Py_TPFLAGS_DEFAULT;
+    GameFoundationType.tp_doc = "GameFoundation(hand_size=7, max_suit=6)";
+    GameFoundationType.tp_init = (initproc)_gameFoundationInit;
+    GameFoundationType.tp_new = PyType_GenericNew;
+    GameFoundationType.tp_getset = _gameFoundationGetSet;
+    GameFoundationType.tp_methods = _gameFoundationMethods;
+
+    GameType.tp_basicsize = sizeof(GameObject);
+    GameType.tp_dealloc = (destructor)_gameDealloc;
+    GameType.tp_flags = Py_TPFLAGS_DEFAULT;
+    GameType.tp_doc = "Game(foundation, max_hand, min_hand) with hands as tile indices";
+    GameType.tp_new = _gameNew;
+    GameType.tp_getset = _gameGetSet;
+    GameType.tp_methods = _gameMethods;
+
+    if (PyType_Ready(&Int32ArrayType) < 0 || PyType_Ready(&GameFoundationType) < 0 || PyType_Ready(&GameType) < 0) {
+        return NULL;
+    }
+    PyObject* module = PyModule_Create(&_moduleDefinition);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&Int32ArrayType);
+    PyModule_AddObject(module, "Int32Array", (PyObject*)&Int32ArrayType);
+    Py_INCREF(&GameFoundationType);
+    PyModule_AddObject(module, "GameFoundation", (PyObject*)&GameFoundationType);
+    Py_INCREF(&GameType);
+    PyModule_AddObject(module, "Game", (PyObject*)&GameType);
+    return module;
+}
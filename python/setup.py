@@ -0,0 +1,33 @@
+#
+#  setup.py
+#
+#  Copyright © 2019 Kevin Broom. All rights reserved.
+#
+#  builds the dominoes extension from the solver sources: python3 setup.py build_ext --inplace
+
+import glob
+import os
+
+from setuptools import Extension, setup
+
+source_root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'dominoes_minimax_monte_carlo')
+source_directories = sorted(os.path.join(source_root, name) for name in os.listdir(source_root) if os.path.isdir(os.path.join(source_root, name)))
+solver_sources = sorted(path for directory in source_directories for path in glob.glob(os.path.join(directory, '*.cpp')))
+
+# the Xcode build leans on headers libc++ pulls in transitively
+implicit_headers = ['cassert', 'chrono', 'algorithm', 'string', 'cmath']
+
+setup(
+    name='dominoes',
+    version='1.0',
+    ext_modules=[
+        Extension(
+            'dominoes',
+            sources=['dominoes_module.cpp'] + [os.path.relpath(path) for path in solver_sources],
+            include_dirs=source_directories,
+            language='c++',
+            extra_compile_args=['-std=gnu++14', '-O2'] + [flag for header in implicit_headers for flag in ('-include', header)],
+            extra_link_args=['-pthread'],
+        ),
+    ],
+)
@@ -0,0 +1,33 @@
+#
+#  test_dominoes.py
+#
+#  Copyright © 2019 Kevin Broom. All rights reserved.
+#
+#  checks the dominoes extension after python3 setup.py build_ext --inplace: python3 -m unittest test_dominoes
+
+import array
+import unittest
+
+import dominoes
+
+SEEDS = range(1, 11)
+SAMPLES = 20
+
+
+def tile_mask(tile_indices):
+    return sum(1 << tile_index for tile_index in tile_indices)
+
+
+class SelectMoveTest(unittest.TestCase):
+    def test_game_and_position_rows_agree(self):
+        # Game.select_move and select_moves on the opening position must break vote ties the same way
+        foundation = dominoes.GameFoundation()
+        for seed in SEEDS:
+            game = dominoes.Game.for_seed(foundation, seed)
+            position = array.array('q', [tile_mask(game.max_hand), tile_mask(game.min_hand), 0, -1, -1, 0])
+            row_move = tuple(memoryview(dominoes.select_moves(foundation, position, samples=SAMPLES, seed=seed)).tolist()[0])
+            self.assertEqual(game.select_move(samples=SAMPLES, seed=seed), row_move, 'seed %d' % seed)
+
+
+if __name__ == '__main__':
+    unittest.main()